@@ -0,0 +1,369 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+#include "cJSON.h"
+
+/* ܲ. : gcc -O2 cJSON.c bench.c -o bench -lm
+   -DCJSON_ENABLE_COUNTERSʱͬʱcJSON_GetCountersļ.
+   : ./bench [file.json|file.ndjson ...]
+   ʱʹɵ, ״ճõļļ: canada.json(),
+   twitter.json(ַתΪĶ), citm_catalog.json(ּĴ),
+   һеNDJSONһǶ. ļʱЩļ(չΪ.ndjsonİн) */
+
+static double seconds(clock_t start)
+{
+    return (double)(clock()-start)/CLOCKS_PER_SEC;
+}
+
+/* ͳƷķ亯: ÿǰ¼С, õڴֵ */
+static size_t mem_allocs,mem_cur,mem_peak;
+#define MEM_HEAD 16
+
+static void *count_malloc(size_t sz)
+{
+    char *p=(char*)malloc(sz+MEM_HEAD);
+    if (!p) return 0;
+    *(size_t*)p=sz;
+    mem_allocs++;
+    mem_cur+=sz;
+    if (mem_cur>mem_peak) mem_peak=mem_cur;
+    return p+MEM_HEAD;
+}
+
+static void count_free(void *ptr)
+{
+    char *p=(char*)ptr-MEM_HEAD;
+    if (!ptr) return;
+    mem_cur-=*(size_t*)p;
+    free(p);
+}
+
+/* cJSON_AddItemToArray׷Ԫع. ÿ׷ӶO(1),ԺʱӦn */
+void bench_array_build(void)
+{
+    cJSON *root;
+    clock_t start;
+    double t;
+    int n,i;
+
+    printf("array build (cJSON_AddItemToArray):\n");
+    for (n=25000; n<=400000; n*=2) {
+        start=clock();
+        root=cJSON_CreateArray();
+        for (i=0; i<n; i++) cJSON_AddItemToArray(root,cJSON_CreateNumber(i));
+        t=seconds(start);
+        cJSON_Delete(root);
+        printf("  %7d items: %8.3f ms  %6.1f ns/item\n",n,t*1e3,t*1e9/n);
+    }
+}
+
+/* ±: for (i=0;i<cJSON_GetArraySize(a);i++) cJSON_GetArrayItem(a,i) */
+void bench_array_index(void)
+{
+    cJSON *root;
+    clock_t start;
+    double t;
+    int n,i;
+    long sum;
+
+    printf("array index loop (cJSON_GetArraySize/cJSON_GetArrayItem):\n");
+    for (n=25000; n<=400000; n*=2) {
+        root=cJSON_CreateArray();
+        for (i=0; i<n; i++) cJSON_AddItemToArray(root,cJSON_CreateNumber(i));
+        start=clock();
+        for (sum=0,i=0; i<cJSON_GetArraySize(root); i++) sum+=cJSON_GetArrayItem(root,i)->valueint;
+        t=seconds(start);
+        cJSON_Delete(root);
+        printf("  %7d items: %8.3f ms  %6.1f ns/item\n",n,t*1e3,t*1e9/n);
+    }
+}
+
+/* õĿı͹̶ӵ, ÿе϶һ */
+typedef struct {
+    char *buf;
+    size_t len,cap;
+} text;
+
+static unsigned rnd_state=12345;
+static unsigned rnd(void)
+{
+    rnd_state=rnd_state*1103515245u+12345u;
+    return (rnd_state>>8)&0xFFFFFF;
+}
+
+static void put(text *t,const char *fmt,...)
+{
+    va_list ap;
+    int n;
+    for (;;) {
+        va_start(ap,fmt);
+        n=vsnprintf(t->buf+t->len,t->cap-t->len,fmt,ap);
+        va_end(ap);
+        if (n>=0 && t->len+n<t->cap) break;
+        t->cap=t->cap?t->cap*2:65536;
+        t->buf=(char*)realloc(t->buf,t->cap);
+    }
+    t->len+=n;
+}
+
+/* canada.json: һεFeatureCollection, ȫ[,γ] */
+static void gen_canada(text *t)
+{
+    int r,i;
+    put(t,"{\"type\":\"FeatureCollection\",\"features\":[{\"type\":\"Feature\",\"properties\":{\"name\":\"Canada\"},"
+          "\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[");
+    for (r=0; r<480; r++) {
+        put(t,"%s[",r?",":"");
+        for (i=0; i<120; i++)
+            put(t,"%s[%.15g,%.15g]",i?",":"",-141.0+rnd()/16777216.0*88.0,41.6+rnd()/16777216.0*41.0);
+        put(t,"]");
+    }
+    put(t,"]}}]}");
+}
+
+/* twitter.json: Ķ, ַΪ, \uתUTF-8, Ƕ׵user/entities, id */
+static void gen_twitter(text *t)
+{
+    static const char *words[]={"cJSON","\\u3053\\u3093\\u306b\\u3061\\u306f","tweet","\xe4\xbd\xa0\xe5\xa5\xbd",
+                                "http:\\/\\/t.co\\/abc","RT","@user","\\\"quoted\\\"","#tag","\\n"};
+    int i,j;
+    put(t,"{\"statuses\":[");
+    for (i=0; i<1000; i++) {
+        put(t,"%s{\"created_at\":\"Sun Aug 31 00:29:15 +0000 2014\",\"id\":%u%06u,\"id_str\":\"%u%06u\",\"text\":\"",
+            i?",":"",505874924u,(unsigned)i,505874924u,(unsigned)i);
+        for (j=0; j<12; j++) put(t,"%s%s",j?" ":"",words[rnd()%10]);
+        put(t,"\",\"source\":\"<a href=\\\"https:\\/\\/mobile.twitter.com\\\" rel=\\\"nofollow\\\">Mobile Web<\\/a>\","
+              "\"truncated\":false,\"in_reply_to_status_id\":null,\"user\":{\"id\":%u,\"name\":\"user %d\","
+              "\"screen_name\":\"u%d\",\"location\":\"\",\"description\":\"",rnd(),i,i);
+        for (j=0; j<8; j++) put(t,"%s%s",j?" ":"",words[rnd()%10]);
+        put(t,"\",\"followers_count\":%u,\"friends_count\":%u,\"verified\":%s,\"lang\":\"ja\"},"
+              "\"entities\":{\"hashtags\":[],\"urls\":[{\"url\":\"http:\\/\\/t.co\\/%u\",\"indices\":[%u,%u]}],"
+              "\"user_mentions\":[]},\"retweet_count\":%u,\"favorited\":false,\"retweeted\":false}",
+            rnd()%5000,rnd()%500,(rnd()&1)?"true":"false",rnd(),rnd()%100,rnd()%100+100,rnd()%100);
+    }
+    put(t,"]}");
+}
+
+/* citm_catalog.json: ΪĴ(Ʊ), , ۸ĳ */
+static void gen_citm(text *t)
+{
+    int i,j;
+    put(t,"{\"areaNames\":{");
+    for (i=0; i<2000; i++) put(t,"%s\"%u\":\"area %d\"",i?",":"",205705993u+i,i);
+    put(t,"},\"events\":{");
+    for (i=0; i<2000; i++) {
+        put(t,"%s\"%u\":{\"description\":null,\"id\":%u,\"logo\":null,\"name\":\"event %d\",\"subTopicIds\":[",
+            i?",":"",138586341u+i,138586341u+i,i);
+        for (j=0; j<6; j++) put(t,"%s%u",j?",":"",337184u+rnd()%1000);
+        put(t,"],\"subjectCode\":null,\"subtitle\":null,\"topicIds\":[%u,%u]}",324846099u,107888604u);
+    }
+    put(t,"},\"performances\":[");
+    for (i=0; i<4000; i++) {
+        put(t,"%s{\"eventId\":%u,\"id\":%u,\"logo\":null,\"name\":null,\"prices\":[",i?",":"",138586341u+i%2000,339887544u+i);
+        for (j=0; j<4; j++) put(t,"%s{\"amount\":%u,\"audienceSubCategoryId\":337100890,\"seatCategoryId\":%u}",
+                                j?",":"",rnd()%100000,338937295u+j);
+        put(t,"],\"start\":%u000,\"venueCode\":\"PLEYEL_PLEYEL\"}",1372363200u+i);
+    }
+    put(t,"]}");
+}
+
+/* NDJSON: ÿһС¼ */
+static void gen_ndjson(text *t)
+{
+    int i;
+    for (i=0; i<100000; i++)
+        put(t,"{\"id\":%d,\"name\":\"user %d\",\"score\":%.6f,\"tags\":[\"a\",\"b\"],\"active\":%s}\n",
+            i,i,rnd()/16777216.0*1000,(i&1)?"true":"false");
+}
+
+/* Ƕ: [[[...[1]...]]] */
+static void gen_deep(text *t)
+{
+    int i,depth=100000;
+    for (i=0; i<depth; i++) put(t,"[");
+    put(t,"1");
+    for (i=0; i<depth; i++) put(t,"]");
+}
+
+/* һ: ͨĵΪһ, NDJSONÿһ */
+typedef struct {
+    const char *name;
+    char *text;
+    size_t len;
+    int ndjson;
+} corpus;
+
+/* Ƕײ, ǶҲܽ */
+static cJSON **parse_corpus(const corpus *c,int *n)
+{
+    cJSON_Context ctx;
+    cJSON **trees;
+    const char *p=c->text,*end=c->text+c->len,*nl;
+    int cap=1,k=0;
+    cJSON_InitContext(&ctx);
+    ctx.max_depth=0;
+    trees=(cJSON**)malloc(sizeof(cJSON*));
+    if (!c->ndjson) {
+        trees[0]=cJSON_ParseWithLengthCtx(&ctx,c->text,c->len,0);
+        *n=trees[0]?1:0;
+        return trees;
+    }
+    for (; p<end; p=nl+1) {
+        if (!(nl=(const char*)memchr(p,'\n',end-p))) nl=end;
+        if (nl==p) continue;
+        if (k==cap) trees=(cJSON**)realloc(trees,(cap*=2)*sizeof(cJSON*));
+        if (!(trees[k]=cJSON_ParseWithLengthCtx(&ctx,p,nl-p,0))) break;
+        k++;
+    }
+    *n=k;
+    return trees;
+}
+
+static void delete_trees(cJSON **trees,int n)
+{
+    int i;
+    for (i=0; i<n; i++) cJSON_Delete(trees[i]);
+    free(trees);
+}
+
+#define BENCH_MIN 0.2	//ÿظô, ȡƽ
+
+static void print_counters(void)
+{
+    cJSON_Counters k;
+    cJSON_GetCounters(&k);
+#ifdef CJSON_ENABLE_COUNTERS
+    printf("    counters: %llu nodes, %llu bytes copied, %llu ensure regrowths, %llu lookups / %llu steps\n",
+           k.nodes,k.bytes_copied,k.ensure_grows,k.lookups,k.lookup_steps);
+#endif
+}
+
+/* һ: //ʽ/ѹMB/s, һνķڴֵ */
+static void bench_corpus(const corpus *c)
+{
+    cJSON **trees;
+    char *copy,*out;
+    clock_t start;
+    double t,mb=c->len/1048576.0;
+    size_t allocs,base,printed;
+    int n,i,reps;
+
+    printf("%s (%.2f MB):\n",c->name,mb);
+
+    cJSON_ResetCounters();
+    allocs=mem_allocs,base=mem_cur,mem_peak=mem_cur;
+    trees=parse_corpus(c,&n);
+    if (!n) {
+        printf("  parse failed\n");
+        free(trees);
+        return;
+    }
+    printf("  parse: %zu allocations, peak %.2f MB (%.1fx the text)\n",
+           mem_allocs-allocs,(mem_peak-base)/1048576.0,(double)(mem_peak-base)/c->len);
+    print_counters();
+    delete_trees(trees,n);
+
+    for (reps=0,start=clock(); !reps || seconds(start)<BENCH_MIN; reps++) delete_trees(parse_corpus(c,&n),n);
+    t=seconds(start)/reps;
+    printf("  parse          %8.1f MB/s  %8.3f ms\n",mb/t,t*1e3);
+
+    trees=parse_corpus(c,&n);
+    cJSON_ResetCounters();
+    for (printed=0,i=0; i<n; i++) {
+        out=cJSON_PrintUnformatted(trees[i]);
+        printed+=strlen(out);
+        count_free(out);
+    }
+    print_counters();
+    for (reps=0,start=clock(); !reps || seconds(start)<BENCH_MIN; reps++)
+        for (i=0; i<n; i++) count_free(cJSON_PrintUnformatted(trees[i]));
+    t=seconds(start)/reps;
+    printf("  print          %8.1f MB/s  %8.3f ms\n",printed/1048576.0/t,t*1e3);
+    for (printed=0,i=0; i<n; i++) {
+        out=cJSON_Print(trees[i]);
+        printed+=strlen(out);
+        count_free(out);
+    }
+    for (reps=0,start=clock(); !reps || seconds(start)<BENCH_MIN; reps++)
+        for (i=0; i<n; i++) count_free(cJSON_Print(trees[i]));
+    t=seconds(start)/reps;
+    printf("  print formatted%8.1f MB/s  %8.3f ms\n",printed/1048576.0/t,t*1e3);
+    delete_trees(trees,n);
+
+    /* cJSON_Minifyԭص: ÿȸһ, Ƶʱ䲻 */
+    copy=(char*)malloc(c->len+1);
+    for (t=0,reps=0; !reps || t<BENCH_MIN; reps++) {
+        memcpy(copy,c->text,c->len);
+        copy[c->len]=0;
+        start=clock();
+        cJSON_Minify(copy);
+        t+=seconds(start);
+    }
+    free(copy);
+    t/=reps;
+    printf("  minify         %8.1f MB/s  %8.3f ms\n",mb/t,t*1e3);
+}
+
+static int load_file(corpus *c,const char *path)
+{
+    FILE *f=fopen(path,"rb");
+    long len;
+    const char *ext=strrchr(path,'.');
+    if (!f) return 0;
+    fseek(f,0,SEEK_END);
+    len=ftell(f);
+    fseek(f,0,SEEK_SET);
+    c->text=(char*)malloc(len+1);
+    c->len=fread(c->text,1,len,f);
+    c->text[c->len]=0;
+    fclose(f);
+    c->name=path;
+    c->ndjson=ext && !strcmp(ext,".ndjson");
+    return 1;
+}
+
+int main (int argc, const char * argv[])
+{
+    static const struct {const char *name; void (*gen)(text *t); int ndjson;} gens[]={
+        {"canada (generated)",gen_canada,0},
+        {"twitter (generated)",gen_twitter,0},
+        {"citm_catalog (generated)",gen_citm,0},
+        {"ndjson (generated, 100000 lines)",gen_ndjson,1},
+        {"deep nesting (generated, 100000 arrays)",gen_deep,0}
+    };
+    cJSON_Hooks hooks;
+    corpus c;
+    text t;
+    int i;
+
+    hooks.malloc_fn=count_malloc;
+    hooks.free_fn=count_free;
+    cJSON_InitHooks(&hooks);
+
+    if (argc>1) {
+        for (i=1; i<argc; i++) {
+            if (!load_file(&c,argv[i])) {
+                printf("%s: can't read\n",argv[i]);
+                continue;
+            }
+            bench_corpus(&c);
+            free(c.text);
+        }
+        return 0;
+    }
+    for (i=0; i<(int)(sizeof(gens)/sizeof(gens[0])); i++) {
+        memset(&t,0,sizeof(t));
+        gens[i].gen(&t);
+        c.name=gens[i].name;
+        c.text=t.buf;
+        c.len=t.len;
+        c.ndjson=gens[i].ndjson;
+        bench_corpus(&c);
+        free(t.buf);
+    }
+    bench_array_build();
+    bench_array_index();
+    return 0;
+}
@@ -32,11 +32,257 @@
 #include <ctype.h>
 #include "cJSON.h"
 
-static const char *ep; //error pointerڱJSONַĳλ
+#ifndef CJSON_NESTING_LIMIT
+#define CJSON_NESTING_LIMIT 1000	//ĬϵǶײ. Ľݹ,ջռ; ݹcJSON_ParseSaxֹľջռ
+#endif
+#ifndef CJSON_INDEX_THRESHOLD
+#define CJSON_INDEX_THRESHOLD 16	//ʱôڵ,Ϊö
+#endif
+
+#define CJSON_OPT_INSITU (1<<30)	//ڲѡ: ַԭؽ뻺(cJSON_ParseInSitu)
+
+/* ڵʹõֲ߳̾洢. ֧ʱ(CJSON_NO_POOL)ʹýڵ */
+#ifndef CJSON_NO_POOL
+#if defined(_MSC_VER)
+#define CJSON_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__>=201112L
+#define CJSON_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define CJSON_THREAD_LOCAL __thread
+#else
+#define CJSON_NO_POOL
+#endif
+#endif
+#ifndef CJSON_POOL_LIMIT
+#define CJSON_POOL_LIMIT 1024	//ÿ̵߳ÿֿп໺ô
+#endif
+
+/* ȵ(cJSON_GetCounters). ֻڶCJSON_ENABLE_COUNTERSʱ, COUNTʲôҲ */
+#ifdef CJSON_ENABLE_COUNTERS
+static cJSON_Counters counters;
+#if defined(__GNUC__)
+#define COUNT(field,n) __atomic_fetch_add(&counters.field,(unsigned long long)(n),__ATOMIC_RELAXED)
+#define COUNT_READ(field) __atomic_load_n(&counters.field,__ATOMIC_RELAXED)
+#define COUNT_CLEAR(field) __atomic_store_n(&counters.field,0,__ATOMIC_RELAXED)
+#else
+#define COUNT(field,n) (counters.field+=(unsigned long long)(n))
+#define COUNT_READ(field) (counters.field)
+#define COUNT_CLEAR(field) (counters.field=0)
+#endif
+#else
+#define COUNT(field,n) ((void)0)
+#endif
+
+/* ıɨSIMDʵ. ʱĿƽ̨ѡAVX2/SSE2/NEON,CJSON_NO_SIMDֻʹֽڵʵ.
+   ÿƽֻ̨ṩĸຯ,һSIMD_WIDTHֽڵĶ(iֽڶӦĵi*SIMD_BITSλ):
+     string_mask: '"','\\'Ϳַ(<0x20,'\0')
+     token_mask:  ǿհַ(>0x20)'\0'
+     structure_mask: '"','[',']','{','}''\0'
+     minify_mask: '"','/','\0'Ϊֵ, հַ' ','\t','\r','\n'д*ws
+   Ŀ鲻Խڴҳ,Լʹ'\0'ֽ֮Ҳǰȫ(AddressSanitizer˽һ,˶Щرռ) */
+#if !defined(CJSON_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define CJSON_SIMD_AVX2
+#elif !defined(CJSON_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP>=2))
+#include <emmintrin.h>
+#define CJSON_SIMD_SSE2
+#elif !defined(CJSON_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define CJSON_SIMD_NEON
+#endif
+
+#if defined(CJSON_SIMD_AVX2) || defined(CJSON_SIMD_SSE2) || defined(CJSON_SIMD_NEON)
+#define CJSON_SIMD
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+static int ctz64(unsigned long long x)
+{
+    unsigned long i;
+    if (_BitScanForward(&i,(unsigned long)x)) return (int)i;
+    _BitScanForward(&i,(unsigned long)(x>>32));
+    return (int)i+32;
+}
+#define CJSON_NO_SANITIZE_ADDRESS
+#else
+static int ctz64(unsigned long long x) {return __builtin_ctzll(x);}
+#define CJSON_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#endif
+#endif
+
+#if defined(CJSON_SIMD_AVX2)
+#define SIMD_WIDTH 32
+#define SIMD_BITS 1
+#define SIMD_BYTE_MASK 0xFFFFFFFFULL
+#define SIMD_LE(x,c) _mm256_cmpeq_epi8(_mm256_max_epu8(x,_mm256_set1_epi8(c)),_mm256_set1_epi8(c))	//޷x<=c
+#define SIMD_EQ(x,c) _mm256_cmpeq_epi8(x,_mm256_set1_epi8(c))
+#define SIMD_OR(a,b) _mm256_or_si256(a,b)
+#define SIMD_MASK(m) ((unsigned long long)(unsigned)_mm256_movemask_epi8(m))
+typedef __m256i simd_vec;
+CJSON_NO_SANITIZE_ADDRESS static simd_vec simd_load(const char *blk) {return _mm256_load_si256((const __m256i*)blk);}
+#elif defined(CJSON_SIMD_SSE2)
+#define SIMD_WIDTH 16
+#define SIMD_BITS 1
+#define SIMD_BYTE_MASK 0xFFFFULL
+#define SIMD_LE(x,c) _mm_cmpeq_epi8(_mm_max_epu8(x,_mm_set1_epi8(c)),_mm_set1_epi8(c))	//޷x<=c
+#define SIMD_EQ(x,c) _mm_cmpeq_epi8(x,_mm_set1_epi8(c))
+#define SIMD_OR(a,b) _mm_or_si128(a,b)
+#define SIMD_MASK(m) ((unsigned long long)(unsigned)_mm_movemask_epi8(m))
+typedef __m128i simd_vec;
+CJSON_NO_SANITIZE_ADDRESS static simd_vec simd_load(const char *blk) {return _mm_load_si128((const __m128i*)blk);}
+#elif defined(CJSON_SIMD_NEON)
+#define SIMD_WIDTH 16
+#define SIMD_BITS 4		//NEONûmovemask: ÿֽѹ4λ,ֻλ
+#define SIMD_BYTE_MASK 0x1111111111111111ULL
+#define SIMD_LE(x,c) vcleq_u8(x,vdupq_n_u8(c))
+#define SIMD_EQ(x,c) vceqq_u8(x,vdupq_n_u8(c))
+#define SIMD_OR(a,b) vorrq_u8(a,b)
+#define SIMD_MASK(m) (vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m),4)),0)&SIMD_BYTE_MASK)
+typedef uint8x16_t simd_vec;
+CJSON_NO_SANITIZE_ADDRESS static simd_vec simd_load(const char *blk) {return vld1q_u8((const unsigned char*)blk);}
+#endif
+
+#ifdef CJSON_SIMD
+static unsigned long long string_mask(const char *blk)
+{
+    simd_vec x=simd_load(blk);
+    return SIMD_MASK(SIMD_OR(SIMD_OR(SIMD_EQ(x,'\"'),SIMD_EQ(x,'\\')),SIMD_LE(x,0x1F)));
+}
+static unsigned long long token_mask(const char *blk)
+{
+    simd_vec x=simd_load(blk);
+    return (~SIMD_MASK(SIMD_LE(x,0x20))&SIMD_BYTE_MASK) | SIMD_MASK(SIMD_EQ(x,0));
+}
+static unsigned long long structure_mask(const char *blk)
+{
+    simd_vec x=simd_load(blk);
+    return SIMD_MASK(SIMD_OR(SIMD_OR(SIMD_OR(SIMD_EQ(x,'\"'),SIMD_EQ(x,0)),SIMD_OR(SIMD_EQ(x,'['),SIMD_EQ(x,']'))),SIMD_OR(SIMD_EQ(x,'{'),SIMD_EQ(x,'}'))));
+}
+static unsigned long long minify_mask(const char *blk,unsigned long long *ws)
+{
+    simd_vec x=simd_load(blk);
+    *ws=SIMD_MASK(SIMD_OR(SIMD_OR(SIMD_EQ(x,' '),SIMD_EQ(x,'\t')),SIMD_OR(SIMD_EQ(x,'\r'),SIMD_EQ(x,'\n'))));
+    return SIMD_MASK(SIMD_OR(SIMD_OR(SIMD_EQ(x,'\"'),SIMD_EQ(x,'/')),SIMD_EQ(x,0)));
+}
+
+//sڵĶʼַ,Լs֮ǰֽڶӦλҪ
+#define SIMD_BLOCK(s) ((const char*)((size_t)(s)&~(size_t)(SIMD_WIDTH-1)))
+#define SIMD_FROM(s) (SIMD_BYTE_MASK & ~0ULL<<(((size_t)(s)&(SIMD_WIDTH-1))*SIMD_BITS))
+
+//شsʼһ'"','\\'ַ(<0x20,'\0')λ
+static const char *scan_string(const char *s)
+{
+    const char *blk=SIMD_BLOCK(s);
+    unsigned long long mask=string_mask(blk)&SIMD_FROM(s);
+    while (!mask) blk+=SIMD_WIDTH,mask=string_mask(blk);
+    return blk+ctz64(mask)/SIMD_BITS;
+}
+/* ʹõб߽汾: ֻ[s,end),Ҳʱend. 鲻Խҳ߽,
+   ԰end֮ǰֽڵĿǿԶȡ; endֽڶӦλʹ */
+static const char *scan_string_n(const char *s,const char *end)
+{
+    const char *blk=SIMD_BLOCK(s);
+    unsigned long long mask;
+    if (s>=end) return end;
+    mask=string_mask(blk)&SIMD_FROM(s);
+    while (!mask) {
+        blk+=SIMD_WIDTH;
+        if (blk>=end) return end;
+        mask=string_mask(blk);
+    }
+    s=blk+ctz64(mask)/SIMD_BITS;
+    return s<end?s:end;
+}
+//[s,end)еһǿհַ(>0x20)'\0'λ
+static const char *scan_token(const char *s,const char *end)
+{
+    const char *blk=SIMD_BLOCK(s);
+    unsigned long long mask;
+    if (s>=end) return end;
+    mask=token_mask(blk)&SIMD_FROM(s);
+    while (!mask) {
+        blk+=SIMD_WIDTH;
+        if (blk>=end) return end;
+        mask=token_mask(blk);
+    }
+    s=blk+ctz64(mask)/SIMD_BITS;
+    return s<end?s:end;
+}
+//[s,end)еһ'"','[',']','{','}''\0'λ(ӳٽĽṹɨ)
+static const char *scan_structure(const char *s,const char *end)
+{
+    const char *blk=SIMD_BLOCK(s);
+    unsigned long long mask;
+    if (s>=end) return end;
+    mask=structure_mask(blk)&SIMD_FROM(s);
+    while (!mask) {
+        blk+=SIMD_WIDTH;
+        if (blk>=end) return end;
+        mask=structure_mask(blk);
+    }
+    s=blk+ctz64(mask)/SIMD_BITS;
+    return s<end?s:end;
+}
+#else
+static const char *scan_string(const char *s)
+{
+    const unsigned char *p=(const unsigned char*)s;
+    while (*p>=0x20 && *p!='\"' && *p!='\\') p++;
+    return (const char*)p;
+}
+static const char *scan_string_n(const char *s,const char *end)
+{
+    const unsigned char *p=(const unsigned char*)s;
+    while (p<(const unsigned char*)end && *p>=0x20 && *p!='\"' && *p!='\\') p++;
+    return (const char*)p;
+}
+static const char *scan_token(const char *s,const char *end)
+{
+    const unsigned char *p=(const unsigned char*)s;
+    while (p<(const unsigned char*)end && *p && *p<=0x20) p++;
+    return (const char*)p;
+}
+static const char *scan_structure(const char *s,const char *end)
+{
+    while (s<end && *s && *s!='\"' && *s!='[' && *s!=']' && *s!='{' && *s!='}') s++;
+    return s;
+}
+#endif
+
+/* ɽӿ(cJSON_Parse,cJSON_Print,cJSON_InitHooks...)ʹõĬcontext.
+   errorֶμԭep(error pointer),ڱJSONַĳλ */
+static cJSON_Context default_ctx = { malloc, free, 0, 0, CJSON_NESTING_LIMIT, 0, 0 };
+
+#define cJSON_malloc(sz) (default_ctx.malloc_fn(sz))
+#define cJSON_free(ptr) (default_ctx.free_fn(ptr))
 
 const char *cJSON_GetErrorPtr(void)
 {
-    return ep;
+    return default_ctx.error;
+}
+
+void cJSON_GetCounters(cJSON_Counters *out)
+{
+    if (!out) return;
+#ifdef CJSON_ENABLE_COUNTERS
+    out->nodes=COUNT_READ(nodes);
+    out->bytes_copied=COUNT_READ(bytes_copied);
+    out->ensure_grows=COUNT_READ(ensure_grows);
+    out->lookups=COUNT_READ(lookups);
+    out->lookup_steps=COUNT_READ(lookup_steps);
+#else
+    memset(out,0,sizeof(cJSON_Counters));
+#endif
+}
+
+void cJSON_ResetCounters(void)
+{
+#ifdef CJSON_ENABLE_COUNTERS
+    COUNT_CLEAR(nodes);
+    COUNT_CLEAR(bytes_copied);
+    COUNT_CLEAR(ensure_grows);
+    COUNT_CLEAR(lookups);
+    COUNT_CLEAR(lookup_steps);
+#endif
 }
 
 static int cJSON_strcasecmp(const char *s1,const char *s2)
@@ -47,94 +293,402 @@ static int cJSON_strcasecmp(const char *s1,const char *s2)
     return tolower(*(const unsigned char *)s1) - tolower(*(const unsigned char *)s2);
 }
 
-static void *(*cJSON_malloc)(size_t sz) = malloc;
-static void (*cJSON_free)(void *ptr) = free;
-
-//ַ,ظָ
-static char* cJSON_strdup(const char* str)
+//ַ,ظָ. ռctxķ亯
+static char* ctx_strdup(cJSON_Context *ctx,const char* str)
 {
     size_t len;
     char* copy;
 
     len = strlen(str) + 1;
-    if (!(copy = (char*)cJSON_malloc(len))) return 0;
+    if (!(copy = (char*)ctx->malloc_fn(len))) return 0;
+    memcpy(copy,str,len);
+    COUNT(bytes_copied,len);
+    return copy;
+}
+
+static char* cJSON_strdup(const char* str)
+{
+    return ctx_strdup(&default_ctx,str);
+}
+
+/* ڵ: ÿ߳һ,cJSON_DeleteͷŵĽڵͶַ,cJSON_New_Item/pool_strdupȴȡ.
+   Ŀ鶼ĬϷ亯(cJSON_InitHooks)ͨ,Խĸ̵߳ĳءֱͷŶ.
+   [0]Žڵ, [1..POOL_CLASSES]16,32,64ֽڵַ. пĵһָһп.
+   ַֻڶCJSON_POOL_STRINGSʱʹ: ɴԼfree(valuestring)ٻstrdupַ
+   cJSON_ValueIsPooled, ذstrlenѡͲǿʵС */
+#define POOL_CLASSES 3
+#define POOL_CLASS_SIZE(k) ((size_t)8<<(k))
+#ifndef CJSON_NO_POOL
+typedef struct {
+    void *head[POOL_CLASSES+1];
+    int count[POOL_CLASSES+1];
+} node_pool;
+static CJSON_THREAD_LOCAL node_pool pool;
+
+static void *pool_get(int k)
+{
+    void *p=pool.head[k];
+    if (p) pool.head[k]=*(void**)p,pool.count[k]--;
+    return p;
+}
+//Żصkֿ, ʱ0
+static int pool_put(void *p,int k)
+{
+    if (pool.count[k]>=CJSON_POOL_LIMIT) return 0;
+    *(void**)p=pool.head[k];
+    pool.head[k]=p;
+    pool.count[k]++;
+    return 1;
+}
+#else
+#define pool_get(k) ((void*)0)
+#define pool_put(p,k) 0
+#endif
+
+//ѵ̵߳ĳлĿ齻亯
+void cJSON_PoolFlush(void)
+{
+    void *p;
+    int k;
+    for (k=0; k<=POOL_CLASSES; k++) while ((p=pool_get(k))) cJSON_free(p);
+}
+
+//Ϊlen('\0')ַʹõĿ, 0ʾ̫ûдַ,ʹó
+static int pool_class(size_t len)
+{
+#if defined(CJSON_POOL_STRINGS) && !defined(CJSON_NO_POOL)
+    int k;
+    for (k=1; k<=POOL_CLASSES; k++) if (len<=POOL_CLASS_SIZE(k)) return k;
+#endif
+    return 0;
+}
+
+/* Ҫŵitemеַ. ̵ַĴС(ȡеĿ),item->typeflag
+   (cJSON_StringIsPooledcJSON_ValueIsPooled), cJSON_Deleteݴ˰Żس */
+static char *pool_strdup(const char *str,cJSON *item,int flag)
+{
+    size_t len=strlen(str)+1;
+    int k=pool_class(len);
+    char *copy;
+
+    item->type&=~flag;
+    if (!k) return cJSON_strdup(str);
+    if (!(copy=(char*)pool_get(k)) && !(copy=(char*)cJSON_malloc(POOL_CLASS_SIZE(k)))) return 0;
     memcpy(copy,str,len);
+    COUNT(bytes_copied,len);
+    item->type|=flag;
     return copy;
 }
 
+//ͷַ. pooled0ʾpool_strdup. ַܱԭظĶ̹,ĴССڰڵĳ
+static void pool_free_string(cJSON_Context *ctx,char *str,int pooled)
+{
+    if (!pooled || !pool_put(str,pool_class(strlen(str)+1))) ctx->free_fn(str);
+}
+
 void cJSON_InitHooks(cJSON_Hooks* hooks)
 {
+    cJSON_PoolFlush();	//еĿԭķ亯
     if (!hooks) { /* Reset hooks */
-        cJSON_malloc = malloc;
-        cJSON_free = free;
+        default_ctx.malloc_fn = malloc;
+        default_ctx.free_fn = free;
         return;
     }
 
-    cJSON_malloc = (hooks->malloc_fn)?hooks->malloc_fn:malloc;
-    cJSON_free	 = (hooks->free_fn)?hooks->free_fn:free;
+    default_ctx.malloc_fn = (hooks->malloc_fn)?hooks->malloc_fn:malloc;
+    default_ctx.free_fn	 = (hooks->free_fn)?hooks->free_fn:free;
+}
+
+void cJSON_InitContext(cJSON_Context *ctx)
+{
+    if (!ctx) return;
+    ctx->malloc_fn=default_ctx.malloc_fn;
+    ctx->free_fn=default_ctx.free_fn;
+    ctx->arena=0;
+    ctx->error=0;
+    ctx->max_depth=CJSON_NESTING_LIMIT;
+    ctx->options=0;
+    ctx->keys=0;
+}
+
+/* arenaɵȳchunkɵ,ӵǰchunkĿд˳гڴ(bump pointer).
+   chunkС1/4󵥶һchunk,ʱͷ,chunk´ʹ */
+typedef struct cJSON_ArenaChunk {
+    struct cJSON_ArenaChunk *next;
+    size_t size;	//dataĴС
+    size_t used;	//dataʹõֽ
+} cJSON_ArenaChunk;
+
+struct cJSON_Arena {
+    cJSON_ArenaChunk *head;		//ʹõchunk,һchunkǵǰchunk
+    cJSON_ArenaChunk *spare;	//ú,ȴõchunk
+    cJSON_ArenaChunk *large;	//Ĵ
+    size_t chunk_size;
+    void *(*malloc_fn)(size_t sz);	//arenaʱķ亯,chunk
+    void (*free_fn)(void *ptr);
+};
+
+#define ARENA_ALIGN 8
+#define ARENA_ROUND(n) (((n)+ARENA_ALIGN-1)&~(size_t)(ARENA_ALIGN-1))
+#define ARENA_DATA(c) ((char*)(c)+ARENA_ROUND(sizeof(cJSON_ArenaChunk)))
+
+cJSON_Arena *cJSON_ArenaCreate(size_t chunk_size)
+{
+    cJSON_Arena *arena=(cJSON_Arena*)cJSON_malloc(sizeof(cJSON_Arena));
+    if (!arena) return 0;
+    memset(arena,0,sizeof(cJSON_Arena));
+    arena->chunk_size=chunk_size?ARENA_ROUND(chunk_size):65536;
+    arena->malloc_fn=default_ctx.malloc_fn;
+    arena->free_fn=default_ctx.free_fn;
+    return arena;
+}
+
+static void arena_free_chunks(cJSON_Arena *arena,cJSON_ArenaChunk *c)
+{
+    cJSON_ArenaChunk *next;
+    while (c) {
+        next=c->next;
+        arena->free_fn(c);
+        c=next;
+    }
+}
+
+void cJSON_ArenaReset(cJSON_Arena *arena)
+{
+    cJSON_ArenaChunk *c;
+    if (!arena) return;
+    while ((c=arena->head)) {	//ùchunkƵspare
+        arena->head=c->next;
+        c->next=arena->spare;
+        arena->spare=c;
+    }
+    arena_free_chunks(arena,arena->large);
+    arena->large=0;
+}
+
+void cJSON_ArenaDelete(cJSON_Arena *arena)
+{
+    if (!arena) return;
+    arena_free_chunks(arena,arena->head);
+    arena_free_chunks(arena,arena->spare);
+    arena_free_chunks(arena,arena->large);
+    arena->free_fn(arena);
+}
+
+/* arenaзszֽ,ARENA_ALIGN. ʧܷ0 */
+static void *arena_alloc(cJSON_Arena *arena,size_t sz)
+{
+    cJSON_ArenaChunk *c=arena->head;
+    sz=ARENA_ROUND(sz);
+    if (c && c->size-c->used>=sz) {
+        c->used+=sz;
+        return ARENA_DATA(c)+c->used-sz;
+    }
+    if (sz>arena->chunk_size/4) {	//鵥
+        c=(cJSON_ArenaChunk*)arena->malloc_fn(ARENA_ROUND(sizeof(cJSON_ArenaChunk))+sz);
+        if (!c) return 0;
+        c->size=c->used=sz;
+        c->next=arena->large;
+        arena->large=c;
+        return ARENA_DATA(c);
+    }
+    if ((c=arena->spare)) arena->spare=c->next;	//ȸ֮ǰµchunk
+    else {
+        c=(cJSON_ArenaChunk*)arena->malloc_fn(ARENA_ROUND(sizeof(cJSON_ArenaChunk))+arena->chunk_size);
+        if (!c) return 0;
+        c->size=arena->chunk_size;
+    }
+    c->used=sz;
+    c->next=arena->head;
+    arena->head=c;
+    return ARENA_DATA(c);
+}
+
+/* ctxʹõĬϵķ亯: ĽڵԡҲԷŻؽڵ */
+#define POOLED(ctx) ((ctx)->malloc_fn==default_ctx.malloc_fn && (ctx)->free_fn==default_ctx.free_fn)
+
+/* ʱʹõķ亯: ctxָarenaʱarena,ʹctxķ亯 */
+static void *parse_malloc(cJSON_Context *ctx,size_t sz)
+{
+    if (ctx->arena) return arena_alloc(ctx->arena,sz);
+    return ctx->malloc_fn(sz);
 }
 
-/* ΪcJSONṹռ䲢ʼΪ. */
+/* ΪcJSONṹռ䲢ʼΪ. ʹýڵеĽڵ */
 static cJSON *cJSON_New_Item(void)
 {
-    cJSON* node = (cJSON*)cJSON_malloc(sizeof(cJSON));
-    if (node) memset(node,0,sizeof(cJSON));
+    cJSON* node = (cJSON*)pool_get(0);
+    if (!node) node = (cJSON*)cJSON_malloc(sizeof(cJSON));
+    if (node) memset(node,0,sizeof(cJSON)),COUNT(nodes,1);
+    return node;
+}
+
+/* ʹõcJSON_New_Item */
+static cJSON *parse_New_Item(cJSON_Context *ctx)
+{
+    cJSON* node;
+    if (!ctx->arena && POOLED(ctx)) return cJSON_New_Item();
+    node = (cJSON*)parse_malloc(ctx,sizeof(cJSON));
+    if (node) memset(node,0,sizeof(cJSON)),COUNT(nodes,1);
     return node;
 }
 
-/*ݹͷcJSONڴռ
+/*ͷcJSONڴռ
   JSONıнɵcJSONṹĿռmallocķʽģ겻ʱͷŻڴй¶ 
-  cJSONǶ׽ṹ,ͷͨúʵ. */
-void cJSON_Delete(cJSON *c)
+  cJSONǶ׽ṹ,ͷͨúʵ. ռctxͷźͷ,
+  ctxʹĬϵķ亯ʱڵͳзַŻص̵߳Ľڵ(ʱͷ)
+  ʹõݹ: ڵӽڵʱ,ѵһӽڵժŵǰȴ,ֻóջռ */
+static void free_extra(cJSON *c);
+void cJSON_DeleteCtx(cJSON_Context *ctx,cJSON *c)
 {
     cJSON *next;
+    int pooled=POOLED(ctx);
     while (c) {
+        if (!(c->type&cJSON_IsReference) && c->child) {
+            next=c->child;
+            c->child=next->next;	//ӽڵc,ֵcʱժ
+            next->next=c;
+            c=next;
+            continue;
+        }
         next=c->next;
-        if (!(c->type&cJSON_IsReference) && c->child) cJSON_Delete(c->child);//ݹĽͷ
-        if (!(c->type&cJSON_IsReference) && c->valuestring) cJSON_free(c->valuestring);
-        if (!(c->type&cJSON_StringIsConst) && c->string) cJSON_free(c->string);
-        cJSON_free(c);
+        if (!(c->type&(cJSON_IsReference|cJSON_ValueIsConst)) && c->valuestring) pool_free_string(ctx,c->valuestring,c->type&cJSON_ValueIsPooled);
+        if (!(c->type&cJSON_StringIsConst) && c->string) pool_free_string(ctx,c->string,c->type&cJSON_StringIsPooled);
+        if (c->extra) free_extra(c);
+        if (!(c->type&cJSON_IsArena) && !(pooled && pool_put(c,0))) ctx->free_fn(c);	//arenaеĽڵarenaһͷ
         c=next;
     }
 }
 
+void cJSON_Delete(cJSON *c)
+{
+    cJSON_DeleteCtx(&default_ctx,c);
+}
+
+/* 10^0..10^22 ܱdoubleȷʾ */
+static const double exact_pow10[23]={
+    1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+    1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22
+};
+
+#define NUMBER_MAX_DIGITS 800	//doubleֵе767λЧ,ôλȷ
+#define NUMBER_MAX_EXP 100000	//ֵָʱȻ0,ֹͣۼ
+
+//doubleתΪlong long/int,Χʱȡֵ߽ǲδΪ
+static long long double_to_int64(double d)
+{
+    if (d>=9223372036854775807.0) return LLONG_MAX;
+    if (d<=-9223372036854775808.0) return LLONG_MIN;
+    if (d!=d) return 0;
+    return (long long)d;
+}
+static int int64_to_int(long long v)
+{
+    if (v>INT_MAX) return INT_MAX;
+    if (v<INT_MIN) return INT_MIN;
+    return (int)v;
+}
+
+/* ·޷ȷʱʹ: numend֮()д"<Ч>e<ָ>"ʽ󽻸strtod.
+   дıûС,ԲܵǰlocaleСַӰ.
+   ЧֳNUMBER_MAX_DIGITSʱض,ĩβһּ¼صĲ(ճλ) */
+static double parse_number_slow(const char *num,const char *end)
+{
+    char buf[NUMBER_MAX_DIGITS+32];
+    int len=0,exp10=0,e=0,esign=1,sticky=0,frac=0;
+    const char *p=num;
+
+    if (*p=='-') p++;				/* ɵߴ */
+    for (; p<end && *p!='e' && *p!='E'; p++) {
+        if (*p=='.') {frac=1;continue;}
+        if (len==0 && *p=='0') {if (frac) exp10--; continue;}	/* ǰ0Ч */
+        if (len<NUMBER_MAX_DIGITS) {buf[len++]=*p; if (frac) exp10--;}
+        else {if (!frac) exp10++; if (*p!='0') sticky=1;}
+    }
+    if (p<end) {
+        p++;
+        if (p<end && *p=='+') p++;
+        else if (p<end && *p=='-') esign=-1,p++;
+        for (; p<end; p++) if (e<NUMBER_MAX_EXP) e=e*10+(*p-'0');
+    }
+    if (len==0) buf[len++]='0';
+    if (sticky) buf[len++]='1',exp10--;
+    sprintf(buf+len,"e%d",exp10+esign*e);
+    return strtod(buf,0);
+}
+
 /* ıһ,. 
  :item:ҪcJSON
         num:Ҫݵַ( buf[]="12.345E6xyz") 
    ֵ: ָ򲻷ֵǸַ (buf,ָxָ)
-   ʹõļ㷽: 12.345E6 --> 12345E(-3+6)--> 12345*(10^(-3+6)) */
-static const char *parse_number(cJSON *item,const char *num)
-{
-    double n=0,sign=1,scale=0;
-    int subscale=0,signsubscale=1;
-
-    if (*num=='-') sign=-1,num++;	/* жǷΪ */
-    if (*num=='0') num++;			/* is zero */
-    if (*num>='1' && *num<='9')	
-		do	
-			n=(n*10.0)+(*num++ -'0');
-        while (*num>='0' && *num<='9');	/* Number? */
-		
-    if (*num=='.' && num[1]>='0' && num[1]<='9') {
+   ʹõļ㷽: 12.345E6 --> 12345E(-3+6)--> 12345*(10^(-3+6))
+   ǰ19λЧۼӵ64λm. ûбضϵʱ:
+   ָΪ0ֱת(mתΪdoubleȷ); m<=2^53|ָ|<=22ʱm10ݶǾȷ,
+   һγ˷ɵõȷĽ. parse_number_slow.
+   ȡendֽ֮ */
+#define IS_DIGIT(p,end) ((p)<(end) && *(p)>='0' && *(p)<='9')
+static const char *parse_number_exact(cJSON *item,const char *num,const char *end,int *exact)
+{
+    const char *start=num;
+    unsigned long long m=0;
+    int neg=0,digits=0,exp10=0,e=0,esign=1,truncated=0,isint=1;
+    double n;
+
+    if (num<end && *num=='-') neg=1,num++;		/* жǷΪ */
+    if (num<end && *num=='0') num++;			/* is zero */
+    else if (IS_DIGIT(num,end))
+        do {
+            if (digits<19) m=m*10+(*num-'0'),digits++;
+            else {exp10++; if (*num!='0') truncated=1;}
+            num++;
+        } while (IS_DIGIT(num,end));	/* Number? */
+
+    if (num<end && *num=='.' && IS_DIGIT(num+1,end)) {
         num++;		   /* Fractional part? */
-        do	
-			n=(n*10.0)+(*num++ -'0'),scale--;
-        while (*num>='0' && *num<='9');
+        isint=0;
+        do {
+            if (m==0 && *num=='0') exp10--;	/* ǰ0 */
+            else if (digits<19) m=m*10+(*num-'0'),digits++,exp10--;
+            else if (*num!='0') truncated=1;
+            num++;
+        } while (IS_DIGIT(num,end));
     }
-    if (*num=='e' || *num=='E') {	/* Exponent? */
+    if (num<end && (*num=='e' || *num=='E')) {	/* Exponent? */
         num++;
-        if (*num=='+') num++;
-        else if (*num=='-') signsubscale=-1,num++;		/* With sign? */
-        while (*num>='0' && *num<='9') subscale=(subscale*10)+(*num++ - '0');	/* Number? */
+        isint=0;
+        if (num<end && *num=='+') num++;
+        else if (num<end && *num=='-') esign=-1,num++;		/* With sign? */
+        while (IS_DIGIT(num,end)) {		/* Number? */
+            if (e<NUMBER_MAX_EXP) e=(e*10)+(*num-'0');
+            num++;
+        }
     }
+    exp10+=esign*e;
 
-    n=sign*n*pow(10.0,(scale+subscale*signsubscale));	/* number = +/- number.fraction * 10^+/- exponent */
+    if (m==0) n=0;
+    else if (truncated) n=parse_number_slow(start,num);
+    else if (exp10==0) n=(double)m;
+    else if (m<=(1ULL<<53) && exp10>0 && exp10<=22) n=(double)m*exact_pow10[exp10];
+    else if (m<=(1ULL<<53) && exp10<0 && exp10>=-22) n=(double)m/exact_pow10[-exp10];
+    else n=parse_number_slow(start,num);
+    if (neg) n=-n;
 
     item->valuedouble=n;
-    item->valueint=(int)n;
+    *exact=isint && !truncated && !exp10 && m<=(neg?(1ULL<<63):(unsigned long long)LLONG_MAX);	//19λexp10>0
+    if (*exact)
+        item->valueint64=!neg?(long long)m:(m==(1ULL<<63)?LLONG_MIN:-(long long)m);	/* ı: 澫ȷֵ */
+    else
+        item->valueint64=double_to_int64(n);
+    item->valueint=int64_to_int(item->valueint64);
     item->type=cJSON_Number;
     return num;
 }
+/* exact: ılong longΧڵ, valueint64ľȷֵ(valueint64valuedoubleͽضϵõ) */
+static const char *parse_number(cJSON *item,const char *num,const char *end)
+{
+    int exact;
+    return parse_number_exact(item,num,end,&exact);
+}
 
 //شڵxС2Nη
 static int pow2gt (int x)
@@ -151,80 +705,342 @@ static int pow2gt (int x)
 }
 
 //洢ṹ,ڴšṹcJSONתΪıʽJSON
+//еֱдbuffer+offset,offsetƵд֮,offsetʼǾȷ
 typedef struct {
     char *buffer; //ıʽJSON
     int length; //bufferռĴС
     int offset; //ʹõbufferĴС
+    cJSON_Context *ctx; //bufferʹõķ亯
+    cJSON_WriteFn write_fn; //Ϊ0ʱ,bufferдݽwrite_fnͷʼʹ(cJSON_PrintToWriter)
+    void *user; //write_fnĵһ
+    int fixed; //0ʱbufferڵ,Ҳͷ(cJSON_PrintPreallocated)
 } printbuffer;
 
 /* жϴ洢ṹpĻǷneededʣռ,û·㹻Ŀռ
    :p:洢ṹָ
         needed: ҪĿռС
-   :ָпռʼλõָ,ʧ-0
+   :ָпռʼλõָ,ʧ-0(ʱѱͷ)
    */
 static char* ensure(printbuffer *p,int needed)
 {
     char *newbuffer;
     int newsize;
     if (!p || !p->buffer) return 0;
-    needed+=p->offset;
-    if (needed<=p->length)//ԭp->bufferлneededÿռ
+    if (p->offset+needed<=p->length)//ԭp->bufferлneededÿռ
 		return p->buffer+p->offset;
+    if (p->fixed) return 0;	//ߵĻ岻
+    if (p->write_fn && p->offset) {//ʽ: Ȱедȥ
+        if (!p->write_fn(p->user,p->buffer,p->offset)) {
+            p->ctx->free_fn(p->buffer);
+            p->length=0,p->buffer=0;
+            return 0;
+        }
+        p->offset=0;
+        if (needed<=p->length) return p->buffer;
+    }
+    if (needed<0 || needed>INT_MAX/2-p->offset) {	//1GB: intʾ˷ĴС
+        p->ctx->free_fn(p->buffer);
+        p->length=0,p->buffer=0;
+        return 0;
+    }
+    needed+=p->offset;
 
 	//ԭp->bufferûneededÿռ,Ҫ·
     newsize=pow2gt(needed);//õڵneededС2Nη,ڷռ䣭ʹĿռСΪ2^N
-    newbuffer=(char*)cJSON_malloc(newsize);//ռ
+    newbuffer=(char*)p->ctx->malloc_fn(newsize);//ռ
     if (!newbuffer) {
-        cJSON_free(p->buffer);
+        p->ctx->free_fn(p->buffer);
         p->length=0,p->buffer=0;
         return 0;
     }
-    if (newbuffer) memcpy(newbuffer,p->buffer,p->length);
-    cJSON_free(p->buffer);
+    memcpy(newbuffer,p->buffer,p->offset);	//ֻ踴дĲ
+    COUNT(ensure_grows,1);
+    COUNT(bytes_copied,p->offset);
+    p->ctx->free_fn(p->buffer);
     p->length=newsize;
     p->buffer=newbuffer;
     return newbuffer+p->offset;
 }
 
-//ȡpĵǰʹbufferĴС(ڸoffset)
-static int update(printbuffer *p)
+//lenֽڵstr׷ӵp
+static int print_raw(printbuffer *p,const char *str,int len)
 {
-    char *str;
-    if (!p || !p->buffer) return 0;
-    str=p->buffer+p->offset;
-    return p->offset+strlen(str);
+    char *out=ensure(p,len);
+    if (!out) return 0;
+    memcpy(out,str,len);
+    p->offset+=len;
+    return 1;
 }
 
-/*  ӦΪNumberĽṹcJSONתΪıʽJSON,洢ʵλ. 
-:item:ҪתΪJSONıʽcJSONָ
-         P:תдpʵλãΪNULLʱڲռ
-    :ת׵ַ*/
-static char *print_number(cJSON *item,printbuffer *p)
+//׷nƱ(ʽ)
+static int print_indent(printbuffer *p,int n)
 {
-    char *str=0;
-    double d=item->valuedouble;
-    if (d==0) {
-        if (p)	str=ensure(p,2);
-        else	str=(char*)cJSON_malloc(2);	/* special case for 0. */
-        if (str) strcpy(str,"0");
-    } 
-	else 
-		//EPSILONdoubleС EPSILON+XXС
-		//жϵ:ǷJSONNumberжΪint
-	if (fabs(((double)item->valueint)-d)<=DBL_EPSILON && d<=INT_MAX && d>=INT_MIN) {//Numberint
-        if (p)	str=ensure(p,21);
-        else	str=(char*)cJSON_malloc(21);	/* 2^64+1 ĴС 20ַʾ,ټһ'\0'. */
-        if (str)	sprintf(str,"%d",item->valueint);
-    } else {//Numberdouble
-        if (p)	str=ensure(p,64);
-        else	str=(char*)cJSON_malloc(64);	/* This is a nice tradeoff. */
-        if (str) {
-            if (fabs(floor(d)-d)<=DBL_EPSILON && fabs(d)<1.0e60)sprintf(str,"%.0f",d);
-            else if (fabs(d)<1.0e-6 || fabs(d)>1.0e9)			sprintf(str,"%e",d);
-            else												sprintf(str,"%f",d);
+    char *out;
+    if (n<=0) return 1;
+    if (!(out=ensure(p,n))) return 0;
+    memset(out,'\t',n);
+    p->offset+=n;
+    return 1;
+}
+
+/* ֵ.
+   print_int64λת; doubleGrisu2㷨(Florian Loitsch, "Printing Floating-Point Numbers
+   Quickly and Accurately with Integers")̵ġܱȫͬdoubleʮִ,
+   format_digitsͨСǿѧʾ. sprintf,ҲlocaleӰ */
+
+typedef struct {unsigned long long f; int e;} diy_fp;	//f*2^e
+
+/* 10^-348,10^-340,...,10^340 64λ񻯽ֵ */
+static const unsigned long long cached_powers_f[87]={
+    0xfa8fd5a0081c0288ULL,0xbaaee17fa23ebf76ULL,0x8b16fb203055ac76ULL,0xcf42894a5dce35eaULL,
+    0x9a6bb0aa55653b2dULL,0xe61acf033d1a45dfULL,0xab70fe17c79ac6caULL,0xff77b1fcbebcdc4fULL,
+    0xbe5691ef416bd60cULL,0x8dd01fad907ffc3cULL,0xd3515c2831559a83ULL,0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL,0xaecc49914078536dULL,0x823c12795db6ce57ULL,0xc21094364dfb5637ULL,
+    0x9096ea6f3848984fULL,0xd77485cb25823ac7ULL,0xa086cfcd97bf97f4ULL,0xef340a98172aace5ULL,
+    0xb23867fb2a35b28eULL,0x84c8d4dfd2c63f3bULL,0xc5dd44271ad3cdbaULL,0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL,0xa3ab66580d5fdaf6ULL,0xf3e2f893dec3f126ULL,0xb5b5ada8aaff80b8ULL,
+    0x87625f056c7c4a8bULL,0xc9bcff6034c13053ULL,0x964e858c91ba2655ULL,0xdff9772470297ebdULL,
+    0xa6dfbd9fb8e5b88fULL,0xf8a95fcf88747d94ULL,0xb94470938fa89bcfULL,0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL,0x993fe2c6d07b7facULL,0xe45c10c42a2b3b06ULL,0xaa242499697392d3ULL,
+    0xfd87b5f28300ca0eULL,0xbce5086492111aebULL,0x8cbccc096f5088ccULL,0xd1b71758e219652cULL,
+    0x9c40000000000000ULL,0xe8d4a51000000000ULL,0xad78ebc5ac620000ULL,0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL,0x8f7e32ce7bea5c70ULL,0xd5d238a4abe98068ULL,0x9f4f2726179a2245ULL,
+    0xed63a231d4c4fb27ULL,0xb0de65388cc8ada8ULL,0x83c7088e1aab65dbULL,0xc45d1df942711d9aULL,
+    0x924d692ca61be758ULL,0xda01ee641a708deaULL,0xa26da3999aef774aULL,0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL,0x865b86925b9bc5c2ULL,0xc83553c5c8965d3dULL,0x952ab45cfa97a0b3ULL,
+    0xde469fbd99a05fe3ULL,0xa59bc234db398c25ULL,0xf6c69a72a3989f5cULL,0xb7dcbf5354e9beceULL,
+    0x88fcf317f22241e2ULL,0xcc20ce9bd35c78a5ULL,0x98165af37b2153dfULL,0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL,0xfb9b7cd9a4a7443cULL,0xbb764c4ca7a44410ULL,0x8bab8eefb6409c1aULL,
+    0xd01fef10a657842cULL,0x9b10a4e5e9913129ULL,0xe7109bfba19c0c9dULL,0xac2820d9623bf429ULL,
+    0x80444b5e7aa7cf85ULL,0xbf21e44003acdd2dULL,0x8e679c2f5e44ff8fULL,0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL,0xeb96bf6ebadf77d9ULL,0xaf87023b9bf0ee6bULL
+};
+static const short cached_powers_e[87]={
+    -1220,-1193,-1166,-1140,-1113,-1087,-1060,-1034,-1007,-980,-954,-927,-901,-874,-847,-821,
+    -794,-768,-741,-715,-688,-661,-635,-608,-582,-555,-529,-502,-475,-449,-422,-396,
+    -369,-343,-316,-289,-263,-236,-210,-183,-157,-130,-103,-77,-50,-24,3,30,
+    56,83,109,136,162,189,216,242,269,295,322,348,375,402,428,455,
+    481,508,534,561,588,614,641,667,694,720,747,774,800,827,853,880,
+    907,933,960,986,1013,1039,1066
+};
+static const unsigned long long pow10_u64[20]={
+    1ULL,10ULL,100ULL,1000ULL,10000ULL,100000ULL,1000000ULL,10000000ULL,100000000ULL,1000000000ULL,
+    10000000000ULL,100000000000ULL,1000000000000ULL,10000000000000ULL,100000000000000ULL,
+    1000000000000000ULL,10000000000000000ULL,100000000000000000ULL,1000000000000000000ULL,
+    10000000000000000000ULL
+};
+
+//diy_fp,ȡ128λ˻ĸ64λ()
+static diy_fp diy_fp_mul(diy_fp x,diy_fp y)
+{
+    const unsigned long long M32=0xFFFFFFFFULL;
+    unsigned long long a=x.f>>32,b=x.f&M32,c=y.f>>32,d=y.f&M32;
+    unsigned long long ac=a*c,bc=b*c,ad=a*d,bd=b*d;
+    unsigned long long tmp=(bd>>32)+(ad&M32)+(bc&M32);
+    diy_fp r;
+    tmp+=1ULL<<31;
+    r.f=ac+(ad>>32)+(bc>>32)+(tmp>>32);
+    r.e=x.e+y.e+64;
+    return r;
+}
+
+static diy_fp diy_fp_normalize(diy_fp x)
+{
+    while (!(x.f&(1ULL<<63))) x.f<<=1,x.e--;
+    return x;
+}
+
+//double dĹ񻯱ʾw,±߽m_plus/m_minus(m_plusָͬ)
+static void diy_fp_boundaries(double d,diy_fp *w,diy_fp *m_minus,diy_fp *m_plus)
+{
+    const unsigned long long hidden=1ULL<<52;
+    unsigned long long bits;
+    int biased_e;
+    diy_fp v,pl,mi;
+
+    memcpy(&bits,&d,sizeof(bits));
+    biased_e=(int)((bits>>52)&0x7FF);
+    v.f=bits&(hidden-1);
+    if (biased_e) v.f+=hidden,v.e=biased_e-1075;
+    else v.e=-1074;
+
+    pl.f=(v.f<<1)+1,pl.e=v.e-1;
+    while (!(pl.f&(hidden<<1))) pl.f<<=1,pl.e--;
+    pl.f<<=10,pl.e-=10;
+    if (v.f==hidden) mi.f=(v.f<<2)-1,mi.e=v.e-2;	//2:±߽ø
+    else mi.f=(v.f<<1)-1,mi.e=v.e-1;
+    mi.f<<=mi.e-pl.e,mi.e=pl.e;
+
+    *w=diy_fp_normalize(v);
+    *m_minus=mi;
+    *m_plus=pl;
+}
+
+//ѡʵ10^-k,ʹe+(10^-kĶָ)[-60,-32]
+static diy_fp cached_power(int e,int *k)
+{
+    double dk=(-61-e)*0.30102999566398114+347;	//log10(2)
+    int ik=(int)dk,index;
+    diy_fp r;
+    if (dk-ik>0.0) ik++;
+    index=(ik>>3)+1;
+    *k=-(-348+index*8);
+    r.f=cached_powers_f[index],r.e=cached_powers_e[index];
+    return r;
+}
+
+//λڵǰ,һλw£
+static void grisu_round(char *buf,int len,unsigned long long delta,unsigned long long rest,unsigned long long ten_kappa,unsigned long long wp_w)
+{
+    while (rest<wp_w && delta-rest>=ten_kappa && (rest+ten_kappa<wp_w || wp_w-rest>rest+ten_kappa-wp_w)) {
+        buf[len-1]--;
+        rest+=ten_kappa;
+    }
+}
+
+//[w-delta,Mp]ھٵ. Ϊbuf[0..len)*10^k
+static int grisu_digits(diy_fp w,diy_fp Mp,unsigned long long delta,char *buf,int *k)
+{
+    diy_fp one;
+    unsigned long long wp_w=Mp.f-w.f,p2,tmp;
+    unsigned p1,d;
+    int kappa,len=0;
+
+    one.f=1ULL<<-Mp.e,one.e=Mp.e;
+    p1=(unsigned)(Mp.f>>-one.e);
+    p2=Mp.f&(one.f-1);
+    for (kappa=10; kappa>1 && p1<pow10_u64[kappa-1]; kappa--);	//p1ʮλ
+    while (kappa>0) {
+        d=p1/(unsigned)pow10_u64[kappa-1];
+        p1%=(unsigned)pow10_u64[kappa-1];
+        if (d || len) buf[len++]=(char)('0'+d);
+        kappa--;
+        tmp=((unsigned long long)p1<<-one.e)+p2;
+        if (tmp<=delta) {
+            *k+=kappa;
+            grisu_round(buf,len,delta,tmp,pow10_u64[kappa]<<-one.e,wp_w);
+            return len;
         }
     }
-    return str;
+    for (;;) {
+        p2*=10;
+        delta*=10;
+        d=(unsigned)(p2>>-one.e);
+        if (d || len) buf[len++]=(char)('0'+d);
+        p2&=one.f-1;
+        kappa--;
+        if (p2<delta) {
+            *k+=kappa;
+            grisu_round(buf,len,delta,p2,one.f,-kappa<20?wp_w*pow10_u64[-kappa]:0);
+            return len;
+        }
+    }
+}
+
+//dΪ. buf17λ,λ, d==buf*10^k
+static int grisu2(double d,char *buf,int *k)
+{
+    diy_fp w,m_minus,m_plus,c_mk,W,Wp,Wm;
+    diy_fp_boundaries(d,&w,&m_minus,&m_plus);
+    c_mk=cached_power(m_plus.e,k);
+    W=diy_fp_mul(w,c_mk);
+    Wp=diy_fp_mul(m_plus,c_mk);
+    Wm=diy_fp_mul(m_minus,c_mk);
+    Wm.f++;
+    Wp.f--;
+    return grisu_digits(W,Wp,Wp.f-Wm.f,buf,k);
+}
+
+//ʮдout,س
+static int print_int64(long long v,char *out)
+{
+    char tmp[20];
+    unsigned long long u=v<0?0-(unsigned long long)v:(unsigned long long)v;
+    int n=0,len=0;
+    do tmp[n++]=(char)('0'+u%10),u/=10; while (u);
+    if (v<0) out[len++]='-';
+    while (n) out[len++]=tmp[--n];
+    out[len]=0;
+    return len;
+}
+
+/* digits[0..len)*10^kдJSON: ʮָ[-6,21)ͨд(1.5, 0.001, 100),
+   ÿѧ(1.5e+300, 1e-7). bufҪNUMBER_PRINT_SIZEֽ */
+static int format_digits(char *buf,int len,int k)
+{
+    int kk=len+k,i;		//10^(kk-1) <= ֵ < 10^kk
+    if (k>=0 && kk<=21) {					//: ں油0
+        for (i=len; i<kk; i++) buf[i]='0';
+        len=kk;
+    } else if (kk>0 && kk<=21) {			//1234e-2 -> 12.34
+        memmove(buf+kk+1,buf+kk,len-kk);
+        buf[kk]='.';
+        len++;
+    } else if (kk>-6 && kk<=0) {			//1234e-6 -> 0.001234
+        int off=2-kk;
+        memmove(buf+off,buf,len);
+        buf[0]='0',buf[1]='.';
+        for (i=2; i<off; i++) buf[i]='0';
+        len+=off;
+    } else {								//1234e30 -> 1.234e+33
+        char *e;
+        if (len>1) {
+            memmove(buf+2,buf+1,len-1);
+            buf[1]='.';
+            len++;
+        }
+        e=buf+len;
+        *e++='e';
+        kk--;
+        if (kk<0) *e++='-',kk=-kk;
+        else *e++='+';
+        if (kk>=100) *e++=(char)('0'+kk/100),kk%=100,*e++=(char)('0'+kk/10),*e++=(char)('0'+kk%10);
+        else if (kk>=10) *e++=(char)('0'+kk/10),*e++=(char)('0'+kk%10);
+        else *e++=(char)('0'+kk);
+        len=(int)(e-buf);
+    }
+    buf[len]=0;
+    return len;
+}
+
+#define NUMBER_PRINT_SIZE 32	//һҪĿռ: +17λ+С㼰ǰ"0.00000"ָ+'\0'
+
+//itemֵǷӦΪ,ʱд*v
+static int number_as_int64(const cJSON *item,long long *v)
+{
+    double d=item->valuedouble;
+    if (d==0) *v=0;		/* special case for 0. */
+    else if ((double)item->valueint==d) *v=item->valueint;		//Numberint
+    else if ((double)item->valueint64==d && item->valueint64!=LLONG_MAX && item->valueint64!=LLONG_MIN) *v=item->valueint64;	//intΧ:valueint64žȷֵ(ܳdouble53λ). ˵ֲֵǲǱͽضϵ,double
+    else return 0;
+    return 1;
+}
+
+//itemֵдout(NUMBER_PRINT_SIZEֽ),س
+static int format_number(const cJSON *item,char *out)
+{
+    double d=item->valuedouble;
+    long long v;
+    int len,k,neg=0;
+
+    if (number_as_int64(item,&v)) return print_int64(v,out);
+    if (d!=d || d-d!=0) {memcpy(out,"null",5);return 4;}	//NaNJSON޷ʾ
+    if (d<0) out[0]='-',d=-d,neg=1;
+    len=grisu2(d,out+neg,&k);
+    return neg+format_digits(out+neg,len,k);
+}
+
+/* cJSONNumberתΪJSONıʽ,ֱдp
+:item:ҪתΪJSONıʽcJSONָ
+         P:
+    :ɹ1,ʧܣ0*/
+static int print_number(const cJSON *item,printbuffer *p)
+{
+    char tmp[NUMBER_PRINT_SIZE],*str;
+    if (p->fixed && p->offset+NUMBER_PRINT_SIZE>p->length) return print_raw(p,tmp,format_number(item,tmp));	//ߵĻʱʵʳд
+    if (!(str=ensure(p,NUMBER_PRINT_SIZE))) return 0;
+    p->offset+=format_number(item,str);
+    return 1;
 }
 
 static unsigned parse_hex4(const char *str)
@@ -255,34 +1071,39 @@ static unsigned parse_hex4(const char *str)
     return h;
 }
 
-/* ıַ,item
-   :item:ҪcJSON
-        str :Ҫַ
-   :ɵַ. */
-static const unsigned char firstByteMark[7] = { 0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC };
-static const char *parse_string(cJSON *item,const char *str)
+/* ҵptr(ͷ֮)ʼַĽβ,պϵ,ûʱΪend. *escaped:Ƿתַ
+   scan_string_nһһβ'"','\\'Ϳַ */
+static const char *string_end(const char *ptr,const char *end,int *escaped)
 {
-    const char *ptr=str+1;//ʹptrָһַ,ʾַ"
-    char *ptr2;
-    char *out;
-    int len=0;
-    unsigned uc,uc2;
-    if (*str!='\"') {//strǷΪJSONstring
-        ep=str;    /* not a string! */
-        return 0;
+    *escaped=0;
+    for (;;) {
+        ptr=scan_string_n(ptr,end);
+        if (ptr>=end || *ptr=='\"') return ptr;
+        if (*ptr=='\\') {
+            *escaped=1;
+            if (++ptr>=end) return end;	/* Skip escaped quotes. */
+        }
+        ptr++;
     }
+}
 
-    while (*ptr!='\"' && *ptr && ++len) if (*ptr++ == '\\') ptr++;	/* Skip escaped quotes. */
-
-    out=(char*)cJSON_malloc(len+1);	/* This is how long we need for the string, roughly. */
-    if (!out) return 0;
-
-    ptr=str+1;
-    ptr2=out;
-    while (*ptr!='\"' && *ptr) {
-        if (*ptr!='\\') *ptr2++=*ptr++;
+/* [ptr,end)еַݽ(תַ)ptr2. ֻ,ptr2Եptr(ԭؽ)
+   :Ľβ */
+static const unsigned char firstByteMark[7] = { 0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC };
+static char *decode_string(const char *ptr,const char *end,char *ptr2)
+{
+    unsigned uc,uc2;
+    int len;
+    while (ptr<end) {
+        if (*ptr!='\\') {	//ƵһתַΪֹ
+            const char *run=scan_string_n(ptr,end);
+            while (run<end && *run!='\\') run=scan_string_n(run+1,end);	//ַԭ
+            if (ptr2!=ptr) memmove(ptr2,ptr,run-ptr);
+            ptr2+=run-ptr;
+            ptr=run;
+        }
         else {//JSONıаתַ
-            ptr++;
+            if (++ptr>=end) break;	//ı'\\'
             switch (*ptr) {
                 case 'b':
                     *ptr2++='\b';break;
@@ -295,13 +1116,14 @@ static const char *parse_string(cJSON *item,const char *str)
                 case 't':
                     *ptr2++='\t';break;
                 case 'u':	 /* utf16תΪutf8.ⲿʵֲοunicode */
+                    if (end-ptr<5) {ptr=end; continue;}	/* \uXXXX */
                     uc=parse_hex4(ptr+1);
                     ptr+=4;	/* get the unicode char. */
 
                     if ((uc>=0xDC00 && uc<=0xDFFF) || uc==0)	break;	/* check for invalid.	*/
 
                     if (uc>=0xD800 && uc<=0xDBFF) {	/* UTF16 surrogate pairs.	*/
-                        if (ptr[1]!='\\' || ptr[2]!='u')	break;	/* missing second-half of surrogate.	*/
+                        if (end-ptr<7 || ptr[1]!='\\' || ptr[2]!='u')	break;	/* missing second-half of surrogate.	*/
                         uc2=parse_hex4(ptr+3);
                         ptr+=6;
                         if (uc2<0xDC00 || uc2>0xDFFF)		break;	/* invalid second-half of surrogate.	*/
@@ -331,687 +1153,2449 @@ static const char *parse_string(cJSON *item,const char *str)
             ptr++;
         }
     }
-    *ptr2=0;
-    if (*ptr=='\"') ptr++;
-    item->valuestring=out;
-    item->type=cJSON_String;
-    return ptr;
+    return ptr2;
 }
 
-/* Render the cstring provided to an escaped version that can be printed. */
-/*  ַstr洢pĿλ. 
-:str:Ҫ洢ַ
-         P:תдpʵλãΪNULLʱڲռ
-    :ת׵ַ,ʧܣ0*/
-static char *print_string_ptr(const char *str,printbuffer *p)
+/* ıַ,item
+   :item:ҪcJSON
+        str :Ҫַ
+        end :ıĽβ,ȡendֽ֮
+   :ɵַ. */
+static const char *parse_string(cJSON_Context *ctx,cJSON *item,const char *str,const char *end)
 {
-    const char *ptr;
-    char *ptr2,*out;
-    int len=0,flag=0;
-    unsigned char token;
+    const char *ptr=str+1;//ʹptrָһַ,ʾַ"
+    const char *stop;
+    char *ptr2;
+    char *out;
+    int len=0,escaped=0;
+    if (str>=end || *str!='\"') {//strǷΪJSONstring
+        ctx->error=str;    /* not a string! */
+        return 0;
+    }
 
-	//JSONStringǷַ
-    for (ptr=str; *ptr; ptr++) 
-		flag|=((*ptr>0 && *ptr<32)||(*ptr=='\"')||(*ptr=='\\'))?1:0;
-	
-    if (!flag) {
-        len=ptr-str;
-        if (p) out=ensure(p,len+3);
-        else out=(char*)cJSON_malloc(len+3);
-        if (!out) return 0;
-        ptr2=out;
-        *ptr2++='\"';
-        strcpy(ptr2,str);
-        ptr2[len]='\"';
-        ptr2[len+1]=0;
-        return out;
-    }
-
-    if (!str) {
-        if (p)	out=ensure(p,3);
-        else	out=(char*)cJSON_malloc(3);
-        if (!out) return 0;
-        strcpy(out,"\"\"");
-        return out;
-    }
-
-	//ַʱĴ
-    ptr=str;
-    while ((token=*ptr) && ++len) {
-        if (strchr("\"\\\b\f\n\r\t",token)) len++;//ΪתַҪռһַ, :ASCII:08Ӧתַ\b
-        else if (token<32) len+=5;//ַJSON\uxxxxʽ洢 
-        ptr++;
+    stop=string_end(ptr,end,&escaped);	//ҵַĽβ
+    if (stop>=end) {
+        ctx->error=stop;    /* ûбպϵ */
+        return 0;
     }
+    len=(int)(stop-(str+1));
 
-    if (p)	out=ensure(p,len+3);
-    else	out=(char*)cJSON_malloc(len+3);
+    if (ctx->options&CJSON_OPT_INSITU) {	//ԭؽ: ᳬպϵ,'\0'滻
+        out=(char*)str+1;
+        ptr2=escaped?decode_string(str+1,stop,out):out+len;
+        ptr=stop+1;
+        *ptr2=0;
+        item->valuestring=out;
+        item->type=cJSON_String|cJSON_ValueIsConst;
+        return ptr;
+    }
+
+    out=(char*)parse_malloc(ctx,len+1);	/* תнֻ,len㹻. */
     if (!out) return 0;
 
-    ptr2=out;
-    ptr=str;
-    *ptr2++='\"';
-    while (*ptr) {
-        if ((unsigned char)*ptr>31 && *ptr!='\"' && *ptr!='\\') *ptr2++=*ptr++;//ֱַӸ
-        else {
-            *ptr2++='\\';//תַǰ'\'
-            switch (token=*ptr++) {
-                case '\\':
-                    *ptr2++='\\';
-                    break;
-                case '\"':
-                    *ptr2++='\"';
-                    break;
-                case '\b':
-                    *ptr2++='b';
-                    break;
-                case '\f':
-                    *ptr2++='f';
-                    break;
-                case '\n':
-                    *ptr2++='n';
-                    break;
-                case '\r':
-                    *ptr2++='r';
-                    break;
-                case '\t':
-                    *ptr2++='t';
-                    break;
-                default:
-                    sprintf(ptr2,"u%04x",token);
-                    ptr2+=5;
-                    break;	/* escape and print */
+    if (!escaped) {	//ûתַ: θ
+        memcpy(out,str+1,len);
+        ptr2=out+len;
+    }
+    else ptr2=decode_string(str+1,stop,out);
+    *ptr2=0;
+    COUNT(bytes_copied,ptr2-out);
+    ptr=stop+1;	//պϵ
+    item->valuestring=out;
+    item->type=cJSON_String;
+    return ptr;
+}
+
+/* פ(cJSON_KeyTable): ͬļֻһ,ڵstringָ(ΪcJSON_StringIsConst|cJSON_StringIsInterned).
+   ÿǰintern_head,ֹϣֵͳ,ʱټϣ */
+typedef struct {
+    unsigned hash[2];	//[0]:Сд [1]:Сд,ͬhash_key
+    unsigned len;
+} intern_head;
+
+typedef struct key_chunk {
+    struct key_chunk *next;
+} key_chunk;
+
+struct cJSON_KeyTable {
+    void *(*malloc_fn)(size_t sz);
+    void (*free_fn)(void *ptr);
+    char **slots;		//cap,ָ,0ʾղ
+    int cap,count;
+    key_chunk *chunks;	//ڵڴ,µǰ
+    size_t used,size;	//chunksеһúܴС
+};
+
+#define KEY_CHUNK_SIZE 4096
+
+static unsigned hash_key(const char *s,int cs)
+{
+    unsigned h=2166136261u;	/* FNV-1a */
+    if (cs) while (*s) h=(h^(unsigned char)*s++)*16777619u;
+    else	while (*s) h=(h^(unsigned char)tolower((unsigned char)*s++))*16777619u;
+    return h;
+}
+
+cJSON_KeyTable *cJSON_KeyTableCreate(cJSON_Context *ctx)
+{
+    cJSON_Context *c=ctx?ctx:&default_ctx;
+    cJSON_KeyTable *keys=(cJSON_KeyTable*)c->malloc_fn(sizeof(cJSON_KeyTable));
+    if (!keys) return 0;
+    memset(keys,0,sizeof(cJSON_KeyTable));
+    keys->malloc_fn=c->malloc_fn;
+    keys->free_fn=c->free_fn;
+    keys->cap=64;
+    if (!(keys->slots=(char**)keys->malloc_fn(keys->cap*sizeof(char*)))) {
+        keys->free_fn(keys);
+        return 0;
+    }
+    memset(keys->slots,0,keys->cap*sizeof(char*));
+    return keys;
+}
+
+void cJSON_KeyTableDelete(cJSON_KeyTable *keys)
+{
+    key_chunk *c;
+    if (!keys) return;
+    while ((c=keys->chunks)) keys->chunks=c->next,keys->free_fn(c);
+    keys->free_fn(keys->slots);
+    keys->free_fn(keys);
+}
+
+/* פ[s,s+len),عõһ. ʧܷ0 */
+static char *key_intern(cJSON_KeyTable *keys,const char *s,size_t len)
+{
+    unsigned h=2166136261u,hc=2166136261u;
+    intern_head *head;
+    size_t i,sz;
+    char **slots,*out;
+    int mask=keys->cap-1,j,k;
+
+    for (i=0; i<len; i++) {
+        h=(h^(unsigned char)s[i])*16777619u;
+        hc=(hc^(unsigned char)tolower((unsigned char)s[i]))*16777619u;
+    }
+    for (j=h&mask; (out=keys->slots[j]); j=(j+1)&mask) {	//Ѿ
+        head=(intern_head*)out-1;
+        if (head->hash[1]==h && head->len==len && !memcmp(out,s,len)) return out;
+    }
+    if ((keys->count+1)*2>keys->cap) {	//,װӱ1/2
+        if (!(slots=(char**)keys->malloc_fn(2*keys->cap*sizeof(char*)))) return 0;
+        memset(slots,0,2*keys->cap*sizeof(char*));
+        mask=2*keys->cap-1;
+        for (k=0; k<keys->cap; k++) if (keys->slots[k]) {
+            for (j=((intern_head*)keys->slots[k]-1)->hash[1]&mask; slots[j]; j=(j+1)&mask);
+            slots[j]=keys->slots[k];
+        }
+        keys->free_fn(keys->slots);
+        keys->slots=slots;
+        keys->cap*=2;
+        for (j=h&mask; keys->slots[j]; j=(j+1)&mask);
+    }
+    sz=(sizeof(intern_head)+len+1+sizeof(intern_head)-1)/sizeof(intern_head)*sizeof(intern_head);	//intern_head
+    if (!keys->chunks || keys->used+sz>keys->size) {	//µڴ,̫ļռһ
+        size_t size=sz>KEY_CHUNK_SIZE?sz:KEY_CHUNK_SIZE;
+        key_chunk *c=(key_chunk*)keys->malloc_fn(sizeof(intern_head)*2+size);
+        if (!c) return 0;
+        c->next=keys->chunks;
+        keys->chunks=c;
+        keys->used=0;
+        keys->size=size;
+    }
+    head=(intern_head*)((char*)keys->chunks+sizeof(intern_head)*2+keys->used);	//ͷ֮intern_head
+    keys->used+=sz;
+    head->hash[0]=hc;
+    head->hash[1]=h;
+    head->len=(unsigned)len;
+    out=(char*)(head+1);
+    memcpy(out,s,len);
+    out[len]=0;
+    COUNT(bytes_copied,len);
+    keys->slots[j]=out;
+    keys->count++;
+    return out;
+}
+
+const char *cJSON_InternKey(cJSON_KeyTable *keys,const char *key)
+{
+    return keys && key?key_intern(keys,key,strlen(key)):0;
+}
+
+/* itemļĹϣֵ. פļֱȡԤõֵ */
+static unsigned item_hash(const cJSON *item,int cs)
+{
+    if (item->type&cJSON_StringIsInterned) return ((const intern_head*)item->string-1)->hash[cs];
+    return hash_key(item->string,cs);
+}
+
+/* ļitem->string. ctx->keysΪ0ʱפ: ûתַʱֱӴв,ڴ */
+static const char *parse_key(cJSON_Context *ctx,cJSON *item,const char *str,const char *end)
+{
+    const char *stop;
+    char buf[256],*tmp,*key;
+    int escaped;
+
+    if (!ctx->keys) {
+        str=parse_string(ctx,item,str,end);
+        item->string=item->valuestring;
+        item->valuestring=0;
+        return str;
+    }
+    if (str>=end || *str!='\"') {
+        ctx->error=str;    /* not a string! */
+        return 0;
+    }
+    stop=string_end(str+1,end,&escaped);
+    if (stop>=end) {
+        ctx->error=stop;    /* ûбպϵ */
+        return 0;
+    }
+    if (!escaped) key=key_intern(ctx->keys,str+1,stop-(str+1));
+    else {	//뵽ʱ,ֻ
+        tmp=stop-str<(int)sizeof(buf)?buf:(char*)ctx->malloc_fn(stop-str);
+        if (!tmp) return 0;
+        key=key_intern(ctx->keys,tmp,decode_string(str+1,stop,tmp)-tmp);
+        if (tmp!=buf) ctx->free_fn(tmp);
+    }
+    if (!key) return 0;
+    item->string=key;
+    item->type|=cJSON_StringIsConst|cJSON_StringIsInterned;	//parse_valueͺٴα
+    return stop+1;
+}
+
+/* ַstrŲתĳ. scan_stringһһַͨ */
+static size_t string_printed_length(const char *str)
+{
+    const char *run;
+    size_t len=2;
+    if (!str) return 2;
+    for (;;) {
+        run=scan_string(str);
+        len+=run-str;
+        if (!*run) return len;
+        len+=strchr("\"\\\b\f\n\r\t",*run)?2:6;	//תַռַ,ַ\uxxxxʽ洢
+        str=run+1;
+    }
+}
+
+/* Render the cstring provided to an escaped version that can be printed. */
+/*  ַstrŲתдp. 
+:str:Ҫ洢ַ
+         P:
+    :ɹ1,ʧܣ0*/
+static int print_string_ptr(const char *str,printbuffer *p)
+{
+    const char *ptr,*run;
+    char *ptr2,*out;
+    int len=0;
+    unsigned char token;
+
+    if (!str) return print_raw(p,"\"\"",2);
+
+	//JSONStringǷַ. scan_stringһһַͨ
+    ptr=scan_string(str);
+    if (!*ptr) {
+        len=(int)(ptr-str);
+        if (!(out=ensure(p,len+2))) return 0;
+        out[0]='\"';
+        memcpy(out+1,str,len);
+        out[len+1]='\"';
+        p->offset+=len+2;
+        return 1;
+    }
+
+	//ַʱĴ: תַҪռһַ(ASCII:08Ӧתַ\b),ַJSON\uxxxxʽ洢
+    len=(int)string_printed_length(str)-2;
+
+    if (!(out=ensure(p,len+2))) return 0;
+
+    ptr2=out;
+    ptr=str;
+    *ptr2++='\"';
+    while (*ptr) {
+        run=scan_string(ptr);	//ַθ
+        memcpy(ptr2,ptr,run-ptr);
+        ptr2+=run-ptr;
+        ptr=run;
+        if (!*ptr) break;
+        *ptr2++='\\';//תַǰ'\'
+        switch (token=*ptr++) {
+            case '\\':
+                *ptr2++='\\';
+                break;
+            case '\"':
+                *ptr2++='\"';
+                break;
+            case '\b':
+                *ptr2++='b';
+                break;
+            case '\f':
+                *ptr2++='f';
+                break;
+            case '\n':
+                *ptr2++='n';
+                break;
+            case '\r':
+                *ptr2++='r';
+                break;
+            case '\t':
+                *ptr2++='t';
+                break;
+            default:	/* escape and print */
+                *ptr2++='u';
+                *ptr2++='0';
+                *ptr2++='0';
+                *ptr2++="0123456789abcdef"[token>>4];
+                *ptr2++="0123456789abcdef"[token&15];
+                break;
+        }
+    }
+    *ptr2++='\"';
+    p->offset+=len+2;
+    return 1;
+}
+
+/* Predeclare these prototypes. */
+static const char *parse_value(cJSON_Context *ctx,cJSON *item,const char *value,const char *end,int depth);
+static int print_value(cJSON *item,int depth,int fmt,printbuffer *p);
+static void build_key_table(cJSON *object,int cs,cJSON_Context *ctx);
+static void build_item_vector(cJSON *array,cJSON_Context *ctx);
+static void close_array(cJSON_Context *ctx,cJSON *item,cJSON *last,int n);
+static void close_object(cJSON_Context *ctx,cJSON *item,cJSON *last,int n);
+static const char *parse_packed(cJSON_Context *ctx,cJSON *item,const char *value,const char *end);
+static int print_packed(cJSON *item,int fmt,printbuffer *p);
+static size_t packed_printed_length(cJSON *item,int fmt);
+
+/* ʽıջ: ӡ͸Ƕ׵/ʱݹ,Ƕײֻڴ(ctx->max_depth).
+   ǰWALK_LOCALڵջϵĻ,ʱctxķ亯չ */
+#define WALK_LOCAL 32
+typedef struct {
+    cJSON *node;	//ڴ(ʱΪĸ)
+    cJSON *child;	//ӡʱ:һҪԪ; ʱ:ԴһҪƵԪ
+    cJSON *last;	//ʱ:ĿǰһԪ; ʱ:еһԪ
+    int n;			//ʱ:Ԫظ; ӡʱ:Ԫص
+    size_t left;	//CBORʱ:ûԪظ, CBOR_INDEFʾ
+} walk_frame;
+
+typedef struct {
+    walk_frame *frames;
+    int depth,cap;
+    cJSON_Context *ctx;		//չջõķ亯
+    walk_frame local[WALK_LOCAL];
+} walk_stack;
+
+static void walk_init(walk_stack *s,cJSON_Context *ctx)
+{
+    s->frames=s->local,s->depth=0,s->cap=WALK_LOCAL,s->ctx=ctx;
+}
+
+static void walk_free(walk_stack *s)
+{
+    if (s->frames!=s->local) s->ctx->free_fn(s->frames);
+}
+
+//ѹnode,µջ. ڴ治ʱ0
+static walk_frame *walk_push(walk_stack *s,cJSON *node)
+{
+    walk_frame *f;
+    if (s->depth==s->cap) {
+        f=(walk_frame*)s->ctx->malloc_fn(2*s->cap*sizeof(walk_frame));
+        if (!f) return 0;
+        memcpy(f,s->frames,s->depth*sizeof(walk_frame));
+        walk_free(s);
+        s->frames=f,s->cap*=2;
+    }
+    f=&s->frames[s->depth++];
+    f->node=node,f->child=0,f->last=0,f->n=0,f->left=0;
+    return f;
+}
+
+
+
+
+/* :ɴӡַ,ൽendΪֹ */
+static const char *skip(const char *in,const char *end)
+{
+    if (!in || in>=end || !*in || (unsigned char)*in>32) return in;	//¸ûпհ
+    return scan_token(in+1,end);
+}
+
+//NULβıĽβ
+static const char *text_end(const char *s)
+{
+    return s?s+strlen(s):0;
+}
+
+/* ʹctxJSONı,һµĸ.
+:ctx:亯,arena,Ƕײƺѡ(cJSON_Context)
+ value:ҪлΪCJSONַ
+ return_parse_end:[out]ɸcJSONʱ,JSONַĽλ(ָ),ΪNULLʾ
+  ֵ:ɹ:һcJSONָ
+   ʧ:NULL,λñctx->error
+  ע:ҪcJSON_DeleteCtxͷ(arenaʱarenaͷ)
+ */
+static cJSON *parse_ctx(cJSON_Context *ctx,const char *value,const char *end,const char **return_parse_end)
+{
+    const char *ptr=0;
+    cJSON *c;
+    ctx->error=0;
+    c=parse_New_Item(ctx);
+    if (!c) return 0;       /* memory fail */
+
+    ptr=parse_value(ctx,c,skip(value,end),end,0);//ĺ
+    if (!ptr)	{
+        if (!ctx->arena) cJSON_DeleteCtx(ctx,c);    /* ʧʱctx->error. arenaеڴarenaʱ */
+        return 0;
+    }
+
+    /*JSONҪnullβʱм*/
+    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
+    if (ctx->options&cJSON_OptRequireNullTerminated) {
+        ptr=skip(ptr,end);
+        if (ptr<end && *ptr) {	//гȵ: '\0',Ҳֱӵβ
+            if (!ctx->arena) cJSON_DeleteCtx(ctx,c);
+            ctx->error=ptr;
+            return 0;
+        }
+    }
+    if (return_parse_end) *return_parse_end=ptr;
+    return c;
+}
+cJSON *cJSON_ParseCtx(cJSON_Context *ctx,const char *value,const char **return_parse_end)
+{
+    return parse_ctx(ctx,value,text_end(value),return_parse_end);
+}
+
+/* [value,value+length)еJSONı, Ҫ(Ҳ)β'\0', ȡvalue+lengthֽ֮.
+   ֱӽmmapļ绺еһ. λÿܵvalue+length(ı) */
+cJSON *cJSON_ParseWithLengthCtx(cJSON_Context *ctx,const char *value,size_t length,const char **return_parse_end)
+{
+    return parse_ctx(ctx,value,value?value+length:0,return_parse_end);
+}
+
+/* Ĭcontextһݿ[value,end), ٰѳλдĬcontext. options:cJSON_Opt*ڲѡ */
+static cJSON *parse_with_default(cJSON_Arena *arena,const char *value,const char *end,const char **return_parse_end,int options)
+{
+    cJSON_Context ctx=default_ctx;
+    cJSON *c;
+    ctx.arena=arena;
+    ctx.options=options;
+    c=parse_ctx(&ctx,value,end,return_parse_end);
+    default_ctx.error=ctx.error;
+    return c;
+}
+
+/* ,һµĸ.
+:value:ҪлΪCJSONַ
+ return_parse_end:[out]ɸcJSONʱ,JSONַĽλ(ָ),ΪNULLʾ
+       require_null_terminated:JSONַǷҪ'\0'
+  ֵ:ɹ:һcJSONָ
+   ʧ:NULL,λÿcJSON_GetErrorPtr()ȡ
+  ע:ʹøúͨmallocڴпһռ䣬ʹҪֶͷ(ͨcJSON_Delete)
+ */
+cJSON *cJSON_ParseWithOpts(const char *value,const char **return_parse_end,int require_null_terminated)
+{
+    return parse_with_default(0,value,text_end(value),return_parse_end,require_null_terminated?cJSON_OptRequireNullTerminated:0);
+}
+
+/* ͬcJSON_ParseWithOpts, ǳΪlengthһı(cJSON_ParseWithLengthCtx).
+   require_null_terminated:ֵֻ֮пհ(Լһѡ'\0') */
+cJSON *cJSON_ParseWithLengthOpts(const char *value,size_t length,const char **return_parse_end,int require_null_terminated)
+{
+    return parse_with_default(0,value,value?value+length:0,return_parse_end,require_null_terminated?cJSON_OptRequireNullTerminated:0);
+}
+cJSON *cJSON_ParseWithLength(const char *value,size_t length)
+{
+    return cJSON_ParseWithLengthOpts(value,length,0,0);
+}
+
+/* ԭؽ: ַͼֱӽjson,ڵָ(ΪcJSON_ValueIsConst/cJSON_StringIsConst).
+   jsonᱻ޸,ɾ֮ǰһֱЧ */
+cJSON *cJSON_ParseInSitu(char *json)
+{
+    return parse_with_default(0,json,text_end(json),0,CJSON_OPT_INSITU);
+}
+cJSON *cJSON_ParseInSituCtx(cJSON_Context *ctx,char *json,const char **return_parse_end)
+{
+    int options=ctx->options;
+    cJSON *c;
+    ctx->options|=CJSON_OPT_INSITU;
+    c=cJSON_ParseCtx(ctx,json,return_parse_end);
+    ctx->options=options;
+    return c;
+}
+
+/* JSONıarena. cJSON_ArenaReset/cJSON_ArenaDeleteʱһͷ */
+cJSON *cJSON_ParseInArena(cJSON_Arena *arena,const char *value)
+{
+    if (!arena) return 0;
+    return parse_with_default(arena,value,text_end(value),0,0);
+}
+
+
+
+
+
+
+/*JSONݰ,cJSONṹĽṹлݰ
+:value:ҪлΪCJSON
+  ֵ:ɹ:һcJSONָ
+   ʧ:NULL,λÿcJSON_GetErrorPtr()ȡ
+  ע:ʹøúͨmallocڴпһռ䣬ʹҪֶͷ(ͨcJSON_Delete)
+ */
+cJSON *cJSON_Parse(const char *value)
+{
+    return cJSON_ParseWithOpts(value,0,0);
+}
+
+
+
+
+/* ¼(SAX)ʽ: parse_value﷨ͬĵݹ½(Ƕײctx->max_depth), cJSONڵ,
+   ǶÿֵôhжӦĻص. ص0ʱֹͣ. ûתֱַַָı,
+   תַַ뵽scratch */
+typedef struct {
+    cJSON_Context *ctx;
+    const cJSON_SaxHandler *h;
+    void *user;
+    char *scratch;		//뺬תַַõĻ,ڶַ֮ظʹ
+    size_t scratch_cap;
+    const char *end;	//ıĽβ
+} sax_state;
+
+static const char *sax_value(sax_state *s,const char *value,int depth);
+
+//һַkeystringص
+static const char *sax_string(sax_state *s,const char *str,int is_key)
+{
+    const char *ptr=str+1,*end;
+    int escaped,ok;
+    size_t len;
+    if (str>=s->end || *str!='\"') {
+        s->ctx->error=str;    /* not a string! */
+        return 0;
+    }
+    end=string_end(ptr,s->end,&escaped);
+    if (end>=s->end) {
+        s->ctx->error=end;    /* ûбպϵ */
+        return 0;
+    }
+    len=(size_t)(end-ptr);
+    if (escaped) {
+        if (len+1>s->scratch_cap) {
+            size_t cap=s->scratch_cap?s->scratch_cap:64;
+            while (cap<len+1) cap*=2;
+            if (s->scratch) s->ctx->free_fn(s->scratch);
+            s->scratch_cap=0;
+            if (!(s->scratch=(char*)s->ctx->malloc_fn(cap))) return 0;
+            s->scratch_cap=cap;
+        }
+        len=(size_t)(decode_string(ptr,end,s->scratch)-s->scratch);
+        s->scratch[len]=0;
+        ptr=s->scratch;
+    }
+    if (is_key) ok=s->h->key?s->h->key(s->user,ptr,len):1;
+    else ok=s->h->string?s->h->string(s->user,ptr,len):1;
+    if (!ok) {
+        s->ctx->error=str;	/* صҪֹͣ */
+        return 0;
+    }
+    return end+1;
+}
+
+//һûвĻص, fnΪ0ʱΪɹ
+#define SAX_EVENT(s,fn,at) ((s)->h->fn && !(s)->h->fn((s)->user)?((s)->ctx->error=(at),0):1)
+
+static const char *sax_array(sax_state *s,const char *value,int depth)
+{
+    const char *start=value;
+    if (!SAX_EVENT(s,start_array,start)) return 0;
+    value=skip(value+1,s->end);
+    if (value>=s->end || *value!=']') {
+        value=skip(sax_value(s,value,depth),s->end);
+        while (value && value<s->end && *value==',') value=skip(sax_value(s,skip(value+1,s->end),depth),s->end);
+        if (!value) return 0;
+        if (value>=s->end || *value!=']') {
+            s->ctx->error=value;
+            return 0;
+        }
+    }
+    if (!SAX_EVENT(s,end_array,value)) return 0;
+    return value+1;
+}
+
+static const char *sax_object(sax_state *s,const char *value,int depth)
+{
+    if (!SAX_EVENT(s,start_object,value)) return 0;
+    value=skip(value+1,s->end);
+    if (value>=s->end || *value!='}') {
+        for (;;) {
+            value=skip(sax_string(s,value,1),s->end);
+            if (!value) return 0;
+            if (value>=s->end || *value!=':') {
+                s->ctx->error=value;
+                return 0;
             }
+            value=skip(sax_value(s,skip(value+1,s->end),depth),s->end);
+            if (!value) return 0;
+            if (value>=s->end || *value!=',') break;
+            value=skip(value+1,s->end);
+        }
+        if (value>=s->end || *value!='}') {
+            s->ctx->error=value;
+            return 0;
+        }
+    }
+    if (!SAX_EVENT(s,end_object,value)) return 0;
+    return value+1;
+}
+
+static const char *sax_value(sax_state *s,const char *value,int depth)
+{
+    int ok=1;
+    if (!value) return 0;
+    if (value>=s->end) {
+        s->ctx->error=value;
+        return 0;
+    }
+    if (s->end-value>=4 && !strncmp(value,"null",4)) {
+        ok=SAX_EVENT(s,null_value,value);
+        value+=4;
+    }
+    else if ((s->end-value>=5 && !strncmp(value,"false",5)) || (s->end-value>=4 && !strncmp(value,"true",4))) {
+        int b=(*value=='t');
+        if (s->h->boolean && !s->h->boolean(s->user,b)) s->ctx->error=value,ok=0;
+        value+=b?4:5;
+    }
+    else if (*value=='\"') return sax_string(s,value,0);
+    else if (*value=='-' || (*value>='0' && *value<='9')) {
+        cJSON num;	//parse_numberֵֶֻ,Ҫڵ
+        const char *start=value;
+        int exact;
+        value=parse_number_exact(&num,value,s->end,&exact);
+        if (exact && s->h->integer) {
+            if (!s->h->integer(s->user,num.valueint64)) s->ctx->error=start,ok=0;
+        }
+        else if (s->h->number && !s->h->number(s->user,num.valuedouble,num.valueint64)) s->ctx->error=start,ok=0;
+    }
+    else if (*value=='[' || *value=='{') {
+        if (s->ctx->max_depth>0 && depth>=s->ctx->max_depth) {
+            s->ctx->error=value;	/* Ƕ׹ */
+            return 0;
+        }
+        return *value=='['?sax_array(s,value,depth+1):sax_object(s,value,depth+1);
+    }
+    else {
+        s->ctx->error=value;
+        return 0;	/* ʧ. */
+    }
+    return ok?value:0;
+}
+
+/* ¼ʽ[value,end). ctxΪ0ʱʹĬϵķ亯Ƕײ,λÿcJSON_GetErrorPtr()ȡ
+   :ɹ1,ʧܻصҪֹͣ0 */
+static int parse_sax(cJSON_Context *ctx,const char *value,const char *end,const cJSON_SaxHandler *h,void *user,const char **return_parse_end)
+{
+    sax_state s;
+    const char *ptr;
+    int use_default=!ctx;
+    if (!value || !h) return 0;
+    if (use_default) ctx=&default_ctx;
+    ctx->error=0;
+    s.ctx=ctx,s.h=h,s.user=user,s.scratch=0,s.scratch_cap=0,s.end=end;
+    ptr=sax_value(&s,skip(value,end),0);
+    if (s.scratch) ctx->free_fn(s.scratch);
+    if (!ptr) return 0;
+    if (!use_default && (ctx->options&cJSON_OptRequireNullTerminated)) {
+        ptr=skip(ptr,end);
+        if (ptr<end && *ptr) {
+            ctx->error=ptr;
+            return 0;
+        }
+    }
+    if (return_parse_end) *return_parse_end=ptr;
+    return 1;
+}
+int cJSON_ParseSax(cJSON_Context *ctx,const char *value,const cJSON_SaxHandler *h,void *user,const char **return_parse_end)
+{
+    return parse_sax(ctx,value,text_end(value),h,user,return_parse_end);
+}
+//ͬcJSON_ParseSax, Ϊ[value,value+length), Ҫ'\0'β
+int cJSON_ParseSaxWithLength(cJSON_Context *ctx,const char *value,size_t length,const cJSON_SaxHandler *h,void *user,const char **return_parse_end)
+{
+    return parse_sax(ctx,value,value?value+length:0,h,user,return_parse_end);
+}
+
+/* ձʾ(cJSON_Compact): ĵһ16ֽڽڵһַ, ڵ֮32λ±ָ.
+   ڵ㰴: ĵһӽڵ, ¼ӽڵ֮±,
+   һֵO(1). һ8ֽڵdouble, 7ֽڵֱַӴڽڵ,
+   ַͼڳ. ĵ¼ֱ, cJSON */
+#define COMPACT_TYPE 0x0F		//cJSON_False..cJSON_Object
+#define COMPACT_LAST 0x10		//һӽڵ
+#define COMPACT_INT 0x20		//v.i,Ϊv.d
+#define COMPACT_INLINE 0x40		//ַv.inl
+#define COMPACT_NOKEY 0xFFFFFFFFu
+#define COMPACT_INLINE_MAX 7
+
+typedef struct {
+    unsigned tag;		//ͺCOMPACT_*־
+    unsigned key;		//ڳеƫ, ǶԪʱΪCOMPACT_NOKEY
+    union {
+        double d;
+        long long i;
+        char inl[8];						//ַ,'\0'β
+        struct {unsigned off,len;} s;		//еַ
+        struct {unsigned count,end;} c;		//: ӽڵ, ֮±
+    } v;
+} compact_node;
+
+struct cJSON_Compact {
+    compact_node *nodes;
+    unsigned n,cap;
+    char *pool;
+    size_t pool_len,pool_cap;
+    void (*free_fn)(void *ptr);
+};
+
+typedef struct {
+    unsigned node;		//ɵ
+    unsigned last;		//Ŀǰһӽڵ, ûʱΪ0
+} compact_frame;
+
+//ĵʱ״̬, Ϊ¼user
+typedef struct {
+    cJSON_Context *ctx;
+    cJSON_Compact *doc;
+    compact_frame *stack;
+    size_t depth,stack_cap;
+    unsigned key;		//ļ,һֵ
+} compact_builder;
+
+//ƵĻ: contextֻmalloc/free
+static void *compact_grow(cJSON_Context *ctx,void *old,size_t used,size_t need,size_t *cap,size_t elem)
+{
+    size_t c=*cap?*cap:16;
+    void *p;
+    while (c<need) c*=2;
+    if (!(p=ctx->malloc_fn(c*elem))) return 0;
+    if (old) {
+        memcpy(p,old,used*elem);
+        ctx->free_fn(old);
+    }
+    *cap=c;
+    return p;
+}
+
+static unsigned compact_pool_add(compact_builder *b,const char *str,size_t len)
+{
+    cJSON_Compact *d=b->doc;
+    size_t off=d->pool_len;
+    if (off+len+1>0xFFFFFFFFu) return COMPACT_NOKEY;	//ֻ32λƫѰַ
+    if (off+len+1>d->pool_cap) {
+        char *p=(char*)compact_grow(b->ctx,d->pool,d->pool_len,off+len+1,&d->pool_cap,1);
+        if (!p) return COMPACT_NOKEY;
+        d->pool=p;
+    }
+    memcpy(d->pool+off,str,len);
+    d->pool[off+len]=0;
+    d->pool_len+=len+1;
+    return (unsigned)off;
+}
+
+//׷һڵ㲢ӵǰ. ؽڵ, ʧܷ0
+static compact_node *compact_add(compact_builder *b,int type)
+{
+    cJSON_Compact *d=b->doc;
+    compact_node *node;
+    if (d->n==0xFFFFFFFFu) return 0;
+    if (d->n==d->cap) {
+        size_t cap=d->cap;
+        compact_node *p=(compact_node*)compact_grow(b->ctx,d->nodes,d->n,(size_t)d->n+1,&cap,sizeof(compact_node));
+        if (!p || cap>0xFFFFFFFFu) {if (p) b->ctx->free_fn(p); return 0;}
+        d->nodes=p,d->cap=(unsigned)cap;
+    }
+    if (b->depth) {
+        d->nodes[b->stack[b->depth-1].node].v.c.count++;
+        b->stack[b->depth-1].last=d->n;
+    }
+    node=&d->nodes[d->n++];
+    node->tag=(unsigned)type;
+    node->key=b->key;
+    b->key=COMPACT_NOKEY;
+    return node;
+}
+
+static int compact_null(void *user) {return compact_add((compact_builder*)user,cJSON_NULL)!=0;}
+static int compact_bool(void *user,int value) {return compact_add((compact_builder*)user,value?cJSON_True:cJSON_False)!=0;}
+static int compact_number(void *user,double value,long long value64)
+{
+    compact_node *node=compact_add((compact_builder*)user,cJSON_Number);
+    if (!node) return 0;
+    if ((double)value64==value && (value!=0 || !signbit(value))) node->tag|=COMPACT_INT,node->v.i=value64;	//(-0)ȷ
+    else node->v.d=value;
+    return 1;
+}
+static int compact_string(void *user,const char *str,size_t len)
+{
+    compact_builder *b=(compact_builder*)user;
+    compact_node *node=compact_add(b,cJSON_String);
+    unsigned off;
+    if (!node) return 0;
+    if (len<=COMPACT_INLINE_MAX) {
+        node->tag|=COMPACT_INLINE;
+        memcpy(node->v.inl,str,len);
+        node->v.inl[len]=0;
+        return 1;
+    }
+    if ((off=compact_pool_add(b,str,len))==COMPACT_NOKEY) return 0;
+    node->v.s.off=off;
+    node->v.s.len=(unsigned)len;
+    return 1;
+}
+static int compact_key(void *user,const char *str,size_t len)
+{
+    compact_builder *b=(compact_builder*)user;
+    return (b->key=compact_pool_add(b,str,len))!=COMPACT_NOKEY;
+}
+static int compact_open(compact_builder *b,int type)
+{
+    compact_node *node=compact_add(b,type);
+    if (!node) return 0;
+    node->v.c.count=0;
+    if (b->depth==b->stack_cap) {
+        compact_frame *st=(compact_frame*)compact_grow(b->ctx,b->stack,b->depth,b->depth+1,&b->stack_cap,sizeof(compact_frame));
+        if (!st) return 0;
+        b->stack=st;
+    }
+    b->stack[b->depth].node=b->doc->n-1;
+    b->stack[b->depth++].last=0;
+    return 1;
+}
+static int compact_close(void *user)
+{
+    compact_builder *b=(compact_builder*)user;
+    cJSON_Compact *d=b->doc;
+    compact_frame *f=&b->stack[--b->depth];
+    d->nodes[f->node].v.c.end=d->n;
+    if (f->last) d->nodes[f->last].tag|=COMPACT_LAST;
+    return 1;
+}
+static int compact_start_object(void *user) {return compact_open((compact_builder*)user,cJSON_Object);}
+static int compact_start_array(void *user) {return compact_open((compact_builder*)user,cJSON_Array);}
+
+/* [value,value+length)ɽĵ. ctxΪ0. ʧܷ0, λüctx->error(cJSON_GetErrorPtr()) */
+cJSON_Compact *cJSON_CompactParse(cJSON_Context *ctx,const char *value,size_t length)
+{
+    static const cJSON_SaxHandler h={compact_null,compact_bool,compact_number,compact_string,compact_key,
+        compact_start_object,compact_close,compact_start_array,compact_close};
+    compact_builder b;
+    cJSON_Compact *doc;
+    int ok;
+    if (!value) return 0;
+    memset(&b,0,sizeof(b));
+    b.ctx=ctx?ctx:&default_ctx;
+    b.key=COMPACT_NOKEY;
+    if (!(doc=(cJSON_Compact*)b.ctx->malloc_fn(sizeof(cJSON_Compact)))) return 0;
+    memset(doc,0,sizeof(cJSON_Compact));
+    doc->free_fn=b.ctx->free_fn;
+    b.doc=doc;
+    ok=cJSON_ParseSaxWithLength(ctx,value,length,&h,&b,0);
+    if (b.stack) b.ctx->free_fn(b.stack);
+    if (!ok) {
+        cJSON_CompactDelete(doc);
+        return 0;
+    }
+    return doc;
+}
+
+void cJSON_CompactDelete(cJSON_Compact *doc)
+{
+    if (!doc) return;
+    if (doc->nodes) doc->free_fn(doc->nodes);
+    if (doc->pool) doc->free_fn(doc->pool);
+    doc->free_fn(doc);
+}
+
+size_t cJSON_CompactMemory(const cJSON_Compact *doc)
+{
+    return doc?sizeof(cJSON_Compact)+doc->cap*sizeof(compact_node)+doc->pool_cap:0;
+}
+
+#define COMPACT_NODE(doc,i) ((doc)->nodes+(i))
+#define COMPACT_VALID(doc,i) ((doc) && (i)<(doc)->n)
+
+int cJSON_CompactType(const cJSON_Compact *doc,cJSON_Node node)
+{
+    return COMPACT_VALID(doc,node)?(int)(COMPACT_NODE(doc,node)->tag&COMPACT_TYPE):-1;
+}
+
+int cJSON_CompactSize(const cJSON_Compact *doc,cJSON_Node node)
+{
+    int type=cJSON_CompactType(doc,node);
+    return (type==cJSON_Array || type==cJSON_Object)?(int)COMPACT_NODE(doc,node)->v.c.count:0;
+}
+
+cJSON_Node cJSON_CompactChild(const cJSON_Compact *doc,cJSON_Node node)
+{
+    return cJSON_CompactSize(doc,node)?node+1:0;
+}
+
+cJSON_Node cJSON_CompactNext(const cJSON_Compact *doc,cJSON_Node node)
+{
+    const compact_node *n;
+    int type;
+    if (!node || !COMPACT_VALID(doc,node)) return 0;	//ûֵ
+    n=COMPACT_NODE(doc,node);
+    if (n->tag&COMPACT_LAST) return 0;
+    type=(int)(n->tag&COMPACT_TYPE);
+    return (type==cJSON_Array || type==cJSON_Object)?n->v.c.end:node+1;
+}
+
+cJSON_Node cJSON_CompactGetArrayItem(const cJSON_Compact *doc,cJSON_Node array,int index)
+{
+    cJSON_Node c=cJSON_CompactChild(doc,array);
+    if (index<0) return 0;
+    while (c && index--) c=cJSON_CompactNext(doc,c);
+    return c;
+}
+
+cJSON_Node cJSON_CompactGetObjectItem(const cJSON_Compact *doc,cJSON_Node object,const char *string)
+{
+    cJSON_Node c=cJSON_CompactType(doc,object)==cJSON_Object?cJSON_CompactChild(doc,object):0;
+    for (; c; c=cJSON_CompactNext(doc,c)) if (!cJSON_strcasecmp(doc->pool+COMPACT_NODE(doc,c)->key,string)) return c;
+    return 0;
+}
+
+const char *cJSON_CompactKey(const cJSON_Compact *doc,cJSON_Node node)
+{
+    unsigned key=COMPACT_VALID(doc,node)?COMPACT_NODE(doc,node)->key:COMPACT_NOKEY;
+    return key==COMPACT_NOKEY?0:doc->pool+key;
+}
+
+const char *cJSON_CompactString(const cJSON_Compact *doc,cJSON_Node node,size_t *len)
+{
+    const compact_node *n;
+    if (cJSON_CompactType(doc,node)!=cJSON_String) return 0;
+    n=COMPACT_NODE(doc,node);
+    if (n->tag&COMPACT_INLINE) {
+        if (len) *len=strlen(n->v.inl);
+        return n->v.inl;
+    }
+    if (len) *len=n->v.s.len;
+    return doc->pool+n->v.s.off;
+}
+
+double cJSON_CompactNumber(const cJSON_Compact *doc,cJSON_Node node)
+{
+    const compact_node *n;
+    if (cJSON_CompactType(doc,node)!=cJSON_Number) return 0;
+    n=COMPACT_NODE(doc,node);
+    return (n->tag&COMPACT_INT)?(double)n->v.i:n->v.d;
+}
+
+long long cJSON_CompactInt64(const cJSON_Compact *doc,cJSON_Node node)
+{
+    const compact_node *n;
+    if (cJSON_CompactType(doc,node)!=cJSON_Number) return 0;
+    n=COMPACT_NODE(doc,node);
+    return (n->tag&COMPACT_INT)?n->v.i:double_to_int64(n->v.d);
+}
+
+/* nodeתͨcJSON(Ĭϵķ亯), cJSON_Deleteͷ */
+cJSON *cJSON_CompactToTree(const cJSON_Compact *doc,cJSON_Node node)
+{
+    const compact_node *n;
+    cJSON *item=0,*child,*prev=0;
+    cJSON_Node c;
+    switch (cJSON_CompactType(doc,node)) {
+        case cJSON_NULL:	return cJSON_CreateNull();
+        case cJSON_False:	return cJSON_CreateFalse();
+        case cJSON_True:	return cJSON_CreateTrue();
+        case cJSON_String:	return cJSON_CreateString(cJSON_CompactString(doc,node,0));
+        case cJSON_Number:
+            n=COMPACT_NODE(doc,node);
+            return (n->tag&COMPACT_INT)?cJSON_CreateInt64(n->v.i):cJSON_CreateNumber(n->v.d);
+        case cJSON_Array:	item=cJSON_CreateArray(); break;
+        case cJSON_Object:	item=cJSON_CreateObject(); break;
+        default:			return 0;
+    }
+    if (!item) return 0;
+    for (c=cJSON_CompactChild(doc,node); c; c=cJSON_CompactNext(doc,c)) {	//ֱӽڵ, ׷
+        if (!(child=cJSON_CompactToTree(doc,c))) {
+            cJSON_Delete(item);
+            return 0;
+        }
+        if (item->type==cJSON_Object && !(child->string=pool_strdup(cJSON_CompactKey(doc,c),child,cJSON_StringIsPooled))) {
+            cJSON_Delete(child);
+            cJSON_Delete(item);
+            return 0;
+        }
+        if (prev) prev->next=child,child->prev=prev;
+        else item->child=child;
+        prev=child;
+        item->child->prev=prev;
+    }
+    return item;
+}
+
+/* (ʽ). ݿԷֳСĿνcJSON_ParserFeed,
+   ַ//ۻtok,ٽparse_string/parse_number. 
+   Ƕ׵/ʽջ¼, Ҫ´ͷ */
+enum {
+    PS_VALUE,			//ȴһֵ
+    PS_ARRAY_FIRST,		//ն'[': ȴһֵ']'
+    PS_OBJECT_FIRST,	//ն'{': ȴһ'}'
+    PS_KEY,				//',': ȴһ
+    PS_COLON,			//: ȴ':'
+    PS_AFTER,			//һֵ: ȴ','
+    PS_DONE,			//ѽ,ֻհ
+    PS_ERROR
+};
+
+typedef struct {
+    cJSON *node;	//ڽ
+    cJSON *last;	//ĿǰһԪ
+    int n;			//Ԫظ
+} parser_frame;
+
+struct cJSON_Parser {
+    cJSON_Context ctx;
+    cJSON *root;
+    parser_frame *stack;
+    int depth,stack_cap;
+    int state;
+    cJSON *item;		//Ԫ(ѶԪ)
+    char *tok;			//token
+    int toklen,tokcap;
+    int tokkind;		//0:ûδɵtoken '"':ַ ':': '0': 'a':
+    int escape;			//ַtokenһַδԵ'\\'
+    size_t tokstart;	//tokenеʼƫ
+    const char *chunk;	//ǰʼַ
+    size_t offset;		//֮ǰĿֽ
+    size_t error;		//λеƫ
+};
+
+cJSON_Parser *cJSON_ParserCreate(cJSON_Context *ctx)
+{
+    cJSON_Parser *ps;
+    cJSON_Context c;
+    if (ctx) c=*ctx;
+    else cJSON_InitContext(&c);
+    c.options&=~CJSON_OPT_INSITU;	//鲻ڽ,ԭؽ
+    ps=(cJSON_Parser*)c.malloc_fn(sizeof(cJSON_Parser));
+    if (!ps) return 0;
+    memset(ps,0,sizeof(cJSON_Parser));
+    ps->ctx=c;
+    ps->state=PS_VALUE;
+    return ps;
+}
+
+void cJSON_ParserDelete(cJSON_Parser *ps)
+{
+    if (!ps) return;
+    if (ps->root && !ps->ctx.arena) cJSON_DeleteCtx(&ps->ctx,ps->root);	//δɵ
+    if (ps->stack) ps->ctx.free_fn(ps->stack);
+    if (ps->tok) ps->ctx.free_fn(ps->tok);
+    ps->ctx.free_fn(ps);
+}
+
+size_t cJSON_ParserErrorOffset(cJSON_Parser *ps)
+{
+    return ps?ps->error:0;
+}
+
+static int parser_fail(cJSON_Parser *ps,size_t at)
+{
+    ps->state=PS_ERROR;
+    ps->error=at;
+    return 0;
+}
+
+//tok׷lenֽ,'\0'β
+static int parser_tok_append(cJSON_Parser *ps,const char *s,int len)
+{
+    if (ps->toklen+len+1>ps->tokcap) {
+        int cap=pow2gt(ps->toklen+len+1);
+        char *t=(char*)ps->ctx.malloc_fn(cap);
+        if (!t) return 0;
+        if (ps->tok) {
+            memcpy(t,ps->tok,ps->toklen);
+            ps->ctx.free_fn(ps->tok);
         }
+        ps->tok=t,ps->tokcap=cap;
     }
-    *ptr2++='\"';
-    *ptr2++=0;
-    return out;
+    memcpy(ps->tok+ps->toklen,s,len);
+    ps->toklen+=len;
+    ps->tok[ps->toklen]=0;
+    return 1;
 }
-/* Invote print_string_ptr (which is useful) on an item. */
-static char *print_string(cJSON *item,printbuffer *p)
+
+//ΪһֵԪ: , Ԫ, ߶ѾԪ
+static cJSON *parser_new_value(cJSON_Parser *ps)
 {
-    return print_string_ptr(item->valuestring,p);
+    cJSON *item;
+    parser_frame *f;
+    if (!ps->depth) return ps->root=parse_New_Item(&ps->ctx);
+    f=&ps->stack[ps->depth-1];
+    if ((f->node->type&255)==cJSON_Object) return ps->item;
+    if (!(item=parse_New_Item(&ps->ctx))) return 0;
+    if (f->last) f->last->next=item,item->prev=f->last;
+    else f->node->child=item;
+    f->last=item;
+    f->n++;
+    return item;
 }
 
-/* Predeclare these prototypes. */
-static const char *parse_value(cJSON *item,const char *value);
-static char *print_value(cJSON *item,int depth,int fmt,printbuffer *p);
-static const char *parse_array(cJSON *item,const char *value);
-static char *print_array(cJSON *item,int depth,int fmt,printbuffer *p);
-static const char *parse_object(cJSON *item,const char *value);
-static char *print_object(cJSON *item,int depth,int fmt,printbuffer *p);
-
-
-
+//һֵ
+static void parser_value_done(cJSON_Parser *ps,cJSON *item)
+{
+    if (ps->ctx.arena) item->type|=cJSON_IsArena|cJSON_StringIsConst|cJSON_ValueIsConst;
+    if (ps->ctx.keys && item->string) item->type|=cJSON_StringIsConst|cJSON_StringIsInterned;
+    ps->state=ps->depth?PS_AFTER:PS_DONE;
+}
 
-/* :ɴӡַ */
-static const char *skip(const char *in)
+//token('\0'β)תΪֵ. at:tokenеƫ
+static int parser_token(cJSON_Parser *ps,const char *tok,int len,int kind,size_t at)
 {
-    while (in && *in && (unsigned char)*in<=32) in++;
-    return in;
+    cJSON *item;
+    const char *end;
+    if (kind==':') {	//ļ: Ԫؽӵĩβ
+        parser_frame *f=&ps->stack[ps->depth-1];
+        if (!(item=parse_New_Item(&ps->ctx))) return parser_fail(ps,at);
+        if (f->last) f->last->next=item,item->prev=f->last;
+        else f->node->child=item;
+        f->last=item;
+        f->n++;
+        if (!parse_key(&ps->ctx,item,tok,tok+len)) return parser_fail(ps,at);
+        ps->item=item;
+        ps->state=PS_COLON;
+        return 1;
+    }
+    if (!(item=parser_new_value(ps))) return parser_fail(ps,at);
+    if (kind=='\"') end=parse_string(&ps->ctx,item,tok,tok+len);
+    else if (kind=='0') end=parse_number(item,tok,tok+len);
+    else if (len==4 && !strncmp(tok,"null",4)) item->type=cJSON_NULL,end=tok+4;
+    else if (len==5 && !strncmp(tok,"false",5)) item->type=cJSON_False,end=tok+5;
+    else if (len==4 && !strncmp(tok,"true",4)) item->type=cJSON_True,item->valueint=1,end=tok+4;
+    else end=0;
+    if (!end) return parser_fail(ps,at);
+    if (end!=tok+len) return parser_fail(ps,at+(end-tok));	//"1-2"
+    parser_value_done(ps,item);
+    return 1;
 }
 
-/* ,һµĸ.
-:value:ҪлΪCJSONַ
- return_parse_end:[out]ɸcJSONʱ,JSONַĽλ(ָ),ΪNULLʾ
-       require_null_terminated:JSONַǷҪ'\0'
-  ֵ:ɹ:һcJSONָ
-   ʧ:NULL,λÿcJSON_GetErrorPtr()ȡ
-  ע:ʹøúͨmallocڴпһռ䣬ʹҪֶͷ(ͨcJSON_Delete)
- */
-cJSON *cJSON_ParseWithOpts(const char *value,const char **return_parse_end,int require_null_terminated)
+static int is_number_char(char c)
 {
-    const char *end=0;
-    cJSON *c=cJSON_New_Item();
-    ep=0;
-    if (!c) return 0;       /* memory fail */
+    return (c>='0' && c<='9') || c=='-' || c=='+' || c=='.' || c=='e' || c=='E';
+}
 
-    end=parse_value(c,skip(value));//ĺ
-    if (!end)	{
-        cJSON_Delete(c);    /* ʧʱepָ뽫. */
+/* [p,end)ѰҴpʼtokenĽλ(ַΪպϵ֮). escape:ַһʱ
+   һַǷΪ'\\'. ûнʱ0,'\0'ʱ(const char*)-1 */
+static const char *parser_token_end(const char *p,const char *end,int kind,int *escape)
+{
+    if (kind=='\"' || kind==':') {
+        for (; p<end; p++) {
+            if (!*p) return (const char*)-1;
+            if (*escape) *escape=0;
+            else if (*p=='\\') *escape=1;
+            else if (*p=='\"') return p+1;
+        }
         return 0;
     }
+    if (kind=='0') while (p<end && is_number_char(*p)) p++;
+    else while (p<end && *p>='a' && *p<='z') p++;
+    return p<end?p:0;
+}
 
-    /*JSONҪnullβʱм*/
-    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
-    if (require_null_terminated) {
-        end=skip(end);
-        if (*end) {
-            cJSON_Delete(c);
-            ep=end;
-            return 0;
-        }
+#define PARSER_POS(ps,ptr) ((ps)->offset+(size_t)((ptr)-(ps)->chunk))	//ptrеƫ
+
+//ʼp(һp)token. token֮λ, еݲʱend, ʧܷ0
+static const char *parser_feed_token(cJSON_Parser *ps,const char *p,const char *end)
+{
+    const char *start=p,*stop;
+    int ok;
+    if (!ps->toklen && (ps->tokkind=='\"' || ps->tokkind==':')) p++;	//ͷ
+    stop=parser_token_end(p,end,ps->tokkind,&ps->escape);
+    if (stop==(const char*)-1) {parser_fail(ps,ps->tokstart); return 0;}
+    if (!stop) {	//tokenһûн: ȴһ
+        if (!parser_tok_append(ps,start,(int)(end-start))) {parser_fail(ps,ps->tokstart); return 0;}
+        return end;
     }
-    if (return_parse_end) *return_parse_end=end;
-    return c;
+    if (ps->toklen) {
+        if (!parser_tok_append(ps,start,(int)(stop-start))) {parser_fail(ps,ps->tokstart); return 0;}
+        ok=parser_token(ps,ps->tok,ps->toklen,ps->tokkind,ps->tokstart);
+        ps->toklen=0;
+    }
+    else ok=parser_token(ps,start,(int)(stop-start),ps->tokkind,ps->tokstart);	//tokenһ: ֱڿ,stopΪ߽
+    ps->tokkind=0;
+    return ok?stop:0;
 }
 
+//ʼһµ/
+static int parser_push(cJSON_Parser *ps,cJSON *node)
+{
+    if (ps->depth==ps->stack_cap) {
+        int cap=ps->stack_cap?ps->stack_cap*2:16;
+        parser_frame *st=(parser_frame*)ps->ctx.malloc_fn(cap*sizeof(parser_frame));
+        if (!st) return 0;
+        if (ps->stack) {
+            memcpy(st,ps->stack,ps->depth*sizeof(parser_frame));
+            ps->ctx.free_fn(ps->stack);
+        }
+        ps->stack=st,ps->stack_cap=cap;
+    }
+    ps->stack[ps->depth].node=node;
+    ps->stack[ps->depth].last=0;
+    ps->stack[ps->depth].n=0;
+    ps->depth++;
+    return 1;
+}
 
+//']''}': ǰ/
+static void parser_pop(cJSON_Parser *ps)
+{
+    parser_frame *f=&ps->stack[--ps->depth];
+    if ((f->node->type&255)==cJSON_Array) close_array(&ps->ctx,f->node,f->last,f->n);
+    else close_object(&ps->ctx,f->node,f->last,f->n);
+    parser_value_done(ps,f->node);
+}
 
+//pʼһµtoken
+static const char *parser_begin_token(cJSON_Parser *ps,const char *p,const char *end,int kind)
+{
+    ps->tokkind=kind;
+    ps->tokstart=PARSER_POS(ps,p);
+    ps->escape=0;
+    return parser_feed_token(ps,p,end);
+}
 
+/* һ. :ɹ1, дڴ治㣭0(λücJSON_ParserErrorOffset) */
+int cJSON_ParserFeed(cJSON_Parser *ps,const char *buf,size_t len)
+{
+    const char *p=buf,*end=buf+len;
+    if (!ps || ps->state==PS_ERROR) return 0;
+    if (!buf) return len?0:1;
+    ps->chunk=buf;
+    if (ps->tokkind && !(p=parser_feed_token(ps,p,end))) return 0;	//һδɵtoken
+    while (p<end) {
+        char c=*p;
+        int array;
+        if ((unsigned char)c<=32 && c) {p++; continue;}	//հ
+        switch (ps->state) {
+            case PS_VALUE:
+            case PS_ARRAY_FIRST:
+                if (c==']' && ps->state==PS_ARRAY_FIRST) {parser_pop(ps); p++; break;}	//
+                if (c=='[' || c=='{') {
+                    cJSON *item;
+                    if (ps->ctx.max_depth>0 && ps->depth>=ps->ctx.max_depth) return parser_fail(ps,PARSER_POS(ps,p));	/* Ƕ׹ */
+                    if (!(item=parser_new_value(ps)) || !parser_push(ps,item)) return parser_fail(ps,PARSER_POS(ps,p));
+                    item->type=(c=='[')?cJSON_Array:cJSON_Object;
+                    ps->state=(c=='[')?PS_ARRAY_FIRST:PS_OBJECT_FIRST;
+                    p++;
+                    break;
+                }
+                if (c=='\"') p=parser_begin_token(ps,p,end,'\"');
+                else if (c=='-' || (c>='0' && c<='9')) p=parser_begin_token(ps,p,end,'0');
+                else if (c>='a' && c<='z') p=parser_begin_token(ps,p,end,'a');
+                else return parser_fail(ps,PARSER_POS(ps,p));
+                if (!p) return 0;
+                break;
+            case PS_OBJECT_FIRST:
+            case PS_KEY:
+                if (c=='}' && ps->state==PS_OBJECT_FIRST) {parser_pop(ps); p++; break;}	//ն
+                if (c!='\"') return parser_fail(ps,PARSER_POS(ps,p));
+                if (!(p=parser_begin_token(ps,p,end,':'))) return 0;
+                break;
+            case PS_COLON:
+                if (c!=':') return parser_fail(ps,PARSER_POS(ps,p));
+                ps->state=PS_VALUE;
+                p++;
+                break;
+            case PS_AFTER:
+                array=(ps->stack[ps->depth-1].node->type&255)==cJSON_Array;
+                if (c==',') ps->state=array?PS_VALUE:PS_KEY;
+                else if (c==(array?']':'}')) parser_pop(ps);
+                else return parser_fail(ps,PARSER_POS(ps,p));
+                p++;
+                break;
+            default:	//PS_DONE: ֻ֮пհ
+                return parser_fail(ps,PARSER_POS(ps,p));
+        }
+    }
+    ps->offset+=len;
+    return 1;
+}
 
-
-/*JSONݰ,cJSONṹĽṹлݰ
-:value:ҪлΪCJSON
-  ֵ:ɹ:һcJSONָ
-   ʧ:NULL,λÿcJSON_GetErrorPtr()ȡ
-  ע:ʹøúͨmallocڴпһռ䣬ʹҪֶͷ(ͨcJSON_Delete)
- */
-cJSON *cJSON_Parse(const char *value)
+/* . ؽ(֮ڵ,cJSON_DeleteCtxͷ), ĵдʱ0 */
+cJSON *cJSON_ParserFinish(cJSON_Parser *ps)
 {
-    return cJSON_ParseWithOpts(value,0,0);
+    cJSON *root;
+    if (!ps || ps->state==PS_ERROR) return 0;
+    if (ps->tokkind) {	//ĩβֻ(ĵ"123")
+        int ok=ps->tokkind!='\"' && ps->tokkind!=':' && parser_token(ps,ps->tok?ps->tok:"",ps->toklen,ps->tokkind,ps->tokstart);
+        ps->tokkind=0,ps->toklen=0;
+        if (!ok) return parser_fail(ps,ps->tokstart),(cJSON*)0;
+    }
+    if (ps->state!=PS_DONE) return parser_fail(ps,ps->offset),(cJSON*)0;	//ĵ
+    root=ps->root;
+    ps->root=0;
+    return root;
 }
 
 
+/* Render a cJSON item/entity/structure to text. */
+#define PRINT_DEFAULT_BUFFER 256	//cJSON_PrintȵĳʼС,ʱ2Nη
 
+/*ʹctxķ亯,itemһʼСΪprebufferĻ
+  : '\0'βı,ʧܷ0 */
+static char *print_root(cJSON_Context *ctx,cJSON *item,int prebuffer,int fmt)
+{
+    printbuffer p;
+    if (prebuffer<1) prebuffer=1;
+    p.buffer=(char*)ctx->malloc_fn(prebuffer);
+    if (!p.buffer) return 0;
+    p.length=prebuffer;
+    p.offset=0;
+    p.ctx=ctx;
+    p.write_fn=0;
+    p.user=0;
+    p.fixed=0;
+    if (!print_value(item,0,fmt,&p) || !ensure(&p,1)) {
+        if (p.buffer) ctx->free_fn(p.buffer);
+        return 0;
+    }
+    p.buffer[p.offset]=0;
+    return p.buffer;
+}
 
-/* Render a cJSON item/entity/structure to text. */
 /*cJSONתһɴӡcJSONַ
   :item: ṹcJSON
   : ıcJSON
 ע:ڲռ,ʹҪfree()ͷ*/
 char *cJSON_Print(cJSON *item)
 {
-    return print_value(item,0,1,0);
+    return print_root(&default_ctx,item,PRINT_DEFAULT_BUFFER,1);
 }
 char *cJSON_PrintUnformatted(cJSON *item)
 {
-    return print_value(item,0,0,0);
+    return print_root(&default_ctx,item,PRINT_DEFAULT_BUFFER,0);
+}
+/* ʹctxķ亯, fmt0ʾʽ */
+char *cJSON_PrintCtx(cJSON_Context *ctx,cJSON *item,int fmt)
+{
+    return print_root(ctx,item,PRINT_DEFAULT_BUFFER,fmt);
+}
+
+char *cJSON_PrintBuffered(cJSON *item,int prebuffer,int fmt)
+{
+    return print_root(&default_ctx,item,prebuffer,fmt);
 }
 
+/* print_valueľȷ('\0'),. print_valueͬķʽ,
+   ַֻɨ費,ָʽջϵʱ. ʧ(Чչʧ)ʱ0 */
+size_t cJSON_PrintedLength(cJSON *item,int fmt)
+{
+    walk_stack st;
+    walk_frame *f;
+    char num[NUMBER_PRINT_SIZE];
+    size_t len=0;
+    int depth=0,ok=0;
 
+    walk_init(&st,&default_ctx);
+    for (;;) {
+        if (!item) goto done;
+        switch ((item->type)&255) {
+            case cJSON_NULL:	len+=4; break;
+            case cJSON_False:	len+=5; break;
+            case cJSON_True:	len+=4; break;
+            case cJSON_Number:	len+=format_number(item,num); break;
+            case cJSON_String:	len+=string_printed_length(item->valuestring); break;
+            case cJSON_Array:
+                if (cJSON_GetPackedType(item)) {
+                    len+=packed_printed_length(item,fmt);
+                    break;
+                }
+                if (!cJSON_Expand(item)) goto done;
+                len+=2;	//"[]"
+                if (item->child) {
+                    if (!(f=walk_push(&st,item))) goto done;
+                    f->child=item->child;
+                    f->n=depth+1;
+                }
+                break;
+            case cJSON_Object:
+                if (!cJSON_Expand(item)) goto done;
+                len+=(fmt?2:1)+1;	//"{\n""}"
+                if (!item->child) {	//ն: "}"ǰdepth-1
+                    if (fmt && depth>1) len+=depth-1;
+                    break;
+                }
+                if (fmt) len+=depth;	//"}"ǰ
+                if (!(f=walk_push(&st,item))) goto done;
+                f->child=item->child;
+                f->n=depth+1;
+                break;
+            default: goto done;
+        }
+        /* һԪ, ǰķָ(Ͷļ) */
+        while (st.depth && !st.frames[st.depth-1].child) st.depth--;
+        if (!st.depth) break;
+        f=&st.frames[st.depth-1];
+        item=f->child;
+        f->child=item->next;
+        depth=f->n;
+        if ((f->node->type&255)==cJSON_Array) {
+            if (item->next) len+=fmt?2:1;	//", "
+        } else {
+            len+=string_printed_length(item->string)+(fmt?2:1);	//":\t"
+            if (item->next) len++;	//","
+            if (fmt) len+=depth+1;	//"\n"
+        }
+    }
+    ok=1;
+done:
+    walk_free(&st);
+    return ok?len:0;
+}
 
+/* itemߵĻbuf('\0'β),ڴ. lenΪbufĴС,ҪcJSON_PrintedLength(item,fmt)+1.
+   :ɹ1,岻ʧܣ0 */
+int cJSON_PrintPreallocated(cJSON *item,char *buf,int len,int fmt)
+{
+    printbuffer p;
+    if (!buf || len<=0) return 0;
+    p.buffer=buf;
+    p.length=len;
+    p.offset=0;
+    p.ctx=&default_ctx;	//ֻںıջ
+    p.write_fn=0;
+    p.user=0;
+    p.fixed=1;
+    if (!print_value(item,0,fmt,&p) || !ensure(&p,1)) return 0;
+    buf[p.offset]=0;
+    return 1;
+}
 
-char *cJSON_PrintBuffered(cJSON *item,int prebuffer,int fmt)
+/* ʽ: һchunk_sizeСĻitem,ÿдͽwrite_fn,дʣĲ.
+   :ɹ1,ʧܣ0 */
+int cJSON_PrintToWriter(cJSON *item,int fmt,cJSON_WriteFn write_fn,void *user,int chunk_size)
 {
     printbuffer p;
-    p.buffer=(char*)cJSON_malloc(prebuffer);
-    p.length=prebuffer;
+    int ok;
+    if (!write_fn) return 0;
+    if (chunk_size<=0) chunk_size=4096;
+    if (chunk_size<NUMBER_PRINT_SIZE) chunk_size=NUMBER_PRINT_SIZE;	//ҪһдNUMBER_PRINT_SIZEֽ
+    p.buffer=(char*)cJSON_malloc(chunk_size);
+    if (!p.buffer) return 0;
+    p.length=chunk_size;
     p.offset=0;
-    return print_value(item,0,fmt,&p);
-    return p.buffer;
+    p.ctx=&default_ctx;
+    p.write_fn=write_fn;
+    p.user=user;
+    p.fixed=0;
+    ok=print_value(item,0,fmt,&p);
+    if (ok && p.offset) ok=write_fn(user,p.buffer,p.offset)!=0;
+    if (p.buffer) cJSON_free(p.buffer);	//ʧʱensureѾͷbuffer
+    return ok;
 }
 
+static int write_file(void *f,const char *data,int len)
+{
+    return fwrite(data,1,len,(FILE*)f)==(size_t)len;
+}
+int cJSON_PrintToFile(cJSON *item,int fmt,FILE *f)
+{
+    return f?cJSON_PrintToWriter(item,fmt,write_file,f,0):0;
+}
 
 
 
-/* ĺġı,ʵĹ̴.  --еķ֧ʹ˼ӵݹ */
-static const char *parse_value(cJSON *item,const char *value)
+
+/* һ/ֵ */
+static const char *parse_scalar(cJSON_Context *ctx,cJSON *item,const char *value,const char *end)
 {
     if (!value)						return 0;	/* Fail on null. */
-    if (!strncmp(value,"null",4))	{
+    if (value>=end) {
+        ctx->error=value;	/* ı */
+        return 0;
+    }
+    if (end-value>=4 && !strncmp(value,"null",4))	{
         item->type=cJSON_NULL;
         return value+4;
     }
-    if (!strncmp(value,"false",5))	{
+    if (end-value>=5 && !strncmp(value,"false",5))	{
         item->type=cJSON_False;
         return value+5;
     }
-    if (!strncmp(value,"true",4))	{
+    if (end-value>=4 && !strncmp(value,"true",4))	{
         item->type=cJSON_True;
         item->valueint=1;
         return value+4;
     }
     if (*value=='\"')				{
-        return parse_string(item,value);
+        return parse_string(ctx,item,value,end);
     }
     if (*value=='-' || (*value>='0' && *value<='9'))	{
-        return parse_number(item,value);
+        return parse_number(item,value,end);
+    }
+
+    ctx->error=value;
+    return 0;	/* ʧ. */
+}
+
+/* ĺġı,ʵĹ̴.
+   /ʹõݹ: 򿪵ѹʽջ,ÿֵصջ',',
+   붼ľջ; ctx->max_depthȻǶײ,ʱ'['/'{'.
+   : item:ҪĽڵ value:ı end:ıβ depth:itemڵǶײ
+   :ɺ,һҪλ.ʧܷ0 */
+static const char *parse_value(cJSON_Context *ctx,cJSON *item,const char *value,const char *end,int depth)
+{
+    walk_stack st;
+    walk_frame *f;
+    cJSON *child;
+    const char *packed;
+    int obj;
+
+    walk_init(&st,ctx);
+next_value:
+    if (value && value<end && (*value=='[' || *value=='{')) {
+        if (ctx->max_depth>0 && depth+st.depth>=ctx->max_depth) {
+            ctx->error=value;	/* Ƕ׹ */
+            goto fail;
+        }
+        obj=*value=='{';
+        item->type=obj?cJSON_Object:cJSON_Array;
+        value=skip(value+1,end);
+        if (value<end && *value==(obj?'}':']')) {	/* /. */
+            value++;
+            goto value_done;
+        }
+        if (!obj && (ctx->options&cJSON_OptPackNumbers) && !ctx->arena && value<end && (*value=='-' || IS_DIGIT(value,end))) {
+            if ((packed=parse_packed(ctx,item,value,end))) {	//ֵֻʱͷͨ
+                value=packed;
+                goto value_done;
+            }
+        }
+        if (!walk_push(&st,item)) goto fail;
+        goto next_member;
+    }
+    if (!(value=parse_scalar(ctx,item,value,end))) goto fail;
+
+value_done:	//item
+    /* arenaеĽڵַܵͷ. ʧʱ, ʧܵᱻcJSON_Delete */
+    if (ctx->arena) item->type|=cJSON_IsArena|cJSON_StringIsConst|cJSON_ValueIsConst;
+    /* ԭؽ: 뻺(ֵַparse_string) */
+    if ((ctx->options&CJSON_OPT_INSITU) && item->string) item->type|=cJSON_StringIsConst;
+    /* פļ */
+    if (ctx->keys && item->string) item->type|=cJSON_StringIsConst|cJSON_StringIsInterned;
+    if (!st.depth) {
+        walk_free(&st);
+        return value;
     }
-    if (*value=='[')				{
-        return parse_array(item,value);
+    f=&st.frames[st.depth-1];
+    obj=(f->node->type&255)==cJSON_Object;
+    value=skip(value,end);
+    if (value<end && *value==',') {	//һԪ
+        value=skip(value+1,end);
+        goto next_member;
     }
-    if (*value=='{')				{
-        return parse_object(item,value);
+    if (value<end && *value==(obj?'}':']')) {	/* / */
+        if (obj) close_object(ctx,f->node,f->last,f->n);
+        else close_array(ctx,f->node,f->last,f->n);
+        item=f->node;
+        st.depth--;
+        value++;
+        goto value_done;
     }
+    ctx->error=value;
+    goto fail;	/* ʧ,ṩڽıȱ. */
 
-    ep=value;
-    return 0;	/* ʧ. */
+next_member:	//ΪջһԪ(JSON/ԪصĹϵӹϵ)
+    f=&st.frames[st.depth-1];
+    if (!(child=parse_New_Item(ctx))) goto fail;	/* memory fail */
+    if (f->last) f->last->next=child,child->prev=f->last;
+    else f->node->child=child;
+    f->last=child;
+    f->n++;
+    if ((f->node->type&255)==cJSON_Object) {
+        /*JSONԪظʽΪ string:value stringparse_key()cJSONstringֶ*/
+        value=skip(parse_key(ctx,child,value,end),end);
+        if (!value) goto fail;
+        if (value>=end || *value!=':') {
+            ctx->error=value;    /* fail! */
+            goto fail;
+        }
+        value=skip(value+1,end);
+    }
+    item=child;
+    goto next_value;
+
+fail:
+    walk_free(&st);
+    return 0;
 }
 
 
 
 /* ṹcJSONתΪıʽJSON(ʽͷǸʽ)
+   /ʹõݹ: ѹʽջ,ÿֵصջָ.
    :item:ҪתcJSON(ʵҪתcJSONĸڵ)
           depth: ָʽʱĿո 
           fmt: Ƿĸʽ(),0ʾиʽ,0޸ʽ
-          p: JSONıʽĴ洢λ,ΪNULLʱռڲ
-   ֵ:ת׵ַ,ʧܣ0*/
-static char *print_value(cJSON *item,int depth,int fmt,printbuffer *p)
+          p: ,׷p->offset
+   ֵ:ɹ1,ʧܣ0*/
+static int print_value(cJSON *item,int depth,int fmt,printbuffer *p)
 {
-    char *out=0;
-    if (!item) return 0;
-    if (p) {
-        switch ((item->type)&255) {
-            case cJSON_NULL:	{
-                out=ensure(p,5);
-                if (out) strcpy(out,"null");
+    walk_stack st;
+    walk_frame *f;
+    int ok=0;
+
+    walk_init(&st,p->ctx);
+next_value:
+    if (!item) goto done;
+    switch ((item->type)&255) {
+        case cJSON_NULL:	if (!print_raw(p,"null",4)) goto done;
+                            break;
+        case cJSON_False:	if (!print_raw(p,"false",5)) goto done;
+                            break;
+        case cJSON_True:	if (!print_raw(p,"true",4)) goto done;
+                            break;
+        case cJSON_Number:	if (!print_number(item,p)) goto done;
+                            break;
+        case cJSON_String:	if (!print_string_ptr(item->valuestring,p)) goto done;
+                            break;
+        case cJSON_Array:
+            if (cJSON_GetPackedType(item)) {
+                if (!print_packed(item,fmt,p)) goto done;
                 break;
             }
-            case cJSON_False:	{
-                out=ensure(p,6);
-                if (out) strcpy(out,"false");
+            if (!cJSON_Expand(item) || !print_raw(p,"[",1)) goto done;
+            if (!item->child) {	//
+                if (!print_raw(p,"]",1)) goto done;
                 break;
             }
-            case cJSON_True:	{
-                out=ensure(p,5);
-                if (out) strcpy(out,"true");
+            if (!(f=walk_push(&st,item))) goto done;
+            f->child=item->child->next;
+            f->n=depth+1;
+            item=item->child;
+            depth=f->n;
+            goto next_value;
+        case cJSON_Object:
+            if (!cJSON_Expand(item) || !print_raw(p,"{\n",fmt?2:1)) goto done;
+            if (!item->child) {	//ն
+                if (!print_indent(p,fmt?depth-1:0) || !print_raw(p,"}",1)) goto done;
                 break;
             }
-            case cJSON_Number:
-                out=print_number(item,p);
-                break;
-            case cJSON_String:
-                out=print_string(item,p);
-                break;
-            case cJSON_Array:
-                out=print_array(item,depth,fmt,p);
-                break;
-            case cJSON_Object:
-                out=print_object(item,depth,fmt,p);
-                break;
-        }
-    } else {
-        switch ((item->type)&255) {
-            case cJSON_NULL:
-                out=cJSON_strdup("null");
-                break;
-            case cJSON_False:
-                out=cJSON_strdup("false");
-                break;
-            case cJSON_True:
-                out=cJSON_strdup("true");
-                break;
-            case cJSON_Number:
-                out=print_number(item,0);
-                break;
-            case cJSON_String:
-                out=print_string(item,0);
-                break;
-            case cJSON_Array:
-                out=print_array(item,depth,fmt,0);
-                break;
-            case cJSON_Object:
-                out=print_object(item,depth,fmt,0);
-                break;
+            if (!(f=walk_push(&st,item))) goto done;
+            f->child=item->child->next;
+            f->n=depth+1;
+            item=item->child;
+            depth=f->n;
+            goto next_member;
+        default: goto done;
+    }
+
+    /* item: صջ */
+    while (st.depth) {
+        f=&st.frames[st.depth-1];
+        item=f->child;
+        depth=f->n;
+        if ((f->node->type&255)==cJSON_Array) {
+            if (item) {
+                //ָԸʽʽתʱJSONԪ֮Ķŷָһո [x, y],ʽʱ[x,y]
+                if (!print_raw(p,", ",fmt?2:1)) goto done;
+                f->child=item->next;
+                goto next_value;
+            }
+            if (!print_raw(p,"]",1)) goto done;
+        } else {
+            if (item && !print_raw(p,",",1)) goto done;
+            if (fmt && !print_raw(p,"\n",1)) goto done;
+            if (item) {
+                f->child=item->next;
+                goto next_member;
+            }
+            if (fmt && !print_indent(p,depth-1)) goto done;
+            if (!print_raw(p,"}",1)) goto done;
         }
+        st.depth--;
     }
-    return out;
+    ok=1;
+    goto done;
+
+next_member:	//Ԫ: 
+    if (fmt && !print_indent(p,depth)) goto done;
+    if (!print_string_ptr(item->string,p)) goto done;
+    if (!print_raw(p,":\t",fmt?2:1)) goto done;
+    goto next_value;
+
+done:
+    walk_free(&st);
+    return ok;
 }
 
 
-/* json,ıһJSON. 
-   : item:ҪcJSON
-         value:ڹJSONjsonʽַ
-   :ɺ,һҪλ.ʧܷ0*/
-static const char *parse_array(cJSON *item,const char *value)
+/* /һԪؽ: ͷڵprevָβڵ, 轨.
+   parse_value(cJSON_ParserFeed). last:һԪ n:Ԫظ */
+static void close_array(cJSON_Context *ctx,cJSON *item,cJSON *last,int n)
 {
-    cJSON *child;
-    if (*value!='['){//ǷΪJSON
-        ep=value;    /* not an array! */
-        return 0;
-    }
+    if (item->child) item->child->prev=last;	//ͷڵprevָβڵ
+    if (ctx->arena && n>=CJSON_INDEX_THRESHOLD) build_item_vector(item,ctx);	//arenaеڷʱٽ
+}
+static void close_object(cJSON_Context *ctx,cJSON *item,cJSON *last,int n)
+{
+    if (item->child) item->child->prev=last;
+    if ((ctx->options&cJSON_OptIndexObjects) && n>CJSON_INDEX_THRESHOLD) build_key_table(item,0,ctx);	//ڽʱͽ
+}
 
-    item->type=cJSON_Array;
-    value=skip(value+1);
-    if (*value==']') return value+1;	/* . */
+/* ļ: Ѱַ(̽)Ĺϣ, дӽڵָ, hashes[]ŶӦĹϣֵ.
+   űֱڴСдкʹСдеĲ,ڵһҪʱ.
+   ظʱĽһ: ֻеһֵļ */
+typedef struct {
+    cJSON **slots;		//cap,0ʾղ
+    unsigned *hashes;	//slotsһһӦ
+    int cap;			//,2Nη
+    int count;			//ʹõĲ
+    int dups;			//ֹظļʱΪ1,ʱɾֱӶű
+} key_table;
 
-    item->child=child=cJSON_New_Item();//ΪJSONԪطռ(JSONԪصĹϵӹϵ)
-    if (!item->child) return 0;		 
-    value=skip(parse_value(child,skip(value)));	/* JSONǶ(ԪؿJSON),ʹüӵݹ֮ */
-    if (!value) return 0;
+typedef struct cJSON_Extra {
+    void *(*malloc_fn)(size_t sz);	//extraͱķ亯.Ϊ0ʾarena,ҲҪͷ
+    void (*free_fn)(void *ptr);
+    key_table keys[2];	//[0]:Сд [1]:Сд
+    int count;			//ӽڵĸ,-1ʾδ֪
+    cJSON **items;		//˳countӽڵ,0ʾδʧЧ
+    int items_cap;		//items
+    void *packed;		//Ԫؿ: countdoublelong long,ʱûӽڵ. 0ʾǽ
+    int packed_type;	//cJSON_PackedDoublecJSON_PackedInt64
+    struct lazy_doc *lazy;	//ӳٽδչڵ: ӽڵ㻹ûн,lazy->text. 0ʾûҪչ
+    int lazy_at;		//ڵlazy->tapeе±
+    cJSON *head,*tail;	//ͼʱͷβڵ. Բ˵ӽڵ㱻ֹĶ,Щ
+} cJSON_Extra;
+
+static void lazy_release(struct lazy_doc *doc);
+
+static int key_equal(const char *a,const char *b,int cs)
+{
+    if (a==b) return 1;		//ͬһפļ
+    if (!a || !b) return 0;
+    return cs?!strcmp(a,b):!cJSON_strcasecmp(a,b);
+}
+
+static void free_table(cJSON_Extra *x,key_table *t)
+{
+    if (t->slots && x->free_fn) x->free_fn(t->slots);
+    memset(t,0,sizeof(key_table));
+}
+
+static void free_items(cJSON_Extra *x)
+{
+    if (x->items && x->free_fn) x->free_fn(x->items);
+    x->items=0;
+    x->items_cap=0;
+}
+
+static void free_extra(cJSON *c)
+{
+    cJSON_Extra *x=c->extra;
+    if (!x) return;
+    free_table(x,&x->keys[0]);
+    free_table(x,&x->keys[1]);
+    free_items(x);
+    if (x->packed && x->free_fn) x->free_fn(x->packed);
+    if (x->lazy) lazy_release(x->lazy);
+    if (x->free_fn) x->free_fn(x);
+    c->extra=0;
+}
+
+void cJSON_ResetIndex(cJSON *item)
+{
+    cJSON_Extra *x=item?item->extra:0;
+    if (!x) return;
+    if (!x->packed && !x->lazy) {free_extra(item);return;}
+    free_table(x,&x->keys[0]);	//Ԫؿδչݲ,
+    free_table(x,&x->keys[1]);
+    free_items(x);
+}
+
+/* Ϊtcapղ. ۺ͹ϣֵͬһڴ */
+static int table_alloc(cJSON_Extra *x,key_table *t,int cap,cJSON_Context *ctx)
+{
+    size_t sz=(size_t)cap*(sizeof(cJSON*)+sizeof(unsigned));
+    char *mem=ctx?(char*)parse_malloc(ctx,sz):(x->malloc_fn?(char*)x->malloc_fn(sz):0);
+    if (!mem) return 0;
+    memset(mem,0,sz);
+    t->slots=(cJSON**)mem;
+    t->hashes=(unsigned*)(mem+(size_t)cap*sizeof(cJSON*));
+    t->cap=cap;
+    t->count=0;
+    return 1;
+}
 
-    while (*value==',') {//cJSONһԪ,һԪ
-        cJSON *new_item;
-        if (!(new_item=cJSON_New_Item())) return 0; 	/* memory fail */
-        child->next=new_item;
-        new_item->prev=child;
-		
-        child=new_item;
-        value=skip(parse_value(child,skip(value+1)));
-        if (!value) return 0;	/* memory fail */
+/* tвҼstring. ز۵±,ûҵʱ-1 */
+static int table_find(key_table *t,const char *string,unsigned h,int cs)
+{
+    int mask=t->cap-1,i=h&mask;
+    while (t->slots[i]) {
+        if (t->hashes[i]==h && key_equal(t->slots[i]->string,string,cs)) return i;
+        i=(i+1)&mask;
     }
+    return -1;
+}
 
-    if (*value==']') return value+1;	/* JSON */
-    ep=value;
-    return 0;	/* ʧ,ṩڽıȱ. */
+static void table_put(key_table *t,cJSON *item,unsigned h)
+{
+    int mask=t->cap-1,i=h&mask;
+    while (t->slots[i]) i=(i+1)&mask;
+    t->slots[i]=item;
+    t->hashes[i]=h;
+    t->count++;
 }
 
-/*  ΪarrayĽṹcJSONתΪıʽJSON,洢ʵλ. 
-:item:ҪתΪJSONıʽcJSONָ
-         depth: ָʽʱĿո 
-         fmt: Ƿĸʽ(),0ʾиʽ,0޸ʽ
-         P:תдpʵλãΪNULLʱڲռ
-    :ת׵ַ*/
-    
-static char *print_array(cJSON *item,int depth,int fmt,printbuffer *p)
-{
-    char **entries;
-    char *out=0,*ptr,*ret;
-    int len=5;
-    cJSON *child=item->child;
-    int numentries=0,i=0,fail=0;
-    size_t tmplen=0;
-
-    /* cJSONͶжٸԪ() */
-    while (child) numentries++,child=child->next;
-    /* cJSONͶûкʱ */
-    if (!numentries) {
-        if (p)	out=ensure(p,3);
-        else	out=(char*)cJSON_malloc(3);
-        if (out) strcpy(out,"[]");
-        return out;
-    }
-
-	/* к */
-	//ָתĴ洢λ
-    if (p) {
-        /* JSON. */
-        i=p->offset;
-        ptr=ensure(p,1);
-        if (!ptr) return 0;
-        *ptr='[';
-        p->offset++;
-        child=item->child;
-        while (child && !fail) {
-            print_value(child,depth+1,fmt,p);//ݹĴJSONԪ
-            p->offset=update(p);
-			//ָԸʽʽתʱJSONԪ֮Ķŷָһո [x, y],ʽʱ[x,y]
-            if (child->next) {
-                len=fmt?2:1; 
-                ptr=ensure(p,len+1);
-                if (!ptr) return 0;
-                *ptr++=',';
-                if(fmt)*ptr++=' ';
-                *ptr=0;
-                p->offset+=len;
-            }
-            child=child->next;
+/* item. Ѵʱ(пǰĽڵ),0. ޷ʱ */
+static int table_insert(cJSON_Extra *x,key_table *t,cJSON *item,int cs)
+{
+    unsigned h=item_hash(item,cs);
+    key_table old;
+    int i;
+    if (table_find(t,item->string,h,cs)>=0) {
+        t->dups=1;
+        return 0;
+    }
+    if ((t->count+1)*2>t->cap) {	//װӱ1/2
+        old=*t;
+        if (!table_alloc(x,t,old.cap*2,0)) {
+            *t=old;
+            free_table(x,t);
+            return 0;
         }
-        ptr=ensure(p,2);
-        if (!ptr) return 0;
-        *ptr++=']';
-        *ptr=0;
-        out=(p->buffer)+i;
-    } else {//ûָתĴ洢λʱ,Ҫڲ
-
-		/* һռָJSONԪתĵַ(ԪصĿռprint_value()з)
-		  ͨJSONԪתƵһĿռ*/
-        entries=(char**)cJSON_malloc(numentries*sizeof(char*));
-        if (!entries) return 0;
-        memset(entries,0,numentries*sizeof(char*));
-        /* Retrieve all the results: */
-        child=item->child;
-        while (child && !fail) {
-            ret=print_value(child,depth+1,fmt,0);
-            entries[i++]=ret;
-            if (ret) len+=strlen(ret)+2+(fmt?1:0);
-            else fail=1;//ʧ
-            child=child->next;
+        t->dups=old.dups;
+        for (i=0; i<old.cap; i++) if (old.slots[i]) table_put(t,old.slots[i],old.hashes[i]);
+        free_table(x,&old);
+    }
+    table_put(t,item,h);
+    return 1;
+}
+
+/* itemӱɾ. ʹúλɾ,Ĺ */
+static void table_remove(cJSON_Extra *x,key_table *t,cJSON *item,int cs)
+{
+    int mask=t->cap-1,i,j,k;
+    i=table_find(t,item->string,item_hash(item,cs),cs);
+    if (i<0 || t->slots[i]!=item) return;	//itemǰͬڵס,ڱ
+    if (t->dups) {	//ܻͬڵҪ,ֱӶű
+        free_table(x,t);
+        return;
+    }
+    t->count--;
+    for (j=i;;) {
+        t->slots[i]=0;
+        for (;;) {
+            j=(j+1)&mask;
+            if (!t->slots[j]) return;
+            k=t->hashes[j]&mask;
+            if (i<=j ? (i<k && k<=j) : (i<k || k<=j)) continue;	//k(i,j],Ҫƶ
+            break;
         }
+        t->slots[i]=t->slots[j];
+        t->hashes[i]=t->hashes[j];
+        i=j;
+    }
+}
 
-        /* If we didn't fail, try to malloc the output string */
-        if (!fail)	out=(char*)cJSON_malloc(len);
-        /* If that fails, we fail. */
-        if (!out) fail=1;
+/* ȡcextra,ûʱ. ctx0ʱ()ctx,ʹĬϵķ亯 */
+static cJSON_Extra *get_extra(cJSON *c,cJSON_Context *ctx)
+{
+    cJSON_Extra *x=c->extra;
+    if (x) return x;
+    if (c->type&cJSON_IsReference) return 0;	//ԭӽڵ,ԭ޸ĺʧЧ
+    if (ctx) x=(cJSON_Extra*)parse_malloc(ctx,sizeof(cJSON_Extra));
+    else if (c->type&cJSON_IsArena) return 0;	//arenaеʱͷextra
+    else x=(cJSON_Extra*)cJSON_malloc(sizeof(cJSON_Extra));
+    if (!x) return 0;
+    memset(x,0,sizeof(cJSON_Extra));
+    x->malloc_fn=ctx?(ctx->arena?0:ctx->malloc_fn):default_ctx.malloc_fn;
+    x->free_fn=ctx?(ctx->arena?0:ctx->free_fn):default_ctx.free_fn;
+    x->count=-1;
+    c->extra=x;
+    return x;
+}
 
-        /* Handle failure. */
-        if (fail) {
-            for (i=0; i<numentries; i++) if (entries[i]) cJSON_free(entries[i]);
-            cJSON_free(entries);
-            return 0;
-        }
+/* ڵͷβڵ, ͼӦľ */
+static void index_mark(cJSON *parent,cJSON_Extra *x)
+{
+    x->head=parent->child;
+    x->tail=parent->child?parent->child->prev:0;
+}
+
+//ϸͼ
+static void index_drop(cJSON_Extra *x)
+{
+    free_table(x,&x->keys[0]);
+    free_table(x,&x->keys[1]);
+    free_items(x);
+    x->count=-1;
+}
+
+/* ֮ǰ黺: ֹ޸child/next(ûоAPI)ʱ, ͷڵβڵ(ͷڵprev),
+   βڵ½ڵ, ʱϻ, ±. parentextra */
+static cJSON_Extra *index_valid(cJSON *parent)
+{
+    cJSON_Extra *x=parent->extra;
+    cJSON *c=parent->child;
+    if (!x || x->packed || x->lazy) return x;	//δչĽڵûӽڵ
+    if (x->head!=c || x->tail!=(c?c->prev:0) || (x->tail && x->tail->next)) index_drop(x);
+    return x;
+}
+
+/* ȥitemͷβڵ(itemparent) */
+static void ends_without(cJSON *parent,cJSON *item,cJSON **head,cJSON **tail)
+{
+    *head=item==parent->child?item->next:parent->child;
+    if (item->next) *tail=parent->child->prev;
+    else *tail=item==parent->child?0:item->prev;
+}
+
+/* ΪobjectСд(cs=1)(cs=0)ļ */
+static void build_key_table(cJSON *object,int cs,cJSON_Context *ctx)
+{
+    cJSON_Extra *x=get_extra(object,ctx);
+    key_table *t;
+    cJSON *c;
+    int n=0,cap=16;
+    if (!x) return;
+    t=&x->keys[cs];
+    if (t->slots) return;
+    for (c=object->child; c; c=c->next) n++;
+    x->count=n;
+    index_mark(object,x);
+    while (cap<n*2) cap*=2;
+    if (!table_alloc(x,t,cap,ctx)) return;
+    t->dups=0;
+    for (c=object->child; c; c=c->next) if (c->string) table_insert(x,t,c,cs);
+}
+
+/* Ϊarrayӽڵ,Ժ±O(1) */
+static void build_item_vector(cJSON *array,cJSON_Context *ctx)
+{
+    cJSON_Extra *x=get_extra(array,ctx);
+    cJSON *c;
+    int n=0;
+    if (!x || x->items) return;
+    for (c=array->child; c; c=c->next) n++;
+    x->count=n;
+    index_mark(array,x);
+    if (!n) return;
+    x->items=(cJSON**)(ctx?parse_malloc(ctx,n*sizeof(cJSON*)):x->malloc_fn?x->malloc_fn(n*sizeof(cJSON*)):0);
+    if (!x->items) return;
+    x->items_cap=n;
+    for (n=0,c=array->child; c; c=c->next) x->items[n++]=c;
+}
 
-        /* Compose the output array. */
-        *out='[';
-        ptr=out+1;
-        *ptr=0;
-        for (i=0; i<numentries; i++) {
-            tmplen=strlen(entries[i]);
-            memcpy(ptr,entries[i],tmplen);
-            ptr+=tmplen;
-            if (i!=numentries-1) {
-                *ptr++=',';
-                if(fmt)*ptr++=' ';
-                *ptr=0;
+/* ӽڵ㷢仯ʱά. at_end: 1ʾitemβ,0ʾм */
+static void index_added(cJSON *parent,cJSON *item,int at_end)
+{
+    cJSON_Extra *x=parent->extra;
+    cJSON **items,*head,*tail;
+    int cs,cap;
+    if (!x) return;
+    ends_without(parent,item,&head,&tail);
+    if (x->head!=head || x->tail!=tail) index_drop(x);	//֮ǰѾֹĶ
+    index_mark(parent,x);
+    if (x->count>=0) x->count++;
+    if (x->items) {
+        if (!at_end || x->count<0 || !x->malloc_fn) free_items(x);	//мʱʧЧ,arenaе
+        else {
+            if (x->count>x->items_cap) {	//
+                cap=2*x->items_cap;
+                items=(cJSON**)x->malloc_fn(cap*sizeof(cJSON*));
+                if (items) memcpy(items,x->items,x->items_cap*sizeof(cJSON*));
+                free_items(x);
+                x->items=items;
+                x->items_cap=items?cap:0;
             }
-            cJSON_free(entries[i]);
+            if (x->items) x->items[x->count-1]=item;
+        }
+    }
+    if (!item->string) return;
+    for (cs=0; cs<2; cs++) {
+        key_table *t=&x->keys[cs];
+        if (!t->slots) continue;
+        if (!x->malloc_fn) free_table(x,t);	//arenaеı
+        else if (!table_insert(x,t,item,cs) && !at_end) free_table(x,t);	//мͬڵڱнڵǰ
+    }
+}
+
+static void index_removed(cJSON *parent,cJSON *item)
+{
+    cJSON_Extra *x=parent->extra;
+    int cs;
+    if (!x) return;
+    if (x->head!=parent->child || x->tail!=parent->child->prev) index_drop(x);
+    ends_without(parent,item,&x->head,&x->tail);
+    if (x->count>0) x->count--;
+    if (x->items && item->next) free_items(x);	//ժβڵʱȻЧ
+    if (!item->string) return;
+    for (cs=0; cs<2; cs++) if (x->keys[cs].slots) table_remove(x,&x->keys[cs],item,cs);
+}
+
+/* : ֵֻ԰Ԫشextra->packedcountdoublelong long,Ϊÿַڵ.
+   ӡӦͨȫͬ; ͨʽӽڵʱ(cJSON_UnpackArray)չӽڵ */
+typedef struct {
+    void *data;		//cap8ֽڵԪ
+    int count,cap;
+    int type;		//cJSON_PackedInt64: ĿǰΪֹ; cJSON_PackedDouble
+    void *(*malloc_fn)(size_t sz);
+    void (*free_fn)(void *ptr);
+} packer;
+
+/* ֵnum׷ӵpk. isint: num. Ԫضʱlong long,double.
+   չĽڵֽͨڵͬ,doubleܾȷʾ(valueint64ֵᶪʧ)ʹʧ.
+   :ɹ1,ʧܣ0 */
+static int pack_number(packer *pk,const cJSON *num,int isint)
+{
+    long long *ints=(long long*)pk->data;
+    double *dbls=(double*)pk->data;
+    void *data;
+    int i;
+
+    if (pk->count==pk->cap) {	//
+        pk->cap=pk->cap?pk->cap*2:16;
+        if (!(data=pk->malloc_fn((size_t)pk->cap*8))) return 0;
+        if (pk->count) memcpy(data,pk->data,(size_t)pk->count*8);
+        if (pk->data) pk->free_fn(pk->data);
+        pk->data=data;
+        ints=(long long*)data,dbls=(double*)data;
+    }
+    if (pk->type==cJSON_PackedInt64) {
+        if (isint && (double)num->valueint64==num->valuedouble) {ints[pk->count++]=num->valueint64;return 1;}
+        for (i=0; i<pk->count; i++) {	//ֵһ: е͵תΪdouble
+            long long v=ints[i];
+            if (double_to_int64((double)v)!=v) return 0;
+            dbls[i]=(double)v;
         }
-        cJSON_free(entries);
-        *ptr++=']';
-        *ptr++=0;
+        pk->type=cJSON_PackedDouble;
+    }
+    if (double_to_int64(num->valuedouble)!=num->valueint64) return 0;
+    dbls[pk->count++]=num->valuedouble;
+    return 1;
+}
+
+/* pkеԪؽarray. pkڴarray */
+static void pack_into(cJSON *array,packer *pk)
+{
+    cJSON_Extra *x=array->extra;
+    x->packed=pk->data;
+    x->packed_type=pk->type;
+    x->count=pk->count;
+    pk->data=0;
+}
+
+/* ԰һֵֻΪ. valueָһԪ.
+   :ɺ,һҪλ. ֵԪػ﷨ʱ0,ɵߴͷͨ */
+static const char *parse_packed(cJSON_Context *ctx,cJSON *item,const char *value,const char *end)
+{
+    packer pk={0,0,0,cJSON_PackedInt64,0,0};
+    const char *start;
+    cJSON num;
+    int isint;
+
+    pk.malloc_fn=ctx->malloc_fn,pk.free_fn=ctx->free_fn;
+    for (;;) {
+        if (value>=end || (*value!='-' && !IS_DIGIT(value,end))) break;
+        start=value;
+        if (!(value=parse_number(&num,value,end))) break;
+        for (isint=1; start<value; start++) if (*start=='.' || *start=='e' || *start=='E') isint=0;
+        if (!pack_number(&pk,&num,isint)) break;
+        value=skip(value,end);
+        if (value<end && *value==',') {value=skip(value+1,end);continue;}
+        if (value>=end || *value!=']' || !get_extra(item,ctx)) break;
+        pack_into(item,&pk);
+        return value+1;
+    }
+    if (pk.data) pk.free_fn(pk.data);
+    return 0;
+}
+
+//ѽĵiԪصֵдitem
+static void packed_value(const cJSON_Extra *x,int i,cJSON *item)
+{
+    if (x->packed_type==cJSON_PackedInt64) {
+        long long v=((const long long*)x->packed)[i];
+        item->valuedouble=(double)v;
+        item->valueint64=v;
+        item->valueint=int64_to_int(v);
+    } else cJSON_SetNumberHelper(item,((const double*)x->packed)[i]);
+}
+
+/* print_valueн */
+static int print_packed(cJSON *item,int fmt,printbuffer *p)
+{
+    cJSON_Extra *x=item->extra;
+    cJSON num;
+    int i;
+
+    if (!print_raw(p,"[",1)) return 0;
+    for (i=0; i<x->count; i++) {
+        packed_value(x,i,&num);
+        if (!print_number(&num,p)) return 0;
+        if (i+1<x->count && !print_raw(p,", ",fmt?2:1)) return 0;
+    }
+    return print_raw(p,"]",1);
+}
+
+/* print_packedĳ */
+static size_t packed_printed_length(cJSON *item,int fmt)
+{
+    cJSON_Extra *x=item->extra;
+    cJSON num;
+    char str[NUMBER_PRINT_SIZE];
+    size_t len=2;
+    int i;
+
+    for (i=0; i<x->count; i++) {
+        packed_value(x,i,&num);
+        len+=format_number(&num,str);
     }
-    return out;
+    if (x->count>1) len+=(size_t)(x->count-1)*(fmt?2:1);
+    return len;
 }
 
-/* json,ṩַһJSON
-   : item:ҪcJSON
-         value:ڹjsonʽַ
-   :ɺ,һҪλ.ʧܷ0*/
-static const char *parse_object(cJSON *item,const char *value)
+/* cJSON_Duplicate: itemԪؿ鵽newitem */
+static int copy_packed(cJSON *newitem,cJSON *item)
 {
-    cJSON *child;
-    if (*value!='{')	{//ҪǷΪjson
-        ep=value;    /* not an object! */
+    cJSON_Extra *x=item->extra,*nx=get_extra(newitem,0);
+    if (!nx || !(nx->packed=cJSON_malloc((size_t)x->count*8))) return 0;
+    memcpy(nx->packed,x->packed,(size_t)x->count*8);
+    nx->packed_type=x->packed_type;
+    nx->count=x->count;
+    return 1;
+}
+
+static cJSON *create_packed(const void *numbers,int count,int type)
+{
+    cJSON *a=cJSON_CreateArray();
+    cJSON_Extra *x;
+    if (!a || count<=0) return a;
+    if (!(x=get_extra(a,0)) || !(x->packed=cJSON_malloc((size_t)count*8))) {
+        cJSON_Delete(a);
         return 0;
     }
+    memcpy(x->packed,numbers,(size_t)count*8);
+    x->packed_type=type;
+    x->count=count;
+    return a;
+}
+cJSON *cJSON_CreatePackedDoubleArray(const double *numbers,int count)
+{
+    return create_packed(numbers,count,cJSON_PackedDouble);
+}
+cJSON *cJSON_CreatePackedInt64Array(const long long *numbers,int count)
+{
+    return create_packed(numbers,count,cJSON_PackedInt64);
+}
+
+int cJSON_GetPackedType(cJSON *array)
+{
+    return array && array->extra && array->extra->packed?array->extra->packed_type:0;
+}
+double *cJSON_GetNumberArrayData(cJSON *array,int *count)
+{
+    if (cJSON_GetPackedType(array)!=cJSON_PackedDouble) return 0;
+    if (count) *count=array->extra->count;
+    return (double*)array->extra->packed;
+}
+long long *cJSON_GetInt64ArrayData(cJSON *array,int *count)
+{
+    if (cJSON_GetPackedType(array)!=cJSON_PackedInt64) return 0;
+    if (count) *count=array->extra->count;
+    return (long long*)array->extra->packed;
+}
 
-    item->type=cJSON_Object;
-    value=skip(value+1);
-    if (*value=='}') return value+1;	/* յĶ. */
+int cJSON_PackArray(cJSON *array)
+{
+    packer pk={0,0,0,cJSON_PackedInt64,0,0};
+    cJSON *c;
 
-    item->child=child=cJSON_New_Item(); //ΪJSONԪطռ(JSONԪصĹϵӹϵ)
-    if (!item->child) return 0;
-	
-	/*JSONԪظʽΪ string:value string浽cJSONstringֶУ
-	ͨparse_string()ַǴ洢cJSONvaluestringֶ,Ҫ漸*/
-    value=skip(parse_string(child,skip(value)));
-    if (!value) return 0;
-    child->string=child->valuestring;
-    child->valuestring=0;
-    if (*value!=':') {
-        ep=value;    /* fail! */
+    if (!array || (array->type&255)!=cJSON_Array || (array->type&(cJSON_IsReference|cJSON_IsArena)) || !cJSON_Expand(array) || !array->child) return 0;
+    pk.malloc_fn=default_ctx.malloc_fn,pk.free_fn=default_ctx.free_fn;
+    for (c=array->child; c; c=c->next)
+        if ((c->type&255)!=cJSON_Number || !pack_number(&pk,c,(double)c->valueint64==c->valuedouble)) break;
+    if (!c) cJSON_ResetIndex(array);	//ӽڵʧЧ
+    if (c || !get_extra(array,0)) {
+        if (pk.data) pk.free_fn(pk.data);
         return 0;
     }
-    value=skip(parse_value(child,skip(value+1)));	/* JSONĶvalueǶ(valueֿJSON),ʹüӵݹ֮ */
-    if (!value) return 0;
+    cJSON_Delete(array->child);
+    array->child=0;
+    pack_into(array,&pk);
+    return 1;
+}
 
-    while (*value==',') {//cJSONһԪ,һԪ
-        cJSON *new_item;
-        if (!(new_item=cJSON_New_Item()))	return 0; /* memory fail */
-        child->next=new_item;
-        new_item->prev=child;
-        child=new_item;
-        value=skip(parse_string(child,skip(value+1)));/* JSONĶstring*/
-        if (!value) return 0;
-        child->string=child->valuestring;
-        child->valuestring=0;
-        if (*value!=':') {
-            ep=value;    /* fail! */
+int cJSON_UnpackArray(cJSON *array)
+{
+    cJSON_Extra *x=array?array->extra:0;
+    cJSON *head=0,*tail=0,*n;
+    int i;
+
+    if (!x || !x->packed) return 1;
+    for (i=0; i<x->count; i++) {	//ڵextraķ亯,ڵһ
+        if (!(n=(cJSON*)x->malloc_fn(sizeof(cJSON)))) {
+            while (head) n=head->next,x->free_fn(head),head=n;
             return 0;
         }
-        value=skip(parse_value(child,skip(value+1)));	/* skip any spacing, get the value. */
-        if (!value) return 0;
+        memset(n,0,sizeof(cJSON));
+        n->type=cJSON_Number;
+        packed_value(x,i,n);
+        if (tail) tail->next=n,n->prev=tail;
+        else head=n;
+        tail=n;
     }
+    x->free_fn(x->packed);
+    x->packed=0;
+    array->child=head;
+    if (head) head->prev=tail;
+    index_mark(array,x);
+    return 1;
+}
 
-    if (*value=='}') return value+1;	/* end of array */
-    ep=value;
-    return 0;	/* malformed. */
+/* ӳٽ: cJSON_ParseLazyֻɨһṹ(ַ,ƥ),ÿ/ıеֹλðֵ˳
+   tape,ֻڵ. /ӽڵڵһͨAPIʱ(cJSON_Expand)Ž,ֻչһ:
+   ͱֵ,Ƕ׵/ΪδչĽڵ,tapeֱ. ûзʵĲֻɨʱ */
+typedef struct {
+    size_t open,close;	//'[''{'Ӧ']''}'ıеƫ
+    int next;			//֮һ/tapeе±. ɨʱݴ游ڵ±
+} lazy_entry;
+
+typedef struct lazy_doc {
+    const char *text;
+    lazy_entry *tape;
+    int refs;			//δչڵĸ,Ϊ0ʱͷ
+    cJSON_Context ctx;	//չʱʹõķ亯ѡ
+} lazy_doc;
+
+static void lazy_release(lazy_doc *doc)
+{
+    if (--doc->refs) return;
+    doc->ctx.free_fn(doc->tape);
+    doc->ctx.free_fn(doc);
 }
 
-/*  ΪobjectĽṹcJSONתΪıʽJSON,洢ʵλ. 
-:item:ҪתΪJSONıʽcJSONָ
-         depth: ָʽʱĿո 
-         fmt: Ƿĸʽ(),0ʾиʽ,0޸ʽ
-         P:תдpʵλãΪNULLʱڲռ
-    :ת׵ַ*/
-static char *print_object(cJSON *item,int depth,int fmt,printbuffer *p)
-{
-    char **entries=0,**names=0;
-    char *out=0,*ptr,*ret,*str;
-    int len=7,i=0,j;
-    cJSON *child=item->child;
-    int numentries=0,fail=0;
-    size_t tmplen=0;
-    /* cJSONobjectͶжٸԪ() */
-    while (child) numentries++,child=child->next;
-    /* cJSONobjectͶûкʱ */
-    if (!numentries) {
-        if (p) out=ensure(p,fmt?depth+4:3);
-        else	out=(char*)cJSON_malloc(fmt?depth+4:3);
-        if (!out)	return 0;
-        ptr=out;
-        *ptr++='{';
-        if (fmt) {
-            *ptr++='\n';
-            for (i=0; i<depth-1; i++) *ptr++='\t';
-        }
-        *ptr++='}';
-        *ptr++=0;
-        return out;
-    }
-
-	/* cJSONobjectͶԪʱ */
-    if (p) {
-        /* Compose the output: */
-        i=p->offset;
-        len=fmt?2:1;
-        ptr=ensure(p,len+1);
-        if (!ptr) return 0;
-        *ptr++='{';
-        if (fmt) *ptr++='\n';
-        *ptr=0;
-        p->offset+=len;
-        child=item->child;
-        depth++;
-        while (child) {
-            if (fmt) {
-                ptr=ensure(p,depth);
-                if (!ptr) return 0;
-                for (j=0; j<depth; j++) *ptr++='\t';
-                p->offset+=depth;
-            }
-            print_string_ptr(child->string,p);
-            p->offset=update(p);
-
-            len=fmt?2:1;
-            ptr=ensure(p,len);
-            if (!ptr) return 0;
-            *ptr++=':';
-            if (fmt) *ptr++='\t';
-            p->offset+=len;
-
-            print_value(child,depth,fmt,p);
-            p->offset=update(p);
-
-            len=(fmt?1:0)+(child->next?1:0);
-            ptr=ensure(p,len+1);
-            if (!ptr) return 0;
-            if (child->next) *ptr++=',';
-            if (fmt) *ptr++='\n';
-            *ptr=0;
-            p->offset+=len;
-            child=child->next;
-        }
-        ptr=ensure(p,fmt?(depth+1):2);
-        if (!ptr) return 0;
-        if (fmt)	for (i=0; i<depth-1; i++) *ptr++='\t';
-        *ptr++='}';
-        *ptr=0;
-        out=(p->buffer)+i;
-    } else {
-        /* Allocate space for the names and the objects */
-        entries=(char**)cJSON_malloc(numentries*sizeof(char*));
-        if (!entries) return 0;
-        names=(char**)cJSON_malloc(numentries*sizeof(char*));
-        if (!names) {
-            cJSON_free(entries);
-            return 0;
-        }
-        memset(entries,0,sizeof(char*)*numentries);
-        memset(names,0,sizeof(char*)*numentries);
-
-        /* Collect all the results into our arrays: */
-        child=item->child;
-        depth++;
-        if (fmt) len+=depth;
-        while (child) {
-            names[i]=str=print_string_ptr(child->string,0);
-            entries[i++]=ret=print_value(child,depth,fmt,0);
-            if (str && ret) len+=strlen(ret)+strlen(str)+2+(fmt?2+depth:0);
-            else fail=1;
-            child=child->next;
+/* ɨptr'[''{'ʼֵ,doc->tape. ֵ֮λ,ʧܷ0 */
+static const char *lazy_scan(cJSON_Context *ctx,lazy_doc *doc,const char *ptr,const char *end)
+{
+    lazy_entry *tape;
+    int count=0,cap=64,cur=-1,depth=0,escaped;
+
+    if (!(doc->tape=(lazy_entry*)ctx->malloc_fn(cap*sizeof(lazy_entry)))) return 0;
+    for (; (ptr=scan_structure(ptr,end))<end; ptr++) {
+        switch (*ptr) {
+            case '\"':
+                ptr=string_end(ptr+1,end,&escaped);
+                if (ptr>=end) {ctx->error=ptr;return 0;}	//ַûн
+                break;
+            case '[': case '{':
+                if (ctx->max_depth>0 && depth>=ctx->max_depth) {ctx->error=ptr;return 0;}	//Ƕ׹
+                if (count==cap) {	//
+                    if (!(tape=(lazy_entry*)ctx->malloc_fn(2*cap*sizeof(lazy_entry)))) return 0;
+                    memcpy(tape,doc->tape,cap*sizeof(lazy_entry));
+                    ctx->free_fn(doc->tape);
+                    doc->tape=tape;
+                    cap*=2;
+                }
+                doc->tape[count].open=ptr-doc->text;
+                doc->tape[count].next=cur;
+                cur=count++;
+                depth++;
+                break;
+            case ']': case '}':
+                tape=&doc->tape[cur];
+                if (doc->text[tape->open]!=(*ptr==']'?'[':'{')) {ctx->error=ptr;return 0;}	//Ųƥ
+                tape->close=ptr-doc->text;
+                cur=tape->next;
+                tape->next=count;
+                if (!--depth) return ptr+1;
+                break;
+            case 0:
+                ctx->error=ptr;
+                return 0;
         }
+    }
+    ctx->error=ptr;		//ı
+    return 0;
+}
+
+/* itemΪtapeеat/δչڵ */
+static int lazy_attach(cJSON *item,lazy_doc *doc,int at,cJSON_Context *ctx)
+{
+    cJSON_Extra *x=get_extra(item,ctx);
+    if (!x) return 0;
+    item->type=doc->text[doc->tape[at].open]=='['?cJSON_Array:cJSON_Object;
+    x->lazy=doc;
+    x->lazy_at=at;
+    doc->refs++;
+    return 1;
+}
 
-        /* Try to allocate the output string */
-        if (!fail)	out=(char*)cJSON_malloc(len);
-        if (!out) fail=1;
+/* չδչĽڵitemһӽڵ. ﷨ʱű: 0,λÿcJSON_GetErrorPtr()ȡ */
+static int lazy_expand(cJSON *item)
+{
+    cJSON_Extra *x=item->extra;
+    lazy_doc *doc=x->lazy;
+    cJSON_Context ctx=doc->ctx;
+    const char *value=doc->text+doc->tape[x->lazy_at].open+1,*end=doc->text+doc->tape[x->lazy_at].close;
+    cJSON *child,*last=0;
+    int nested=x->lazy_at+1,n=0,obj=(item->type&255)==cJSON_Object;
 
-        /* Handle failure */
-        if (fail) {
-            for (i=0; i<numentries; i++) {
-                if (names[i]) cJSON_free(names[i]);
-                if (entries[i]) cJSON_free(entries[i]);
-            }
-            cJSON_free(names);
-            cJSON_free(entries);
-            return 0;
+    ctx.error=0;
+    value=skip(value,end);
+    if (value<end) for (;;) {
+        if (!(child=parse_New_Item(&ctx))) goto fail;
+        if (last) last->next=child,child->prev=last;
+        else item->child=child;
+        last=child;
+        n++;
+        if (obj) {	//
+            value=skip(parse_key(&ctx,child,value,end),end);
+            if (!value) goto fail;
+            if (value>=end || *value!=':') {ctx.error=value;goto fail;}
+            value=skip(value+1,end);
         }
+        if (value<end && (*value=='[' || *value=='{')) {	//Ƕ׵/: tape
+            if ((size_t)(value-doc->text)!=doc->tape[nested].open || !lazy_attach(child,doc,nested,&ctx)) {ctx.error=value;goto fail;}
+            if (ctx.keys && child->string) child->type|=cJSON_StringIsConst|cJSON_StringIsInterned;
+            value=doc->text+doc->tape[nested].close+1;
+            nested=doc->tape[nested].next;
+        } else if (!(value=parse_value(&ctx,child,value,end,0))) goto fail;
+        value=skip(value,end);
+        if (value>=end) break;
+        if (*value!=',') {ctx.error=value;goto fail;}
+        value=skip(value+1,end);
+    }
+    if (obj) close_object(&ctx,item,last,n);
+    else close_array(&ctx,item,last,n);
+    x->lazy=0;
+    x->count=n;
+    index_mark(item,x);
+    lazy_release(doc);
+    return 1;
+fail:
+    if (item->child) cJSON_DeleteCtx(&ctx,item->child);
+    item->child=0;
+    default_ctx.error=ctx.error;
+    return 0;
+}
 
-        /* Compose the output: */
-        *out='{';
-        ptr=out+1;
-        if (fmt)*ptr++='\n';
-        *ptr=0;
-        for (i=0; i<numentries; i++) {
-            if (fmt) for (j=0; j<depth; j++) *ptr++='\t';
-            tmplen=strlen(names[i]);
-            memcpy(ptr,names[i],tmplen);
-            ptr+=tmplen;
-            *ptr++=':';
-            if (fmt) *ptr++='\t';
-            strcpy(ptr,entries[i]);
-            ptr+=strlen(entries[i]);
-            if (i!=numentries-1) *ptr++=',';
-            if (fmt) *ptr++='\n';
-            *ptr=0;
-            cJSON_free(names[i]);
-            cJSON_free(entries[i]);
-        }
+/* ӳٽ[value,value+length)еJSONı. ĸarenaеĽͨʽ.
+   valueɾ֮ǰһֱЧ */
+cJSON *cJSON_ParseLazyCtx(cJSON_Context *ctx,const char *value,size_t length,const char **return_parse_end)
+{
+    const char *end=value?value+length:0,*ptr=skip(value,end);
+    lazy_doc *doc;
+    cJSON *c;
 
-        cJSON_free(names);
-        cJSON_free(entries);
-        if (fmt) for (i=0; i<depth-1; i++) *ptr++='\t';
-        *ptr++='}';
-        *ptr++=0;
+    if (!ptr || ptr>=end || (*ptr!='[' && *ptr!='{') || ctx->arena) return parse_ctx(ctx,value,end,return_parse_end);
+    ctx->error=0;
+    if (!(doc=(lazy_doc*)ctx->malloc_fn(sizeof(lazy_doc)))) return 0;
+    doc->text=value;
+    doc->refs=0;
+    doc->ctx=*ctx;
+    ptr=lazy_scan(ctx,doc,ptr,end);
+    if (ptr && (ctx->options&cJSON_OptRequireNullTerminated)) {
+        ptr=skip(ptr,end);
+        if (ptr<end && *ptr) ctx->error=ptr,ptr=0;
     }
-    return out;
+    c=ptr?parse_New_Item(ctx):0;
+    if (!c || !lazy_attach(c,doc,0,ctx)) {
+        if (c) ctx->free_fn(c);
+        if (doc->tape) ctx->free_fn(doc->tape);
+        ctx->free_fn(doc);
+        return 0;
+    }
+    if (return_parse_end) *return_parse_end=ptr;
+    return c;
+}
+cJSON *cJSON_ParseLazy(const char *value,size_t length)
+{
+    cJSON_Context ctx=default_ctx;
+    cJSON *c=cJSON_ParseLazyCtx(&ctx,value,length,0);
+    default_ctx.error=ctx.error;
+    return c;
+}
+
+int cJSON_Expand(cJSON *item)
+{
+    if (!item || !item->extra) return 1;
+    if (item->extra->packed) return cJSON_UnpackArray(item);
+    if (item->extra->lazy) return lazy_expand(item);
+    return 1;
 }
 
 /* Get Array size/item / object item. */
-/*ȡcJSONС:еĴСֻҪö°󣬸һԡ,ָ*/
+/*ȡcJSONС:еĴСֻҪö°󣬸һԡ,ָ
+  ĸỺextra,֮ĵO(1) */
 int    cJSON_GetArraySize(cJSON *array)
 {
-    cJSON *c=array->child;
+    cJSON_Extra *x;
+    cJSON *c;
     int i=0;
+    if ((x=index_valid(array)) && x->count>=0) return x->count;
+    if (!cJSON_Expand(array)) return 0;
+    if ((x=index_valid(array)) && x->count>=0) return x->count;
+    c=array->child;
     while(c)i++,c=c->next;
+    if (i>=CJSON_INDEX_THRESHOLD && (x=get_extra(array,0))) x->count=i,index_mark(array,x);
     return i;
 }
 /*indexķʽȡcJSONӦ
-  ӦindexҲ᷵NULL*/
+  ӦindexҲ᷵NULL
+  ̫ʱӽڵ,֮±O(1) */
 cJSON *cJSON_GetArrayItem(cJSON *array,int item)
 {
-    cJSON *c=array->child;
+    cJSON_Extra *x;
+    cJSON *c;
+    int walked;
+    if (!cJSON_Expand(array)) return 0;
+    c=array->child;
+    COUNT(lookups,1);
+    if ((x=index_valid(array)) && x->items) {
+        if (item<0) item=0;
+        return item<x->count?x->items[item]:0;
+    }
+    walked=item;
     while (c && item>0) item--,c=c->next;
+    COUNT(lookup_steps,walked>item?walked-item:0);
+    if (walked>=CJSON_INDEX_THRESHOLD) build_item_vector(array,0);
+    return c;
+}
+/* Ҷӽڵ. ʱ, , ̫ʱΪһβҽ */
+static cJSON *get_object_item(cJSON *object,const char *string,int cs)
+{
+    cJSON_Extra *x;
+    cJSON *c;
+    int walked=0,i;
+    if (!cJSON_Expand(object)) return 0;
+    c=object->child;
+    COUNT(lookups,1);
+    if (string && (x=index_valid(object)) && x->keys[cs].slots) {
+        key_table *t=&x->keys[cs];
+        i=table_find(t,string,hash_key(string,cs),cs);
+        return i<0?0:t->slots[i];
+    }
+    while (c && !key_equal(c->string,string,cs)) c=c->next,walked++;
+    COUNT(lookup_steps,walked);
+    if (walked>=CJSON_INDEX_THRESHOLD && string) build_key_table(object,cs,0);
     return c;
 }
 /*ƵķʽȡcJSONӦ
   ȡǰcJSONֵcJSONҲ᷵NULL*/
 cJSON *cJSON_GetObjectItem(cJSON *object,const char *string)
 {
-    cJSON *c=object->child;
-    while (c && cJSON_strcasecmp(c->string,string)) c=c->next;
-    return c;
+    return get_object_item(object,string,0);
+}
+cJSON *cJSON_GetObjectItemCaseSensitive(cJSON *object,const char *string)
+{
+    return get_object_item(object,string,1);
 }
 
 
@@ -1024,49 +3608,78 @@ static void suffix_object(cJSON *prev,cJSON *item)
 /* Utility for handling references. һ,뱻õĶԴ,ͷԴʱҪע */
 static cJSON *create_reference(cJSON *item)
 {
-    cJSON *ref=cJSON_New_Item();
+    cJSON *ref;
+    if (!cJSON_Expand(item)) return 0;	//ùӽڵ
+    ref=cJSON_New_Item();
     if (!ref) return 0;
     memcpy(ref,item,sizeof(cJSON));
     ref->string=0;
-    ref->type|=cJSON_IsReference;
+    ref->type=(ref->type&~(cJSON_IsArena|cJSON_StringIsConst|cJSON_StringIsInterned))|cJSON_IsReference;	//ýڵ㱾cJSON_malloc
     ref->next=ref->prev=0;
+    ref->extra=0;	//òܹԭ
     return ref;
 }
 
 /* JSON array Ԫ. ʵJSON Object ԪҲ
-(cJSONжJSONarrayObjectͲͬ,ObjectstringֶηNULL)*/
+(cJSONжJSONarrayObjectͲͬ,ObjectstringֶηNULL)
+   ͷڵprevָβڵ,O(1). ֹƴӵ(ͷڵprevΪ0βָ)ʱ֪λҵβ */
 void   cJSON_AddItemToArray(cJSON *array, cJSON *item)
 {
-    cJSON *c=array->child;
-    if (!item) return;
+    cJSON *c,*tail;
+    if (!item || !cJSON_Expand(array)) return;
+    c=array->child;
     if (!c) {////JSONĸarrayûԪ
         array->child=item;
+        item->prev=item;
     } else {//JSONĸarrayԪ()ʱ,¼Ԫطŵβ
-        while (c && c->next) c=c->next;
-        suffix_object(c,item);
+        tail=c->prev?c->prev:c;
+        while (tail->next) tail=tail->next;
+        suffix_object(tail,item);
+        c->prev=item;
     }
+    index_added(array,item,1);
 }
 
 /*JOSNһԪ, ΪJSONԪ,ʽΪkey:value
   :object:JSON
   string: ӦԪصkey
   item: ӦԪصvalue  */
+//ͷitemԭļ(ͷ),ı־
+static void free_key(cJSON *item)
+{
+    if (!(item->type&cJSON_StringIsConst) && item->string) pool_free_string(&default_ctx,item->string,item->type&cJSON_StringIsPooled);
+    item->type&=~(cJSON_StringIsConst|cJSON_StringIsInterned|cJSON_StringIsPooled);
+}
+
 void   cJSON_AddItemToObject(cJSON *object,const char *string,cJSON *item)
 {
     if (!item) return;
-    if (item->string) cJSON_free(item->string);
-    item->string=cJSON_strdup(string);
+    free_key(item);
+    item->string=pool_strdup(string,item,cJSON_StringIsPooled);
     cJSON_AddItemToArray(object,item);
 }
 
 void   cJSON_AddItemToObjectCS(cJSON *object,const char *string,cJSON *item)
 {
     if (!item) return;
-    if (!(item->type&cJSON_StringIsConst) && item->string) cJSON_free(item->string);
+    free_key(item);
     item->string=(char*)string;
     item->type|=cJSON_StringIsConst;
     cJSON_AddItemToArray(object,item);
 }
+void   cJSON_AddItemToObjectInterned(cJSON *object,cJSON_KeyTable *keys,const char *string,cJSON *item)
+{
+    char *key;
+    if (!item) return;
+    if (!(key=(char*)cJSON_InternKey(keys,string))) {	//פʱ˻صƼ
+        cJSON_AddItemToObject(object,string,item);
+        return;
+    }
+    free_key(item);
+    item->string=key;
+    item->type|=cJSON_StringIsConst|cJSON_StringIsInterned;
+    cJSON_AddItemToArray(object,item);
+}
 void	cJSON_AddItemReferenceToArray(cJSON *array, cJSON *item)
 {
     cJSON_AddItemToArray(array,create_reference(item));
@@ -1076,17 +3689,39 @@ void	cJSON_AddItemReferenceToObject(cJSON *object,const char *string,cJSON *item
     cJSON_AddItemToObject(object,string,create_reference(item));
 }
 
+/* ӽڵcparentժ. עͷڵprevβڵ */
+static cJSON *detach_item(cJSON *parent,cJSON *c)
+{
+    index_removed(parent,c);
+    if (c!=parent->child) c->prev->next=c->next;
+    if (c->next) c->next->prev=c->prev;	//ժͷڵʱ,µͷڵ̳βָ
+    else if (c!=parent->child) parent->child->prev=c->prev;	//ժβڵʱβָ
+    if (c==parent->child) parent->child=c->next;
+    c->prev=c->next=0;
+    return c;
+}
+/* newitem滻parentӽڵc, ɾc */
+static void replace_item(cJSON *parent,cJSON *c,cJSON *newitem)
+{
+    index_removed(parent,c);
+    newitem->next=c->next;
+    newitem->prev=(c->prev==c)?newitem:c->prev;	//cΨһӽڵʱ,newitemԼβڵ
+    if (newitem->next) newitem->next->prev=newitem;
+    else if (c!=parent->child) parent->child->prev=newitem;	//滻βڵʱβָ
+    if (c==parent->child) parent->child=newitem;
+    else newitem->prev->next=newitem;
+    index_added(parent,newitem,0);
+
+    c->next=c->prev=0;
+    cJSON_Delete(c);
+}
+
 //JSONзwhichԪ(0)
 cJSON *cJSON_DetachItemFromArray(cJSON *array,int which)
 {
-    cJSON *c=array->child;
-    while (c && which>0) c=c->next,which--;
+    cJSON *c=cJSON_GetArrayItem(array,which);
     if (!c) return 0;
-    if (c->prev) c->prev->next=c->next;
-    if (c->next) c->next->prev=c->prev;
-    if (c==array->child) array->child=c->next;
-    c->prev=c->next=0;
-    return c;
+    return detach_item(array,c);
 }
 void   cJSON_DeleteItemFromArray(cJSON *array,int which)
 {
@@ -1095,57 +3730,62 @@ void   cJSON_DeleteItemFromArray(cJSON *array,int which)
 //JSONĶзΪstringԪ
 cJSON *cJSON_DetachItemFromObject(cJSON *object,const char *string)
 {
-    int i=0;
-    cJSON *c=object->child;
-    while (c && cJSON_strcasecmp(c->string,string)) i++,c=c->next;
-    if (c) return cJSON_DetachItemFromArray(object,i);
+    cJSON *c=cJSON_GetObjectItem(object,string);
+    if (c) return detach_item(object,c);
     return 0;
 }
 void   cJSON_DeleteItemFromObject(cJSON *object,const char *string)
 {
     cJSON_Delete(cJSON_DetachItemFromObject(object,string));
 }
+/* ָparentӽڵitem, Ҫٰ±(itemparentӽڵ) */
+cJSON *cJSON_DetachItemViaPointer(cJSON *parent,cJSON *item)
+{
+    if (!parent || !item) return 0;
+    return detach_item(parent,item);
+}
 
 /* JSONеwihchλòһԪ */
 void   cJSON_InsertItemInArray(cJSON *array,int which,cJSON *newitem)
 {
-    cJSON *c=array->child;
-    while (c && which>0) c=c->next,which--;
+    cJSON *c=cJSON_GetArrayItem(array,which);
     if (!c) {
         cJSON_AddItemToArray(array,newitem);
         return;
     }
     newitem->next=c;
-    newitem->prev=c->prev;
+    newitem->prev=c->prev;	//ͷʱnewitem̳βָ
     c->prev=newitem;
     if (c==array->child) array->child=newitem;
     else newitem->prev->next=newitem;
+    index_added(array,newitem,0);
 }
 /* Ԫ滻JSONwihchλõԪ */
 void   cJSON_ReplaceItemInArray(cJSON *array,int which,cJSON *newitem)
 {
-    cJSON *c=array->child;
-    while (c && which>0) c=c->next,which--;
+    cJSON *c=cJSON_GetArrayItem(array,which);
     if (!c) return;
-    newitem->next=c->next;
-    newitem->prev=c->prev;
-    if (newitem->next) newitem->next->prev=newitem;
-    if (c==array->child) array->child=newitem;
-    else newitem->prev->next=newitem;
-	
-    c->next=c->prev=0;
-    cJSON_Delete(c);
+    replace_item(array,c,newitem);
 }
 /* Ԫ滻JSONĶΪstringԪ */
 void   cJSON_ReplaceItemInObject(cJSON *object,const char *string,cJSON *newitem)
 {
-    int i=0;
-    cJSON *c=object->child;
-    while(c && cJSON_strcasecmp(c->string,string))i++,c=c->next;
+    cJSON *c=cJSON_GetObjectItem(object,string);
     if(c) {
-        newitem->string=cJSON_strdup(string);
-        cJSON_ReplaceItemInArray(object,i,newitem);
+        free_key(newitem);
+        newitem->string=pool_strdup(string,newitem,cJSON_StringIsPooled);
+        replace_item(object,c,newitem);
+    }
+}
+/* ָ滻parentӽڵitemɾitem. parentǶʱnewitemʹitemļ */
+void   cJSON_ReplaceItemViaPointer(cJSON *parent,cJSON *item,cJSON *newitem)
+{
+    if (!parent || !item || !newitem) return;
+    if ((parent->type&255)==cJSON_Object && item->string) {
+        free_key(newitem);
+        newitem->string=pool_strdup(item->string,newitem,cJSON_StringIsPooled);
     }
+    replace_item(parent,item,newitem);
 }
 
 /* ͵JSONCreate basic types: */
@@ -1173,13 +3813,31 @@ cJSON *cJSON_CreateBool(int b)
     if(item)item->type=b?cJSON_True:cJSON_False;
     return item;
 }
+//ͬʱvaluedouble,valueint64valueint. cJSON_SetIntValue/cJSON_SetNumberValueʹ
+double cJSON_SetNumberHelper(cJSON *object,double number)
+{
+    object->valuedouble=number;
+    object->valueint64=double_to_int64(number);
+    object->valueint=int64_to_int(object->valueint64);
+    return number;
+}
 cJSON *cJSON_CreateNumber(double num)
 {
     cJSON *item=cJSON_New_Item();
     if(item) {
         item->type=cJSON_Number;
-        item->valuedouble=num;
-        item->valueint=(int)num;
+        cJSON_SetNumberHelper(item,num);
+    }
+    return item;
+}
+cJSON *cJSON_CreateInt64(long long num)
+{
+    cJSON *item=cJSON_New_Item();
+    if(item) {
+        item->type=cJSON_Number;
+        item->valuedouble=(double)num;
+        item->valueint64=num;
+        item->valueint=int64_to_int(num);
     }
     return item;
 }
@@ -1188,7 +3846,7 @@ cJSON *cJSON_CreateString(const char *string)
     cJSON *item=cJSON_New_Item();
     if(item) {
         item->type=cJSON_String;
-        item->valuestring=cJSON_strdup(string);
+        item->valuestring=pool_strdup(string,item,cJSON_ValueIsPooled);
     }
     return item;
 }
@@ -1214,6 +3872,7 @@ cJSON *cJSON_CreateIntArray(const int *numbers,int count)
         else suffix_object(p,n);
         p=n;
     }
+    if (a && a->child) a->child->prev=n;
     return a;
 }
 cJSON *cJSON_CreateFloatArray(const float *numbers,int count)
@@ -1226,6 +3885,7 @@ cJSON *cJSON_CreateFloatArray(const float *numbers,int count)
         else suffix_object(p,n);
         p=n;
     }
+    if (a && a->child) a->child->prev=n;
     return a;
 }
 cJSON *cJSON_CreateDoubleArray(const double *numbers,int count)
@@ -1238,6 +3898,7 @@ cJSON *cJSON_CreateDoubleArray(const double *numbers,int count)
         else suffix_object(p,n);
         p=n;
     }
+    if (a && a->child) a->child->prev=n;
     return a;
 }
 cJSON *cJSON_CreateStringArray(const char **strings,int count)
@@ -1250,66 +3911,552 @@ cJSON *cJSON_CreateStringArray(const char **strings,int count)
         else suffix_object(p,n);
         p=n;
     }
+    if (a && a->child) a->child->prev=n;
     return a;
 }
 
-/* cJSON
-   : item: ҪƵcJSON
-         recurse:Ƿݹĸ. 0ʾݹĸ
-   ֵ:cJSONĸ*/
-cJSON *cJSON_Duplicate(cJSON *item,int recurse)
+/* item: ֵ,ԼԪؿ(recurse0ʱ). ӽڵ */
+static cJSON *duplicate_node(cJSON *item,int recurse)
 {
-    cJSON *newitem,*cptr,*nptr=0,*newchild;
-    /* Ч */
-    if (!item) return 0;
-    
-    newitem=cJSON_New_Item(); // Create new item 
+    cJSON *newitem=cJSON_New_Item(); // Create new item 
     if (!newitem) return 0;
 
 	/* еֵ*/
-    newitem->type=item->type&(~cJSON_IsReference),newitem->valueint=item->valueint,newitem->valuedouble=item->valuedouble;
+    newitem->type=item->type&(~(cJSON_IsReference|cJSON_StringIsConst|cJSON_StringIsInterned|cJSON_ValueIsConst|cJSON_IsArena|cJSON_StringIsPooled|cJSON_ValueIsPooled)),newitem->valueint=item->valueint,newitem->valuedouble=item->valuedouble,newitem->valueint64=item->valueint64;
     if (item->valuestring)	{
-        newitem->valuestring=cJSON_strdup(item->valuestring);
+        newitem->valuestring=pool_strdup(item->valuestring,newitem,cJSON_ValueIsPooled);
         if (!newitem->valuestring)	{
             cJSON_Delete(newitem);
             return 0;
         }
     }
     if (item->string)		{
-        newitem->string=cJSON_strdup(item->string);
+        newitem->string=pool_strdup(item->string,newitem,cJSON_StringIsPooled);
         if (!newitem->string)		{
             cJSON_Delete(newitem);
             return 0;
         }
     }
+    if (recurse && item->extra && item->extra->packed && !copy_packed(newitem,item)) {	//ûӽڵ,Ԫؿ
+        cJSON_Delete(newitem);
+        return 0;
+    }
+    return newitem;
+}
+
+/* cJSON
+   : item: ҪƵcJSON
+         recurse:Ƿݹĸ. 0ʾݹĸ
+   ֵ:cJSONĸ
+   ݹĸƲʹõݹ: ڸƵѹʽջ,ľջ */
+cJSON *cJSON_Duplicate(cJSON *item,int recurse)
+{
+    walk_stack st;
+    walk_frame *f;
+    cJSON *root,*newitem;
+    /* Ч */
+    if (!item) return 0;
+    if (!(root=newitem=duplicate_node(item,recurse))) return 0;
     /* ǵݹ,ôǾ */
-    if (!recurse) return newitem;
+    if (!recurse) return root;
 
-	/* Walk the ->next chain for the child. */
-    cptr=item->child;
-    while (cptr) {
-        newchild=cJSON_Duplicate(cptr,1);		/* Duplicate (with recurse) each item in the ->next chain */
-        if (!newchild) {
-            cJSON_Delete(newitem);
-            return 0;
+    walk_init(&st,&default_ctx);
+    for (;;) {
+        /* newitemitemĸ: ӽڵʱתȥӽڵ */
+        if (!(item->extra && item->extra->packed)) {
+            if (!cJSON_Expand(item)) goto fail;
+            if (item->child) {
+                if (!(f=walk_push(&st,newitem))) goto fail;
+                f->child=item->child;
+            }
         }
-        if (nptr)	{
-            nptr->next=newchild,newchild->prev=nptr;    /* If newitem->child already set, then crosswire ->prev and ->next and move on */
-            nptr=newchild;
-        } else		{
-            newitem->child=newchild;    /* Set newitem->child and move to it */
-            nptr=newchild;
+        /* һҪƵĽڵ: ջһûƵӽڵ */
+        while (st.depth && !st.frames[st.depth-1].child) {
+            f=&st.frames[--st.depth];
+            f->node->child->prev=f->last;	//ͷڵprevָβڵ
         }
-        cptr=cptr->next;
+        if (!st.depth) break;
+        f=&st.frames[st.depth-1];
+        item=f->child;
+        f->child=item->next;
+        if (!(newitem=duplicate_node(item,1))) goto fail;
+        if (f->last) f->last->next=newitem,newitem->prev=f->last;
+        else f->node->child=newitem;
+        f->last=newitem;
     }
-    return newitem;
+    walk_free(&st);
+    return root;
+
+fail:
+    walk_free(&st);
+    cJSON_Delete(root);
+    return 0;
+}
+
+/* Ƹʽ: CBOR(RFC 8949). ֱֶʽ(ñ䳤ͷ,float32/float64),ַǰ׺,
+   Ҫʮ֮ת,ҲҪת. Ͷʹöʽ.
+   ΪRFC 8746ͻ(ǩ79:Сsint64, 86:Сfloat64),Ԫؿԭ */
+#define CBOR_TAG_INT64LE 79
+#define CBOR_TAG_FLOAT64LE 86
+#define CBOR_INDEF ((size_t)-1)	//ʱ/ʣԪظ
+
+static int little_endian(void)
+{
+    unsigned short x=1;
+    return *(unsigned char*)&x;
+}
+
+/* CBORͷ: major(0..7)Ͳv, ʹ̵ʽ */
+static int cbor_head(printbuffer *p,int major,unsigned long long v)
+{
+    unsigned char *out=(unsigned char*)ensure(p,9);
+    int n,i;
+    if (!out) return 0;
+    major<<=5;
+    if (v<24) {out[0]=(unsigned char)(major|v);p->offset++;return 1;}
+    if (v<=0xFF) out[0]=major|24,n=1;
+    else if (v<=0xFFFF) out[0]=major|25,n=2;
+    else if (v<=0xFFFFFFFFULL) out[0]=major|26,n=4;
+    else out[0]=major|27,n=8;
+    for (i=n; i>0; i--,v>>=8) out[i]=(unsigned char)v;
+    p->offset+=n+1;
+    return 1;
+}
+
+/* : ıΪ(number_as_int64)ΪCBOR, ܾȷʾʱfloat32, float64 */
+static int cbor_number(cJSON *item,printbuffer *p)
+{
+    double d=item->valuedouble;
+    float f=(float)d;
+    unsigned long long bits;
+    unsigned char *out;
+    long long v;
+    int i,n;
+
+    if (number_as_int64(item,&v)) return v<0?cbor_head(p,1,(unsigned long long)(-1-v)):cbor_head(p,0,(unsigned long long)v);
+    if (!(out=(unsigned char*)ensure(p,9))) return 0;
+    if ((double)f==d) {
+        unsigned u;
+        memcpy(&u,&f,4);
+        bits=u,n=4,out[0]=0xFA;
+    } else memcpy(&bits,&d,8),n=8,out[0]=0xFB;
+    for (i=n; i>0; i--,bits>>=8) out[i]=(unsigned char)bits;
+    p->offset+=n+1;
+    return 1;
+}
+
+static int cbor_string(const char *str,printbuffer *p)
+{
+    size_t len=strlen(str);
+    return cbor_head(p,3,len) && print_raw(p,str,(int)len);
+}
+
+/* : ǩ+ֽڴ,С˵Ԫؿ */
+static int cbor_packed(cJSON *item,printbuffer *p)
+{
+    const unsigned char *src=(const unsigned char*)cJSON_GetNumberArrayData(item,0);
+    int n=item->extra->count,i,j,k;
+    char *out;
+
+    if (!cbor_head(p,6,src?CBOR_TAG_FLOAT64LE:CBOR_TAG_INT64LE)) return 0;
+    if (!src) src=(const unsigned char*)cJSON_GetInt64ArrayData(item,0);
+    if (!cbor_head(p,2,(unsigned long long)n*8)) return 0;
+    for (i=0; i<n; i+=k) {	//ֿд,ʽʱػԪؿ
+        k=n-i<512?n-i:512;
+        if (!(out=ensure(p,k*8))) return 0;
+        if (little_endian()) memcpy(out,src+(size_t)i*8,(size_t)k*8);
+        else for (j=0; j<k*8; j++) out[j]=src[(size_t)i*8+(j&~7)+7-(j&7)];
+        p->offset+=k*8;
+    }
+    return 1;
+}
+
+/* print_valueCBOR汾, ͬʹʽջݹ */
+static int print_binary(cJSON *item,printbuffer *p)
+{
+    walk_stack st;
+    walk_frame *f;
+    cJSON *c;
+    int n,ok=0;
+
+    walk_init(&st,p->ctx);
+    for (;;) {
+        if (!item) goto done;
+        switch ((item->type)&255) {
+            case cJSON_NULL:	if (!cbor_head(p,7,22)) goto done;
+                                break;
+            case cJSON_False:	if (!cbor_head(p,7,20)) goto done;
+                                break;
+            case cJSON_True:	if (!cbor_head(p,7,21)) goto done;
+                                break;
+            case cJSON_Number:	if (!cbor_number(item,p)) goto done;
+                                break;
+            case cJSON_String:	if (!cbor_string(item->valuestring?item->valuestring:"",p)) goto done;
+                                break;
+            case cJSON_Array:
+                if (cJSON_GetPackedType(item)) {
+                    if (!cbor_packed(item,p)) goto done;
+                    break;
+                }
+                if (!cJSON_Expand(item) || !cbor_head(p,4,cJSON_GetArraySize(item))) goto done;
+                if (item->child) {
+                    if (!(f=walk_push(&st,item))) goto done;
+                    f->child=item->child;
+                }
+                break;
+            case cJSON_Object:
+                if (!cJSON_Expand(item)) goto done;
+                for (n=0,c=item->child; c; c=c->next) n++;
+                if (!cbor_head(p,5,n)) goto done;
+                if (item->child) {
+                    if (!(f=walk_push(&st,item))) goto done;
+                    f->child=item->child;
+                }
+                break;
+            default: goto done;
+        }
+        /* һҪֵ: ջһԪ(Ԫ) */
+        while (st.depth && !st.frames[st.depth-1].child) st.depth--;
+        if (!st.depth) break;
+        f=&st.frames[st.depth-1];
+        item=f->child;
+        f->child=item->next;
+        if ((f->node->type&255)==cJSON_Object && !cbor_string(item->string?item->string:"",p)) goto done;
+    }
+    ok=1;
+done:
+    walk_free(&st);
+    return ok;
+}
+
+/* ʹctxķ亯itemΪCBOR,д*length */
+char *cJSON_PrintBinaryCtx(cJSON_Context *ctx,cJSON *item,size_t *length)
+{
+    printbuffer p;
+    p.buffer=(char*)ctx->malloc_fn(PRINT_DEFAULT_BUFFER);
+    if (!p.buffer) return 0;
+    p.length=PRINT_DEFAULT_BUFFER;
+    p.offset=0;
+    p.ctx=ctx;
+    p.write_fn=0;
+    p.user=0;
+    p.fixed=0;
+    if (!print_binary(item,&p)) {
+        if (p.buffer) ctx->free_fn(p.buffer);
+        return 0;
+    }
+    if (length) *length=(size_t)p.offset;
+    return p.buffer;
+}
+char *cJSON_PrintBinary(cJSON *item,size_t *length)
+{
+    return cJSON_PrintBinaryCtx(&default_ctx,item,length);
+}
+
+/* ʽCBOR, ͬcJSON_PrintToWriter */
+int cJSON_PrintBinaryToWriter(cJSON *item,cJSON_WriteFn write_fn,void *user,int chunk_size)
+{
+    printbuffer p;
+    int ok;
+    if (!write_fn) return 0;
+    if (chunk_size<=0) chunk_size=4096;
+    if (chunk_size<16) chunk_size=16;	//ͷҪһд9ֽ
+    p.buffer=(char*)cJSON_malloc(chunk_size);
+    if (!p.buffer) return 0;
+    p.length=chunk_size;
+    p.offset=0;
+    p.ctx=&default_ctx;
+    p.write_fn=write_fn;
+    p.user=user;
+    p.fixed=0;
+    ok=print_binary(item,&p);
+    if (ok && p.offset) ok=write_fn(user,p.buffer,p.offset)!=0;
+    if (p.buffer) cJSON_free(p.buffer);
+    return ok;
+}
+
+/* CBORͷ: д*major,Ϣд*info,д*v(Ϣ24..27ʱӺ1/2/4/8ֽڶ).
+   ͷ֮λ,ʧܷ0 */
+static const unsigned char *cbor_read_head(cJSON_Context *ctx,const unsigned char *ptr,const unsigned char *end,int *major,int *info,unsigned long long *v)
+{
+    int n,i;
+    if (ptr>=end) {ctx->error=(const char*)ptr;return 0;}	//ݲ
+    *major=*ptr>>5;
+    *info=*ptr&31;
+    *v=(unsigned long long)*info;
+    if (*info<24 || *info==31) return ptr+1;
+    n=*info<28?1<<(*info-24):0;
+    if (!n || end-ptr-1<n) {ctx->error=(const char*)ptr;return 0;}	//ĸϢ28..30,ݲ
+    for (*v=0,i=1; i<=n; i++) *v=(*v<<8)|ptr[i];
+    return ptr+1+n;
+}
+
+//ı(ֵַ),ctx. keysΪ0ʱפkeys
+static const unsigned char *cbor_read_text(cJSON_Context *ctx,const unsigned char *ptr,const unsigned char *end,char **out,cJSON_KeyTable *keys)
+{
+    const unsigned char *start=ptr;
+    unsigned long long len;
+    int major,info;
+    if (!(ptr=cbor_read_head(ctx,ptr,end,&major,&info,&len))) return 0;
+    if (major!=3 || info==31 || len>(unsigned long long)(end-ptr)) {ctx->error=(const char*)start;return 0;}	//ı,Ĵ,ݲ
+    if (keys) return (*out=key_intern(keys,(const char*)ptr,(size_t)len))?ptr+len:0;
+    if (!(*out=(char*)parse_malloc(ctx,(size_t)len+1))) return 0;
+    memcpy(*out,ptr,(size_t)len);
+    (*out)[len]=0;
+    return ptr+len;
+}
+
+//CBOR(negative:1,ֵΪ-1-v)дitem
+static void cbor_integer(cJSON *item,unsigned long long v,int negative)
+{
+    item->type=cJSON_Number;
+    if (v>(unsigned long long)LLONG_MAX) {	//long longķΧ,ֻdoubleʾ
+        cJSON_SetNumberHelper(item,negative?-1.0-(double)v:(double)v);
+        return;
+    }
+    item->valueint64=negative?-1-(long long)v:(long long)v;
+    item->valuedouble=(double)item->valueint64;
+    item->valueint=int64_to_int(item->valueint64);
+}
+
+//뾫ȸ(IEEE 754 binary16)
+static double half_to_double(unsigned h)
+{
+    int e=(h>>10)&31;
+    double m=h&1023,d;
+    if (!e) d=ldexp(m,-24);
+    else if (e==31) d=m?NAN:INFINITY;
+    else d=ldexp(m+1024,e-25);
+    return (h&0x8000)?-d:d;
+}
+
+/* ͻ(RFC 8746): ֽڴcountС˵long long(typeΪcJSON_PackedInt64)double.
+   arenaʱֱӳΪ,չӽڵ */
+static const unsigned char *cbor_typed_array(cJSON_Context *ctx,cJSON *item,const unsigned char *ptr,const unsigned char *end,int type)
+{
+    const unsigned char *start=ptr;
+    unsigned long long len;
+    int major,info,i,j,n;
+    unsigned char *dst;
+    cJSON *child,*last=0;
+
+    if (!(ptr=cbor_read_head(ctx,ptr,end,&major,&info,&len))) return 0;
+    if (major!=2 || info==31 || len%8 || len>(unsigned long long)(end-ptr)) {ctx->error=(const char*)start;return 0;}
+    n=(int)(len/8);
+    item->type=cJSON_Array;
+    if (!n) return ptr;
+    if (!ctx->arena) {
+        cJSON_Extra *x=get_extra(item,ctx);
+        if (!x || !(x->packed=ctx->malloc_fn((size_t)len))) return 0;
+        dst=(unsigned char*)x->packed;
+        if (little_endian()) memcpy(dst,ptr,(size_t)len);
+        else for (j=0; j<(int)len; j++) dst[j]=ptr[(j&~7)+7-(j&7)];
+        x->packed_type=type;
+        x->count=n;
+        return ptr+len;
+    }
+    for (i=0; i<n; i++,ptr+=8) {
+        unsigned long long bits=0;
+        if (!(child=parse_New_Item(ctx))) return 0;
+        if (last) last->next=child,child->prev=last;
+        else item->child=child;
+        last=child;
+        for (j=7; j>=0; j--) bits=(bits<<8)|ptr[j];
+        child->type=cJSON_Number|cJSON_IsArena|cJSON_StringIsConst|cJSON_ValueIsConst;
+        if (type==cJSON_PackedInt64) {
+            long long v;
+            memcpy(&v,&bits,8);
+            child->valuedouble=(double)v;
+            child->valueint64=v;
+            child->valueint=int64_to_int(v);
+        } else {
+            double d;
+            memcpy(&d,&bits,8);
+            cJSON_SetNumberHelper(child,d);
+        }
+    }
+    close_array(ctx,item,last,n);
+    return ptr;
+}
+
+/* һCBORֵͷͱ. ǩ(ͻ), undefinednull.
+   ֽڴֵJSONûжӦ,ʧ.
+   (major 4)/(major 5)ֻͷ: *leftΪԪظ(ʱΪCBOR_INDEF), Ԫparse_binaryȡ.
+   ֵ*leftΪ0. depth:itemڵǶײ */
+static const unsigned char *parse_binary_type(cJSON_Context *ctx,cJSON *item,const unsigned char *ptr,const unsigned char *end,int depth,size_t *left)
+{
+    const unsigned char *start;
+    unsigned long long v;
+    int major,info;
+
+    *left=0;
+    for (;;) {
+        start=ptr;
+        if (!(ptr=cbor_read_head(ctx,ptr,end,&major,&info,&v))) return 0;
+        if (major!=6) break;
+        if (v==CBOR_TAG_INT64LE) return cbor_typed_array(ctx,item,ptr,end,cJSON_PackedInt64);
+        if (v==CBOR_TAG_FLOAT64LE) return cbor_typed_array(ctx,item,ptr,end,cJSON_PackedDouble);
+    }
+    if (info==31 && major!=4 && major!=5) {ctx->error=(const char*)start;return 0;}	//ֲֻ֧Ͷ
+    switch (major) {
+        case 0: case 1:
+            cbor_integer(item,v,major);
+            return ptr;
+        case 3:
+            if (!(ptr=cbor_read_text(ctx,start,end,&item->valuestring,0))) return 0;
+            item->type=cJSON_String;
+            return ptr;
+        case 4: case 5:
+            if (ctx->max_depth>0 && depth>=ctx->max_depth) break;	//Ƕ׹
+            if (info!=31 && v>(unsigned long long)(end-ptr)) {ctx->error=(const char*)ptr;return 0;}	//ÿԪ1ֽ: ݲ
+            item->type=major==5?cJSON_Object:cJSON_Array;
+            *left=info==31?CBOR_INDEF:(size_t)v;
+            return ptr;
+        case 7:
+            if (info==25) {cJSON_SetNumberHelper(item,half_to_double((unsigned)v));item->type=cJSON_Number;return ptr;}
+            if (info==26) {
+                unsigned u=(unsigned)v;
+                float f;
+                memcpy(&f,&u,4);
+                cJSON_SetNumberHelper(item,f);
+                item->type=cJSON_Number;
+                return ptr;
+            }
+            if (info==27) {
+                double d;
+                memcpy(&d,&v,8);
+                cJSON_SetNumberHelper(item,d);
+                item->type=cJSON_Number;
+                return ptr;
+            }
+            if (info>=24) break;
+            if (v==20) {item->type=cJSON_False;return ptr;}
+            if (v==21) {item->type=cJSON_True;item->valueint=1;return ptr;}
+            if (v==22 || v==23) {item->type=cJSON_NULL;return ptr;}
+            break;
+    }
+    ctx->error=(const char*)start;
+    return 0;
+}
+
+/* parse_valueCBOR汾: ͬʽջݹ,Ƕײctx->max_depth */
+static const unsigned char *parse_binary(cJSON_Context *ctx,cJSON *item,const unsigned char *ptr,const unsigned char *end,int depth)
+{
+    walk_stack st;
+    walk_frame *f;
+    cJSON *child;
+    size_t left;
+
+    walk_init(&st,ctx);
+next_value:
+    if (!(ptr=parse_binary_type(ctx,item,ptr,end,depth+st.depth,&left))) goto fail;
+    if (left) {
+        if (!(f=walk_push(&st,item))) goto fail;
+        f->left=left;
+        goto next_member;
+    }
+
+value_done:	//item
+    if (ctx->arena) item->type|=cJSON_IsArena|cJSON_StringIsConst|cJSON_ValueIsConst;	//ͬparse_value
+    if (ctx->keys && item->string) item->type|=cJSON_StringIsConst|cJSON_StringIsInterned;
+    if (!st.depth) {
+        walk_free(&st);
+        return ptr;
+    }
+
+next_member:	//ջһԪ, ûʱ
+    f=&st.frames[st.depth-1];
+    if (f->left==CBOR_INDEF) {
+        if (ptr>=end) {ctx->error=(const char*)ptr;goto fail;}
+        if (*ptr==0xFF) {ptr++;goto close;}
+    } else if (!f->left) goto close;
+    else f->left--;
+    if (!(child=parse_New_Item(ctx))) goto fail;
+    if (f->last) f->last->next=child,child->prev=f->last;
+    else f->node->child=child;
+    f->last=child;
+    f->n++;
+    if ((f->node->type&255)==cJSON_Object && !(ptr=cbor_read_text(ctx,ptr,end,&child->string,ctx->keys))) goto fail;	//JSONļַֻ
+    item=child;
+    goto next_value;
+
+close:
+    if ((f->node->type&255)==cJSON_Object) close_object(ctx,f->node,f->last,f->n);
+    else close_array(ctx,f->node,f->last,f->n);
+    item=f->node;
+    st.depth--;
+    goto value_done;
+
+fail:
+    walk_free(&st);
+    return 0;
 }
 
+/* [data,data+length)еһCBORֵ. ctxķ亯arenaǶײƺcJSON_OptRequireNullTerminated
+   (ʾֵ֮)ͬcJSON_ParseWithLengthCtx. λñctx->error */
+cJSON *cJSON_ParseBinaryCtx(cJSON_Context *ctx,const char *data,size_t length,const char **return_parse_end)
+{
+    const unsigned char *ptr=(const unsigned char*)data,*end=ptr+length;
+    cJSON *c;
+    ctx->error=0;
+    if (!data) return 0;
+    if (!(c=parse_New_Item(ctx))) return 0;
+    ptr=parse_binary(ctx,c,ptr,end,0);
+    if (ptr && (ctx->options&cJSON_OptRequireNullTerminated) && ptr<end) ctx->error=(const char*)ptr,ptr=0;
+    if (!ptr) {
+        if (!ctx->arena) cJSON_DeleteCtx(ctx,c);
+        return 0;
+    }
+    if (return_parse_end) *return_parse_end=(const char*)ptr;
+    return c;
+}
+cJSON *cJSON_ParseBinary(const char *data,size_t length)
+{
+    cJSON_Context ctx=default_ctx;
+    cJSON *c=cJSON_ParseBinaryCtx(&ctx,data,length,0);
+    default_ctx.error=ctx.error;
+    return c;
+}
+
+#ifdef CJSON_SIMD
+/* cJSON_Minify: Ѵjsonʼһ'"','/''\0'Ϊֹȥհ׺Ƶ*into,
+   ͣµλ. ÿδһ */
+static char *minify_plain(char *json,char **into)
+{
+    char *out=*into;
+    for (;;) {
+        const char *blk=SIMD_BLOCK(json);
+        unsigned long long ws,range,keep,special=minify_mask(blk,&ws)&SIMD_FROM(json);
+        int stop=special?ctz64(special)/SIMD_BITS:SIMD_WIDTH;	//Ҫλ
+        range=SIMD_FROM(json);					//[json,stop)Ӧλ
+        if (stop<SIMD_WIDTH) range&=~(~0ULL<<(stop*SIMD_BITS));
+        keep=range&~ws;							//еķǿհַ
+        if (keep==range) {						//ûпհ: ƶ
+            size_t n=(size_t)(blk+stop-json);
+            if (out!=json) memmove(out,json,n);
+            out+=n;
+        }
+        else while (keep) {
+            *out++=blk[ctz64(keep)/SIMD_BITS];
+            keep&=keep-1;
+        }
+        json=(char*)blk+stop;
+        if (stop<SIMD_WIDTH) break;
+    }
+    *into=out;
+    return json;
+}
+#endif
+
 //JSONı(ȥհַע)
 void cJSON_Minify(char *json)
 {
     char *into=json;
     while (*json) {
+#ifdef CJSON_SIMD
+        json=minify_plain(json,&into);	//հַַͨ鴦
+        if (!*json) break;
+#endif
         if (*json==' ') json++;
         else if (*json=='\t') json++;	/* հַ. */
         else if (*json=='\r') json++;
@@ -1317,13 +4464,21 @@ void cJSON_Minify(char *json)
         else if (*json=='/' && json[1]=='/')  while (*json && *json!='\n') json++;	/* ˫бע,н. */
         else if (*json=='/' && json[1]=='*') {
             while (*json && !(*json=='*' && json[1]=='/')) json++;    /* ע. */
-            json+=2;
+            if (*json) json+=2;
         } else if (*json=='\"') {
             *into++=*json++;    /* ֵַ,\  */
             while (*json && *json!='\"') {
-                if (*json=='\\') *into++=*json++;
+                const char *run=scan_string(json);	//θַͨ
+                if (run!=json) {
+                    memmove(into,json,run-json);
+                    into+=run-json;
+                    json=(char*)run;
+                    continue;
+                }
+                if (*json=='\\' && json[1]) *into++=*json++;
                 *into++=*json++;
-            }*into++=*json++;
+            }
+            if (*json) *into++=*json++;
         } else *into++=*json++;			/* All other characters. */
     }
     *into=0;	/* and null-terminate. */
@@ -23,6 +23,8 @@
 #ifndef cJSON__h
 #define cJSON__h
 
+#include <stdio.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -39,13 +41,19 @@ extern "C"
 	
 #define cJSON_IsReference 256
 #define cJSON_StringIsConst 512
+#define cJSON_IsArena 1024			/* ڵ㱾cJSON_Arena,cJSON_ArenaReset/cJSON_ArenaDeleteͳһͷ */
+#define cJSON_ValueIsConst 2048		/* valuestringڸýڵ,cJSON_Deleteͷ */
+#define cJSON_StringIsInterned 4096	/* stringcJSON_KeyTableפļ(ͬʱcJSON_StringIsConst) */
+#define cJSON_StringIsPooled 8192	/* stringǽڵеĿ(ֻCJSON_POOL_STRINGS). Լ滻stringʱҪ־ */
+#define cJSON_ValueIsPooled 16384	/* valuestringǽڵеĿ(ֻCJSON_POOL_STRINGS). Լ滻valuestringʱҪ־ */
 
 /* ṹJSONԪͣ
    JSONͶǶ,JSON()ԪصĹϵṹеĸӹϵ
    ͨnext,prev,childνṹ[{x:{...}, y:{y1:{..}, y2:yy2}}, string, [..], 5]
 /* The cJSON structure: */
 typedef struct cJSON {
-	struct cJSON *next,*prev;	/* next/prevֵܽõ˫Alternatively, use GetArraySize/GetArrayItem/GetObjectItem */
+	struct cJSON *next,*prev;	/* next/prevֵܽõ˫ͷڵprevָβڵ㡣Alternatively, use GetArraySize/GetArrayItem/GetObjectItem
+					   ֹ޸м䲿ֺҪcJSON_ResetIndex(README) */
 	struct cJSON *child;		/*ӶָӶ˫ͷ*/
 
 	int type;					/* ָʾcJSONԪص. */
@@ -53,8 +61,11 @@ typedef struct cJSON {
 	char *valuestring;			/* type==cJSON_String˵cJSONԪصΪstring,ʱֶЧ */
 	int valueint;				/* type==cJSON_Number˵cJSONԪصΪnumber,ʱֶЧ */
 	double valuedouble;			/* type==cJSON_Number˵cJSONԪصΪnumber,ʱֶЧ */
+	long long valueint64;		/* number64λֵıȷ,ֵvaluedoubleͽضϵõ */
 
 	char *string;	/*ýڵһJSONԪʱ,ʾԪص():{"name":"Jack\", "age": 24}ԪصֱַΪname,ageJSONʱЧ,JSONԪû */
+
+	struct cJSON_Extra *extra;	/* ڲʹ:/轨ĲҪֱ޸ */
 } cJSON;
 
 typedef struct cJSON_Hooks {
@@ -65,6 +76,185 @@ typedef struct cJSON_Hooks {
 /* Supply malloc, realloc and free functions to cJSON */
 extern void cJSON_InitHooks(cJSON_Hooks* hooks);
 
+/* Node pool. With the default hooks, cJSON_Delete keeps up to CJSON_POOL_LIMIT freed nodes on a per-thread free list
+   that the next allocations reuse. Built with CJSON_POOL_STRINGS it also keeps as many strings of each size class
+   (16, 32, 64 bytes) made by the Create/Add/Duplicate calls; such a build must clear cJSON_StringIsPooled or
+   cJSON_ValueIsPooled when it swaps a node's string for its own. Pooled blocks are ordinary blocks from the hooks,
+   so a tree may be freed on any thread.
+   cJSON_PoolFlush returns the calling thread's cached blocks to the hooks; call it before a thread exits (and
+   cJSON_InitHooks does it for the calling thread). Build with CJSON_NO_POOL to disable the pool. */
+extern void cJSON_PoolFlush(void);
+
+/* Hot-path counters, for watching a build in production. They are compiled in only with -DCJSON_ENABLE_COUNTERS
+   (each count is then a relaxed atomic add with GCC/Clang, a plain add elsewhere); otherwise cJSON_GetCounters
+   reports zeros. Counts are process-wide, summed over all threads since start or the last cJSON_ResetCounters. */
+typedef struct cJSON_Counters {
+	unsigned long long nodes;		/* cJSON nodes allocated (from the pool, the hooks or an arena) */
+	unsigned long long bytes_copied;	/* bytes copied into new strings, and moved by print-buffer regrowth */
+	unsigned long long ensure_grows;	/* print-buffer regrowths */
+	unsigned long long lookups;		/* cJSON_GetObjectItem*, cJSON_GetArrayItem calls */
+	unsigned long long lookup_steps;	/* children stepped over walking the child list (0 for an indexed lookup) */
+} cJSON_Counters;
+extern void cJSON_GetCounters(cJSON_Counters *out);
+extern void cJSON_ResetCounters(void);
+
+/* A bump-pointer arena. Nodes and strings parsed into it are carved out of large chunks,
+   and every tree parsed into the arena is released at once by cJSON_ArenaReset. */
+typedef struct cJSON_Arena cJSON_Arena;
+
+/* Create an arena that grows in chunks of chunk_size bytes (0 picks a default). */
+extern cJSON_Arena *cJSON_ArenaCreate(size_t chunk_size);
+/* Release every tree parsed into the arena. The chunks are kept for the next parse. */
+extern void cJSON_ArenaReset(cJSON_Arena *arena);
+/* Release the arena and all its chunks. */
+extern void cJSON_ArenaDelete(cJSON_Arena *arena);
+/* Parse into the arena. The tree lives until the arena is reset; cJSON_Delete on it is not needed
+   (it only frees items you attached to the tree yourself). */
+extern cJSON *cJSON_ParseInArena(cJSON_Arena *arena,const char *value);
+
+/* Options for cJSON_Context.options */
+#define cJSON_OptRequireNullTerminated 1	/* Fail if anything but whitespace follows the parsed value. */
+#define cJSON_OptIndexObjects 2			/* Build the key index of large objects while parsing instead of on first lookup. */
+#define cJSON_OptPackNumbers 4			/* Store arrays of only numbers packed (see cJSON_CreatePackedDoubleArray). Ignored with an arena. */
+
+typedef struct cJSON_KeyTable cJSON_KeyTable;
+
+/* Per-parser state: allocator, error position, limits and options. One context per thread lets
+   every thread parse and print independently with its own allocator. */
+typedef struct cJSON_Context {
+	void *(*malloc_fn)(size_t sz);
+	void (*free_fn)(void *ptr);
+	cJSON_Arena *arena;		/* When set, parsed trees are allocated from this arena. */
+	const char *error;		/* Position of the parse error after a failed cJSON_ParseCtx, 0 after success. */
+	int max_depth;			/* Nesting limit for arrays/objects, <=0 means unlimited. Failing input stops at the bracket
+						   that is too deep. The tree parsers and printers use no stack per level; cJSON_ParseSax does. */
+	int options;			/* cJSON_Opt* flags. */
+	cJSON_KeyTable *keys;	/* When set, object keys are interned here (see cJSON_KeyTableCreate). */
+} cJSON_Context;
+
+/* Fill ctx with the current hooks, no arena, the default nesting limit, no options and no key table. */
+extern void cJSON_InitContext(cJSON_Context *ctx);
+/* Like cJSON_ParseWithOpts, but allocates through ctx and reports errors in ctx->error. */
+extern cJSON *cJSON_ParseCtx(cJSON_Context *ctx,const char *value,const char **return_parse_end);
+/* cJSON_ParseWithLength through ctx. */
+extern cJSON *cJSON_ParseWithLengthCtx(cJSON_Context *ctx,const char *value,size_t length,const char **return_parse_end);
+/* Render using ctx's allocator. Release the result with ctx->free_fn. */
+extern char  *cJSON_PrintCtx(cJSON_Context *ctx,cJSON *item,int fmt);
+/* Delete a tree that was parsed with ctx. */
+extern void   cJSON_DeleteCtx(cJSON_Context *ctx,cJSON *c);
+/* Key interning, for documents that repeat the same keys (arrays of records). With ctx->keys set, every object key
+   the parser meets is looked up in the table and the node points to the one shared copy, flagged
+   cJSON_StringIsConst|cJSON_StringIsInterned, instead of owning a malloc'd one. Interned keys carry their hash, so
+   indexing an object doesn't rehash them, and a lookup with an interned pointer matches by pointer.
+   The table only grows; delete it after every tree that uses it. It isn't thread-safe: give each thread its own
+   (cJSON_BatchCreate ignores ctx->keys for that reason). */
+extern cJSON_KeyTable *cJSON_KeyTableCreate(cJSON_Context *ctx);	/* ctx (may be 0) supplies the allocator */
+extern void cJSON_KeyTableDelete(cJSON_KeyTable *keys);
+/* The shared copy of key, added if new. 0 when out of memory. */
+extern const char *cJSON_InternKey(cJSON_KeyTable *keys,const char *key);
+/* cJSON_AddItemToObject with an interned key instead of a strdup'd one. */
+extern void cJSON_AddItemToObjectInterned(cJSON *object,cJSON_KeyTable *keys,const char *string,cJSON *item);
+
+/* In-situ parsing: strings and keys are unescaped in place inside json, and the nodes point into it instead of
+   owning a copy (flagged cJSON_ValueIsConst/cJSON_StringIsConst, so cJSON_Delete leaves them alone).
+   json is modified, and must stay alive and unchanged until the tree is deleted. */
+extern cJSON *cJSON_ParseInSitu(char *json);
+extern cJSON *cJSON_ParseInSituCtx(cJSON_Context *ctx,char *json,const char **return_parse_end);
+
+/* Event (SAX) parsing: the parser calls back for every value and builds no tree.
+   Each callback returns non-zero to go on, 0 to stop the parse; a 0 pointer means the event is ignored.
+   key/string get a pointer+length view. With no escapes it points into the input and is NOT '\0'-terminated;
+   otherwise it points to a decoded copy. Either way it's only valid during the callback.
+   number gets the double and, for integer literals, the exact 64-bit value (as in valueint64); an integer literal out
+   of the long long range saturates to LLONG_MIN/LLONG_MAX, which a literal of exactly that value also gives. Set
+   integer (the last member, so older initializers leave it 0) to tell them apart: integer literals that fit a long
+   long (no fraction, no exponent) then go to integer with their exact value, and number gets all the others. */
+typedef struct cJSON_SaxHandler {
+	int (*null_value)(void *user);
+	int (*boolean)(void *user,int value);
+	int (*number)(void *user,double value,long long value64);
+	int (*string)(void *user,const char *str,size_t len);
+	int (*key)(void *user,const char *str,size_t len);
+	int (*start_object)(void *user);
+	int (*end_object)(void *user);
+	int (*start_array)(void *user);
+	int (*end_array)(void *user);
+	int (*integer)(void *user,long long value);
+} cJSON_SaxHandler;
+/* Parse value, invoking h with user as first argument. ctx (may be 0) supplies max_depth, the allocator for decoded
+   strings and cJSON_OptRequireNullTerminated; errors go to ctx->error, or to cJSON_GetErrorPtr() when ctx is 0.
+   Returns 1 on success, 0 on a syntax error or when a callback stopped the parse. */
+extern int cJSON_ParseSax(cJSON_Context *ctx,const char *value,const cJSON_SaxHandler *h,void *user,const char **return_parse_end);
+/* cJSON_ParseSax over exactly length bytes, as with cJSON_ParseWithLength. */
+extern int cJSON_ParseSaxWithLength(cJSON_Context *ctx,const char *value,size_t length,const cJSON_SaxHandler *h,void *user,const char **return_parse_end);
+
+/* Lazy parsing, for reading a few values out of a big document. Parsing only scans the structure (strings and
+   brackets) and records where every array and object starts and ends; it builds the root alone. An array's or
+   object's children are built the first time it's accessed through the API (GetObjectItem, GetArrayItem, GetArraySize,
+   Print, cJSON_ArrayForEach, ...), one level at a time: keys and scalar values are parsed then, nested arrays and
+   objects are skipped and stay unbuilt. Subtrees you never touch cost only the scan.
+   value must stay alive and unchanged until the tree is deleted. Brackets and strings are checked up front; any other
+   syntax error surfaces when the enclosing value is expanded: the access fails (GetObjectItem returns 0, Print returns 0)
+   and cJSON_GetErrorPtr() points at the error. Expanding changes the tree, so a lazy tree must not be read from two
+   threads at once. Delete it with cJSON_Delete, or cJSON_DeleteCtx for cJSON_ParseLazyCtx (arena isn't supported:
+   with ctx->arena set, this is a plain cJSON_ParseWithLengthCtx). */
+extern cJSON *cJSON_ParseLazy(const char *value,size_t length);
+extern cJSON *cJSON_ParseLazyCtx(cJSON_Context *ctx,const char *value,size_t length,const char **return_parse_end);
+/* Build item's children now if they are still lazy or packed, so ->child can be walked by hand.
+   Returns 1 on success (also when there was nothing to do), 0 on a syntax error or when out of memory. */
+extern int cJSON_Expand(cJSON *item);
+
+/* Compact read-only documents: every value is a 16-byte node in one flat array instead of a ~80-byte cJSON plus
+   separate string allocations. Nodes are addressed by cJSON_Node indexes (the root is 0; 0 also means "none" for
+   child/next/lookups, since the root is never a child). Numbers are stored exactly once (integer or double),
+   strings of up to 7 bytes live inside their node, longer strings and keys share one pool.
+	cJSON_Compact *doc=cJSON_CompactParse(0,text,len);
+	for (n=cJSON_CompactChild(doc,0); n; n=cJSON_CompactNext(doc,n)) sum+=cJSON_CompactNumber(doc,n);
+	cJSON_CompactDelete(doc);
+   Accessors return 0 (-1 for cJSON_CompactType) for a node of the wrong type. Pointers returned by
+   cJSON_CompactKey/cJSON_CompactString are '\0'-terminated and live as long as the document. */
+typedef struct cJSON_Compact cJSON_Compact;
+typedef unsigned int cJSON_Node;
+/* Parse length bytes at value. ctx (may be 0) supplies the allocator and max_depth; errors go to ctx->error. */
+extern cJSON_Compact *cJSON_CompactParse(cJSON_Context *ctx,const char *value,size_t length);
+extern void cJSON_CompactDelete(cJSON_Compact *doc);
+/* Bytes allocated for the document. */
+extern size_t cJSON_CompactMemory(const cJSON_Compact *doc);
+extern int cJSON_CompactType(const cJSON_Compact *doc,cJSON_Node node);
+/* Number of elements of an array/object. O(1). */
+extern int cJSON_CompactSize(const cJSON_Compact *doc,cJSON_Node node);
+extern cJSON_Node cJSON_CompactChild(const cJSON_Compact *doc,cJSON_Node node);
+extern cJSON_Node cJSON_CompactNext(const cJSON_Compact *doc,cJSON_Node node);
+extern cJSON_Node cJSON_CompactGetArrayItem(const cJSON_Compact *doc,cJSON_Node array,int index);
+/* Case insensitive, like cJSON_GetObjectItem. */
+extern cJSON_Node cJSON_CompactGetObjectItem(const cJSON_Compact *doc,cJSON_Node object,const char *string);
+extern const char *cJSON_CompactKey(const cJSON_Compact *doc,cJSON_Node node);
+extern const char *cJSON_CompactString(const cJSON_Compact *doc,cJSON_Node node,size_t *len);
+extern double cJSON_CompactNumber(const cJSON_Compact *doc,cJSON_Node node);
+/* Like valueint64: exact for integers, saturated otherwise. */
+extern long long cJSON_CompactInt64(const cJSON_Compact *doc,cJSON_Node node);
+/* Expand node and its subtree into a classic cJSON tree (default hooks). Release it with cJSON_Delete. */
+extern cJSON *cJSON_CompactToTree(const cJSON_Compact *doc,cJSON_Node node);
+
+/* Incremental parser for documents that arrive in pieces (e.g. from a socket). Feed the bytes as they come;
+   tokens split across pieces are carried over, so nothing is buffered or re-parsed except the partial token.
+	cJSON_Parser *ps=cJSON_ParserCreate(0);
+	while ((n=read(fd,buf,sizeof buf))>0) if (!cJSON_ParserFeed(ps,buf,n)) break;
+	root=cJSON_ParserFinish(ps);	// 0 if the document was malformed or incomplete
+	cJSON_ParserDelete(ps);
+   ctx (may be 0 for the default hooks) is copied; its allocator, arena, max_depth and options apply.
+   Only whitespace may follow the root value. */
+typedef struct cJSON_Parser cJSON_Parser;
+extern cJSON_Parser *cJSON_ParserCreate(cJSON_Context *ctx);
+/* Returns 1 while the input is fine so far, 0 on a syntax error or allocation failure. */
+extern int    cJSON_ParserFeed(cJSON_Parser *ps,const char *buf,size_t len);
+/* Ends the input and returns the tree, which the caller now owns (free with cJSON_DeleteCtx), or 0. */
+extern cJSON *cJSON_ParserFinish(cJSON_Parser *ps);
+/* Byte offset in the whole input where parsing failed. */
+extern size_t cJSON_ParserErrorOffset(cJSON_Parser *ps);
+/* Frees the parser, and any tree it had not handed out yet. */
+extern void   cJSON_ParserDelete(cJSON_Parser *ps);
+
 
 /* Supply a block of JSON, and this returns a cJSON object you can interrogate. Call cJSON_Delete when finished. */
 extern cJSON *cJSON_Parse(const char *value);
@@ -74,15 +264,60 @@ extern char  *cJSON_Print(cJSON *item);
 extern char  *cJSON_PrintUnformatted(cJSON *item);
 /* Render a cJSON entity to text using a buffered strategy. prebuffer is a guess at the final size. guessing well reduces reallocation. fmt=0 gives unformatted, =1 gives formatted */
 extern char *cJSON_PrintBuffered(cJSON *item,int prebuffer,int fmt);
+/* Exact length of the text cJSON_Print (fmt=1) or cJSON_PrintUnformatted (fmt=0) would produce, without the
+   terminating '\0'. Walks the tree without building the text: strings are scanned, numbers are formatted into a
+   scratch buffer. Returns 0 for an invalid tree. */
+extern size_t cJSON_PrintedLength(cJSON *item,int fmt);
+/* Render into the caller's buffer buf of len bytes, '\0'-terminated, with no allocation (beyond a walk stack for
+   trees nested more than 32 deep). len must be at least cJSON_PrintedLength(item,fmt)+1. Returns 1 on success,
+   0 if the text does not fit (buf then holds a truncated prefix) or the tree is invalid. */
+extern int cJSON_PrintPreallocated(cJSON *item,char *buf,int len,int fmt);
+/* Render a cJSON entity straight to write_fn, chunk_size bytes at a time (<=0 picks 4096). Memory use stays at about
+   chunk_size (a single string longer than that is buffered whole), and output starts before rendering is finished.
+   write_fn(user,data,len) must return non-zero on success. Returns 1 on success, 0 if a write or an allocation failed.
+   No terminating '\0' is written. */
+typedef int (*cJSON_WriteFn)(void *user,const char *data,int len);
+extern int cJSON_PrintToWriter(cJSON *item,int fmt,cJSON_WriteFn write_fn,void *user,int chunk_size);
+/* cJSON_PrintToWriter into a stdio stream. */
+extern int cJSON_PrintToFile(cJSON *item,int fmt,FILE *f);
+
+/* Binary encoding of the same trees: CBOR (RFC 8949). Numbers stay binary (integers as variable-length integers,
+   other numbers as float32 when that's exact, float64 otherwise) and strings are length-prefixed, so there is no
+   decimal conversion and no escaping. Arrays and objects have definite lengths. Packed arrays are written as
+   RFC 8746 typed arrays (tag 79: int64, tag 86: float64, little endian) and come back packed.
+   cJSON_PrintBinary returns length bytes (no terminating '\0') allocated with the cJSON hooks, or 0. */
+extern char *cJSON_PrintBinary(cJSON *item,size_t *length);
+/* Same, allocated with ctx's allocator. */
+extern char *cJSON_PrintBinaryCtx(cJSON_Context *ctx,cJSON *item,size_t *length);
+/* Stream the encoding to write_fn in chunk_size pieces, as cJSON_PrintToWriter does. */
+extern int cJSON_PrintBinaryToWriter(cJSON *item,cJSON_WriteFn write_fn,void *user,int chunk_size);
+/* Decode one CBOR value from length bytes at data. Other tags are ignored, undefined reads as null, and
+   indefinite-length arrays and maps are accepted. Byte strings, other simple values and non-string keys have no JSON
+   counterpart and fail the parse; so does truncated data. cJSON_GetErrorPtr() points at the offending byte. */
+extern cJSON *cJSON_ParseBinary(const char *data,size_t length);
+/* Same, through ctx: allocator, arena, max_depth, and cJSON_OptRequireNullTerminated (here: no bytes may follow the
+   value). Errors go to ctx->error; return_parse_end (if not 0) receives the end of the value. */
+extern cJSON *cJSON_ParseBinaryCtx(cJSON_Context *ctx,const char *data,size_t length,const char **return_parse_end);
 /* Delete a cJSON entity and all subentities. */
 extern void   cJSON_Delete(cJSON *c);
 
-/* Returns the number of items in an array (or object). */
+/* Returns the number of items in an array (or object). Large arrays cache the count, so repeated calls are O(1). */
 extern int	  cJSON_GetArraySize(cJSON *array);
-/* Retrieve item number "item" from array "array". Returns NULL if unsuccessful. */
+/* Retrieve item number "item" from array "array". Returns NULL if unsuccessful.
+   Large arrays build a vector of their children on first use, so indexing is O(1) until the array is modified
+   anywhere but at the end. */
 extern cJSON *cJSON_GetArrayItem(cJSON *array,int item);
+/* Walk the children of an array or object: cJSON *el; cJSON_ArrayForEach(el,array) { ... } */
+#define cJSON_ArrayForEach(element,array) for ((element)=(array) && cJSON_Expand(array)?(array)->child:0; (element); (element)=(element)->next)
 /* Get item "string" from object. Case insensitive. */
 extern cJSON *cJSON_GetObjectItem(cJSON *object,const char *string);
+/* Get item "string" from object, comparing keys exactly. */
+extern cJSON *cJSON_GetObjectItemCaseSensitive(cJSON *object,const char *string);
+/* Large objects get a hashed key index on first lookup, and large arrays a cached size and child vector, which the
+   Add/Detach/Replace/Insert calls keep up to date. A lookup notices hand edits at the ends of the child list (a new head,
+   a new tail, siblings linked after the tail) and drops them; after editing next/prev/child or a child's string in the
+   middle of the list by hand, call this to drop them yourself. */
+extern void cJSON_ResetIndex(cJSON *item);
 
 /* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. */
 extern const char *cJSON_GetErrorPtr(void);
@@ -93,6 +328,9 @@ extern cJSON *cJSON_CreateTrue(void);
 extern cJSON *cJSON_CreateFalse(void);
 extern cJSON *cJSON_CreateBool(int b);
 extern cJSON *cJSON_CreateNumber(double num);
+/* Creates a number that keeps the full 64-bit value in valueint64 and prints back exactly (LLONG_MIN and LLONG_MAX, which
+   can't be told from saturated values, print as the double). */
+extern cJSON *cJSON_CreateInt64(long long num);
 extern cJSON *cJSON_CreateString(const char *string);
 extern cJSON *cJSON_CreateArray(void);
 extern cJSON *cJSON_CreateObject(void);
@@ -103,6 +341,28 @@ extern cJSON *cJSON_CreateFloatArray(const float *numbers,int count);
 extern cJSON *cJSON_CreateDoubleArray(const double *numbers,int count);
 extern cJSON *cJSON_CreateStringArray(const char **strings,int count);
 
+/* Packed numeric arrays: an array whose elements live in one contiguous double[] or long long[] block instead of
+   one node per number (8 bytes per element instead of a cJSON). It prints exactly like the equivalent classic array.
+   GetArraySize and the Data accessors below use the block directly. GetArrayItem, the Add/Insert/Detach/Replace calls
+   and references convert it back to one child node per element first (cJSON_UnpackArray), so code using the
+   classic API keeps working. Code walking ->child by hand must call cJSON_Expand first. */
+#define cJSON_PackedDouble 1
+#define cJSON_PackedInt64 2
+extern cJSON *cJSON_CreatePackedDoubleArray(const double *numbers,int count);
+extern cJSON *cJSON_CreatePackedInt64Array(const long long *numbers,int count);
+/* cJSON_PackedDouble, cJSON_PackedInt64, or 0 when array isn't packed. */
+extern int cJSON_GetPackedType(cJSON *array);
+/* The element block of a packed array, without copying; 0 if array isn't packed with that element type.
+   The elements may be changed in place. *count (if count isn't 0) receives the number of elements. */
+extern double *cJSON_GetNumberArrayData(cJSON *array,int *count);
+extern long long *cJSON_GetInt64ArrayData(cJSON *array,int *count);
+/* Pack an array whose children are all numbers: long long if all are integers, double otherwise. Returns 1 on
+   success, 0 if array is empty, has other children, holds integers a double can't represent, or lives in an arena. */
+extern int cJSON_PackArray(cJSON *array);
+/* Turn a packed array back into one child node per element. Returns 1 on success (also when array isn't packed),
+   0 when out of memory. */
+extern int cJSON_UnpackArray(cJSON *array);
+
 /* Append item to the specified array/object. */
 extern void cJSON_AddItemToArray(cJSON *array, cJSON *item);
 extern void	cJSON_AddItemToObject(cJSON *object,const char *string,cJSON *item);
@@ -116,11 +376,16 @@ extern cJSON *cJSON_DetachItemFromArray(cJSON *array,int which);
 extern void   cJSON_DeleteItemFromArray(cJSON *array,int which);
 extern cJSON *cJSON_DetachItemFromObject(cJSON *object,const char *string);
 extern void   cJSON_DeleteItemFromObject(cJSON *object,const char *string);
+/* Detach a child you already hold (from GetArrayItem, GetObjectItemCaseSensitive, cJSON_ArrayForEach), without
+   looking it up again by index or by (case-insensitive) key. item must be a child of parent. */
+extern cJSON *cJSON_DetachItemViaPointer(cJSON *parent,cJSON *item);
 	
 /* Update array items. */
 extern void cJSON_InsertItemInArray(cJSON *array,int which,cJSON *newitem);	/* Shifts pre-existing items to the right. */
 extern void cJSON_ReplaceItemInArray(cJSON *array,int which,cJSON *newitem);
 extern void cJSON_ReplaceItemInObject(cJSON *object,const char *string,cJSON *newitem);
+/* Replace (and delete) the child item of parent with newitem; in an object, newitem takes item's key. */
+extern void cJSON_ReplaceItemViaPointer(cJSON *parent,cJSON *item,cJSON *newitem);
 
 /* Duplicate a cJSON item */
 extern cJSON *cJSON_Duplicate(cJSON *item,int recurse);
@@ -130,6 +395,11 @@ The item->next and ->prev pointers are always zero on return from Duplicate. */
 
 /* ParseWithOpts allows you to require (and check) that the JSON is null terminated, and to retrieve the pointer to the final byte parsed. */
 extern cJSON *cJSON_ParseWithOpts(const char *value,const char **return_parse_end,int require_null_terminated);
+/* Parse exactly length bytes at value; no '\0' is needed, and nothing at or past value+length is read,
+   so mmap'd files and network buffers can be parsed without copying. With require_null_terminated, only
+   whitespace (and an optional '\0') may follow the value. */
+extern cJSON *cJSON_ParseWithLength(const char *value,size_t length);
+extern cJSON *cJSON_ParseWithLengthOpts(const char *value,size_t length,const char **return_parse_end,int require_null_terminated);
 
 extern void cJSON_Minify(char *json);
 
@@ -141,9 +411,11 @@ extern void cJSON_Minify(char *json);
 #define cJSON_AddNumberToObject(object,name,n)	cJSON_AddItemToObject(object, name, cJSON_CreateNumber(n))
 #define cJSON_AddStringToObject(object,name,s)	cJSON_AddItemToObject(object, name, cJSON_CreateString(s))
 
-/* When assigning an integer value, it needs to be propagated to valuedouble too. */
-#define cJSON_SetIntValue(object,val)			((object)?(object)->valueint=(object)->valuedouble=(val):(val))
-#define cJSON_SetNumberValue(object,val)		((object)?(object)->valueint=(object)->valuedouble=(val):(val))
+/* When assigning an integer value, it needs to be propagated to valuedouble too.
+   valueint and valueint64 saturate at their limits instead of overflowing. */
+extern double cJSON_SetNumberHelper(cJSON *object,double number);
+#define cJSON_SetIntValue(object,val)			((object)?cJSON_SetNumberHelper(object,(double)(val)):(val))
+#define cJSON_SetNumberValue(object,val)		((object)?cJSON_SetNumberHelper(object,(double)(val)):(val))
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,524 @@
+/*
+  Copyright (c) 2009 Dave Gamble
+ 
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+ 
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+ 
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+/* : ļӳ䵽ڴ, нJSON Lines(NDJSON), Լö̲߳нĵ.
+   : -lpthread, ߶CJSON_NO_THREADS(ڵߵ߳ν) */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifndef CJSON_NO_THREADS
+#include <pthread.h>
+#endif
+#endif
+#include "cJSON.h"
+#include "cJSON_Batch.h"
+
+/* ޷ӳʱ(ܵ,ļ,֧mmapϵͳ)ļf->free_fnͷŵĻ */
+static int read_whole(cJSON_File *file,FILE *f,void *(*malloc_fn)(size_t))
+{
+    size_t cap=65536,len=0,n;
+    char *buf=(char*)malloc_fn(cap),*t;
+    if (!buf) return 0;
+    while ((n=fread(buf+len,1,cap-len,f))>0) {
+        len+=n;
+        if (len<cap) continue;
+        if (!(t=(char*)malloc_fn(cap*2))) {file->free_fn(buf); return 0;}
+        memcpy(t,buf,len);
+        file->free_fn(buf);
+        buf=t,cap*=2;
+    }
+    if (ferror(f)) {file->free_fn(buf); return 0;}
+    file->data=buf;
+    file->size=len;
+    file->mapped=0;
+    return 1;
+}
+
+#ifdef _WIN32
+static int map_file(cJSON_File *file,const char *path)
+{
+    HANDLE h=CreateFileA(path,GENERIC_READ,FILE_SHARE_READ,0,OPEN_EXISTING,FILE_FLAG_SEQUENTIAL_SCAN,0),m;
+    LARGE_INTEGER size;
+    void *data=0;
+    if (h==INVALID_HANDLE_VALUE) return 0;
+    if (GetFileSizeEx(h,&size) && size.QuadPart>0 && (unsigned long long)size.QuadPart<=(size_t)-1) {
+        m=CreateFileMappingA(h,0,PAGE_READONLY,0,0,0);
+        if (m) {
+            data=MapViewOfFile(m,FILE_MAP_READ,0,0,0);
+            CloseHandle(m);	//ͼӳЧ
+        }
+    }
+    CloseHandle(h);
+    if (!data) return 0;
+    file->data=(const char*)data;
+    file->size=(size_t)size.QuadPart;
+    file->mapped=1;
+    return 1;
+}
+static void unmap_file(cJSON_File *file)
+{
+    UnmapViewOfFile((void*)file->data);
+}
+#else
+static int map_file(cJSON_File *file,const char *path)
+{
+    struct stat st;
+    void *data=MAP_FAILED;
+    int fd=open(path,O_RDONLY);
+    if (fd<0) return 0;
+    if (!fstat(fd,&st) && S_ISREG(st.st_mode) && st.st_size>0 && (unsigned long long)st.st_size<=(size_t)-1)
+        data=mmap(0,(size_t)st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+    close(fd);	//ӳ䲻ļ
+    if (data==MAP_FAILED) return 0;
+#ifdef MADV_SEQUENTIAL
+    madvise(data,(size_t)st.st_size,MADV_SEQUENTIAL);	//ֻʾ,ʧҲûϵ
+#endif
+    file->data=(const char*)data;
+    file->size=(size_t)st.st_size;
+    file->mapped=1;
+    return 1;
+}
+static void unmap_file(cJSON_File *file)
+{
+    munmap((void*)file->data,file->size);
+}
+#endif
+
+/* 򿪲ӳpath. ʧܷ0 */
+cJSON_File *cJSON_FileOpen(const char *path)
+{
+    cJSON_Context c;
+    cJSON_File *file;
+    FILE *f;
+    int ok;
+    cJSON_InitContext(&c);	//ʹõǰķ亯(cJSON_InitHooks)
+    if (!path || !(file=(cJSON_File*)c.malloc_fn(sizeof(cJSON_File)))) return 0;
+    memset(file,0,sizeof(cJSON_File));
+    file->free_fn=c.free_fn;
+    if (map_file(file,path)) return file;
+    ok=(f=fopen(path,"rb"))!=0 && read_whole(file,f,c.malloc_fn);
+    if (f) fclose(f);
+    if (!ok) {
+        c.free_fn(file);
+        return 0;
+    }
+    return file;
+}
+
+void cJSON_FileClose(cJSON_File *file)
+{
+    if (!file) return;
+    if (file->mapped) unmap_file(file);
+    else file->free_fn((void*)file->data);
+    file->free_fn(file);
+}
+
+/* ļΪһJSONĵ. ctxΪ0ʱʹĬ,λÿcJSON_GetErrorPtr()ȡ.
+   λָѾӳڴ,ָֻȽ,ٶȡ */
+cJSON *cJSON_ParseFile(cJSON_Context *ctx,const char *path)
+{
+    cJSON_File *file=cJSON_FileOpen(path);
+    cJSON *c;
+    if (!file) return 0;
+    if (ctx) c=cJSON_ParseWithLengthCtx(ctx,file->data,file->size,0);
+    else c=cJSON_ParseWithLength(file->data,file->size);
+    cJSON_FileClose(file);
+    return c;
+}
+
+struct cJSON_Lines {
+    cJSON_Context ctx;		//ÿжcontext, cJSON_OptRequireNullTerminated
+    cJSON_Arena *own;		//Լarena, ÿʼʱ. ʹõߵarenaʱΪ0
+    const char *data,*p,*end;	//, һеĿʼ, Ľβ
+    long line;				//pڵк
+};
+
+cJSON_Lines *cJSON_LinesCreate(cJSON_Context *ctx,const char *data,size_t size)
+{
+    cJSON_Context c;
+    cJSON_Lines *lines;
+    if (ctx) c=*ctx;
+    else cJSON_InitContext(&c);
+    if (!data && size) return 0;
+    if (!(lines=(cJSON_Lines*)c.malloc_fn(sizeof(cJSON_Lines)))) return 0;
+    lines->own=0;
+    if (!c.arena && !(c.arena=lines->own=cJSON_ArenaCreate(0))) {
+        c.free_fn(lines);
+        return 0;
+    }
+    c.options|=cJSON_OptRequireNullTerminated;	//һֻһֵ
+    lines->ctx=c;
+    lines->data=lines->p=data;
+    lines->end=data+size;
+    lines->line=1;
+    return lines;
+}
+
+void cJSON_LinesDelete(cJSON_Lines *lines)
+{
+    if (!lines) return;
+    if (lines->own) cJSON_ArenaDelete(lines->own);
+    lines->ctx.free_fn(lines);
+}
+
+/* ҵһǿ,recһеֶ. βʱ0 */
+static int next_line(cJSON_Lines *lines,cJSON_Record *rec)
+{
+    while (lines->p<lines->end) {
+        const char *s=lines->p,*q;
+        const char *nl=(const char*)memchr(s,'\n',(size_t)(lines->end-s));
+        const char *e=nl?nl:lines->end;
+        lines->p=nl?nl+1:lines->end;
+        rec->line=lines->line++;
+        for (q=s; q<e && (unsigned char)*q<=32; q++);	//ֻпհ׵
+        if (q==e) continue;
+        if (e>s && e[-1]=='\r') e--;	//CRLF
+        rec->json=0;
+        rec->text=s;
+        rec->length=(size_t)(e-s);
+        rec->offset=(size_t)(s-lines->data);
+        rec->error=0;
+        return 1;
+    }
+    return 0;
+}
+
+/* һ(max)¼. ֮ǰнarenaһͷ.
+   Ҳ¼(jsonΪ0,errorΪλ), . :ļ¼,ʱΪ0 */
+int cJSON_LinesNext(cJSON_Lines *lines,cJSON_Record *records,int max)
+{
+    int n=0;
+    if (!lines || !records) return 0;
+    if (lines->own) cJSON_ArenaReset(lines->own);
+    while (n<max && next_line(lines,&records[n])) {
+        cJSON_Record *rec=&records[n++];
+        rec->json=cJSON_ParseWithLengthCtx(&lines->ctx,rec->text,rec->length,0);
+        if (!rec->json) rec->error=lines->ctx.error?lines->ctx.error:rec->text;	//ڴ治ʱûгλ
+    }
+    return n;
+}
+
+/* ֻзֳһ(max)¼, 罻cJSON_ParseBatch. :ļ¼ */
+int cJSON_LinesSplit(cJSON_Lines *lines,cJSON_Record *records,int max)
+{
+    int n=0;
+    if (!lines || !records) return 0;
+    while (n<max && next_line(lines,&records[n])) n++;
+    return n;
+}
+
+/* ¼ʽһ¼, صcJSON_ParseSax. صҪֹͣʱ¼,һεôһм.
+   :һ¼1, 0 */
+int cJSON_LinesNextSax(cJSON_Lines *lines,const cJSON_SaxHandler *h,void *user,cJSON_Record *record)
+{
+    if (!lines || !h || !record || !next_line(lines,record)) return 0;
+    if (!cJSON_ParseSaxWithLength(&lines->ctx,record->text,record->length,h,user,0))
+        record->error=lines->ctx.error?lines->ctx.error:record->text;
+    return 1;
+}
+
+/* н. ÿ߳Լcontextarena, ֻ֮һȡnext:
+   ߳ÿȡchunkڵ(ĵһ), ÿ߳Ȼȡ, ҪԤȻ */
+typedef struct {
+    cJSON_Context ctx;		//߳ʹõcontext, arenaΪԼarena
+    struct cJSON_Batch *batch;
+    int ok;					//̳߳ɹɵ
+} batch_worker;
+
+//cJSON_ParseParallelдһ: [start,end)','ָɸԪ
+typedef struct {
+    const char *start,*end;
+    cJSON *first,*last;		//Ԫ
+    const char *error;		//ʧʱĳλ
+} array_piece;
+
+struct cJSON_Batch {
+    cJSON_Context ctx;
+    int threads;
+    batch_worker *workers;	//workers[0]ڵߵ߳
+    int (*task)(batch_worker *w,long i);	//ִеi, ɹ1
+    cJSON_Record *docs;		//cJSON_ParseBatch
+    array_piece *pieces;	//cJSON_ParseParallel
+    int n,chunk;			//, ÿȡ
+    volatile long next;		//һȡ
+};
+
+#if defined(_WIN32)
+#define BATCH_THREADS
+typedef HANDLE batch_thread;
+static DWORD WINAPI batch_thread_main(LPVOID arg);
+static int batch_thread_start(batch_thread *t,batch_worker *w) {return (*t=CreateThread(0,0,batch_thread_main,w,0,0))!=0;}
+static void batch_thread_join(batch_thread t) {WaitForSingleObject(t,INFINITE); CloseHandle(t);}
+static long batch_claim(struct cJSON_Batch *b) {return InterlockedExchangeAdd(&b->next,b->chunk);}
+static int batch_cpus(void) {SYSTEM_INFO si; GetSystemInfo(&si); return (int)si.dwNumberOfProcessors;}
+#elif !defined(CJSON_NO_THREADS)
+#define BATCH_THREADS
+typedef pthread_t batch_thread;
+static void *batch_thread_main(void *arg);
+static int batch_thread_start(batch_thread *t,batch_worker *w) {return !pthread_create(t,0,batch_thread_main,w);}
+static void batch_thread_join(batch_thread t) {pthread_join(t,0);}
+static long batch_claim(struct cJSON_Batch *b) {return __sync_fetch_and_add(&b->next,(long)b->chunk);}
+static int batch_cpus(void) {long n=sysconf(_SC_NPROCESSORS_ONLN); return n>0?(int)n:1;}
+#else
+static long batch_claim(struct cJSON_Batch *b) {long i=b->next; b->next+=b->chunk; return i;}
+static int batch_cpus(void) {return 1;}
+#endif
+
+//ȡִ, ֱȫ
+static void batch_run(batch_worker *w)
+{
+    struct cJSON_Batch *b=w->batch;
+    long i,stop;
+    w->ok=0;
+    while ((i=batch_claim(b))<b->n) {
+        stop=i+b->chunk<b->n?i+b->chunk:b->n;
+        for (; i<stop; i++) w->ok+=b->task(w,i);
+    }
+}
+
+#ifdef BATCH_THREADS
+#ifdef _WIN32
+static DWORD WINAPI batch_thread_main(LPVOID arg)
+#else
+static void *batch_thread_main(void *arg)
+#endif
+{
+    batch_run((batch_worker*)arg);
+    cJSON_PoolFlush();	//߳̽ǰڵ(ʧܵĽͷŵĽڵ̵߳ĳ)
+    return 0;
+}
+#endif
+
+cJSON_Batch *cJSON_BatchCreate(cJSON_Context *ctx,int threads)
+{
+    cJSON_Context c;
+    cJSON_Batch *b;
+    int i;
+    if (ctx) c=*ctx;
+    else cJSON_InitContext(&c);
+    c.options|=cJSON_OptRequireNullTerminated;	//ÿĵֻһֵ,ͬcJSON_LinesNext
+    c.keys=0;	//פܱ߳ͬʱʹ
+    if (threads<=0) threads=batch_cpus();
+#ifndef BATCH_THREADS
+    threads=1;
+#endif
+    if (!(b=(cJSON_Batch*)c.malloc_fn(sizeof(cJSON_Batch)))) return 0;
+    memset(b,0,sizeof(cJSON_Batch));
+    b->ctx=c;
+    if (!(b->workers=(batch_worker*)c.malloc_fn(threads*sizeof(batch_worker)))) {
+        c.free_fn(b);
+        return 0;
+    }
+    for (i=0; i<threads; i++) {
+        b->workers[i].ctx=c;
+        b->workers[i].batch=b;
+        if (!(b->workers[i].ctx.arena=cJSON_ArenaCreate(0))) {
+            b->threads=i;
+            cJSON_BatchDelete(b);
+            return 0;
+        }
+    }
+    b->threads=threads;
+    return b;
+}
+
+void cJSON_BatchDelete(cJSON_Batch *batch)
+{
+    int i;
+    if (!batch) return;
+    for (i=0; i<batch->threads; i++) cJSON_ArenaDelete(batch->workers[i].ctx.arena);
+    batch->ctx.free_fn(batch->workers);
+    batch->ctx.free_fn(batch);
+}
+
+/* ִ߳n. ̴߳ʧʱ,ʣµ߳(еߵ߳)ȡ.
+   :ɹɵ */
+static int batch_execute(cJSON_Batch *batch,int n,int (*task)(batch_worker *w,long i))
+{
+    int i,ok=0,threads=batch->threads<n?batch->threads:n;	//߳ʱ߳
+#ifdef BATCH_THREADS
+    batch_thread *tids=0;
+    int started=0;
+#endif
+    batch->task=task;
+    batch->n=n;
+    batch->chunk=n/(threads*8);					//ÿ̴߳Լȡ8, ˾
+    if (batch->chunk<1) batch->chunk=1;
+    if (batch->chunk>64) batch->chunk=64;
+    batch->next=0;
+#ifdef BATCH_THREADS
+    if (threads>1 && (tids=(batch_thread*)batch->ctx.malloc_fn((threads-1)*sizeof(batch_thread))))
+        while (started<threads-1 && batch_thread_start(&tids[started],&batch->workers[started+1])) started++;
+#endif
+    batch_run(&batch->workers[0]);
+    ok=batch->workers[0].ok;
+#ifdef BATCH_THREADS
+    for (i=0; i<started; i++) {
+        batch_thread_join(tids[i]);
+        ok+=batch->workers[i+1].ok;
+    }
+    if (tids) batch->ctx.free_fn(tids);
+#else
+    (void)i;
+#endif
+    return ok;
+}
+
+static int parse_doc(batch_worker *w,long i)
+{
+    cJSON_Record *rec=&w->batch->docs[i];
+    rec->json=cJSON_ParseWithLengthCtx(&w->ctx,rec->text,rec->length,0);
+    rec->error=rec->json?0:(w->ctx.error?w->ctx.error:rec->text);
+    return rec->json!=0;
+}
+
+/* нdocs[0..n-1]. һεý̵߳arenaһͷ. :ɹĵ */
+int cJSON_ParseBatch(cJSON_Batch *batch,cJSON_Record *docs,int n)
+{
+    int i;
+    if (!batch || !docs || n<=0) return 0;
+    for (i=0; i<batch->threads; i++) cJSON_ArenaReset(batch->workers[i].ctx.arena);
+    batch->docs=docs;
+    return batch_execute(batch,n,parse_doc);
+}
+
+/* нһܴĶ. һֻ,תǶײɨҳ',',
+   ȵֽԪгɶ; ̰߳ԼĶеԪֵ, ˳ӵһ.
+   κһԤ(,Ų,ĳԪؽʧ...)ʱΪ˳ı,
+   ԽͳλöcJSON_ParseWithLengthCtxȫͬ */
+#ifndef CJSON_PARALLEL_MIN
+#define CJSON_PARALLEL_MIN (1<<20)	//̵ıֱ˳
+#endif
+#define PIECES_PER_THREAD 8
+
+static const char *skip_ws(const char *p,const char *end)
+{
+    while (p<end && (unsigned char)*p<=32 && *p) p++;
+    return p;
+}
+
+/* ɨ'['ʼ,ڶ','гmax,ÿstepֽ. ض,ṹʱ0 */
+static int split_array(const char *p,const char *end,size_t step,array_piece *pieces,int max)
+{
+    const char *start=p+1;
+    int n=0,depth=0;
+    for (p++; p<end; p++) {
+        switch (*p) {
+            case '\"':		//ַ, תַַ
+                for (p++; p<end && *p!='\"'; p++) if (*p=='\\') p++;
+                if (p>=end) return 0;
+                break;
+            case '[': case '{':
+                depth++;
+                break;
+            case ']': case '}':
+                if (depth--) break;
+                if (*p!=']' || n>=max) return 0;
+                pieces[n].start=start,pieces[n++].end=p;	//
+                return skip_ws(p+1,end)==end?n:0;		//ֻпհ
+            case ',':
+                if (!depth && (size_t)(p-start)>=step && n<max-1) {
+                    pieces[n].start=start,pieces[n++].end=p;
+                    start=p+1;
+                }
+                break;
+        }
+    }
+    return 0;
+}
+
+//һ','ָԪ
+static int parse_piece(batch_worker *w,long i)
+{
+    array_piece *pc=&w->batch->pieces[i];
+    cJSON_Context c=w->ctx;
+    const char *p=pc->start,*next;
+    cJSON *item;
+    c.arena=0;		//ڵ
+    c.options&=~cJSON_OptRequireNullTerminated;
+    if (c.max_depth>0) c.max_depth--;	//Ԫ֮һ
+    for (;;) {
+        if (!(item=cJSON_ParseWithLengthCtx(&c,p,(size_t)(pc->end-p),&next))) {
+            pc->error=c.error?c.error:p;
+            return 0;
+        }
+        if (pc->last) pc->last->next=item,item->prev=pc->last;
+        else pc->first=item;
+        pc->last=item;
+        p=skip_ws(next,pc->end);
+        if (p==pc->end) return 1;
+        if (*p!=',') {
+            pc->error=p;
+            return 0;
+        }
+        p++;
+    }
+}
+
+/* [value,value+length). ϴĶbatch߳ϲн, ˳.
+   cJSON_ParseWithLengthCtxbatchcontext(ʹarena)ͬ, ڵ,cJSON_DeleteCtxͷ.
+   ʧʱ0, error(Ϊ0)бλ */
+cJSON *cJSON_ParseParallel(cJSON_Batch *batch,const char *value,size_t length,const char **error)
+{
+    cJSON_Context c;
+    array_piece *pieces;
+    cJSON *root=0;
+    const char *p,*q,*end;
+    int n,i,max;
+    if (error) *error=0;
+    if (!batch || !value) return 0;
+    c=batch->ctx;
+    c.arena=0;
+    end=value+length;
+    p=skip_ws(value,end);
+    max=batch->threads*PIECES_PER_THREAD;
+    q=p<end?skip_ws(p+1,end):end;
+    if (q<end && (c.options&cJSON_OptPackNumbers) && (*q=='-' || (*q>='0' && *q<='9'))) q=end;	//ֵֻ, ˳ŻΪ
+    if (batch->threads>1 && length>=CJSON_PARALLEL_MIN && q<end && *p=='[' && (c.max_depth<=0 || c.max_depth>1)
+        && (pieces=(array_piece*)c.malloc_fn(max*sizeof(array_piece)))) {
+        n=split_array(p,end,length/max,pieces,max);
+        for (i=0; i<n; i++) pieces[i].first=pieces[i].last=0,pieces[i].error=0;
+        batch->pieces=pieces;
+        if (n>0 && batch_execute(batch,n,parse_piece)==n && (root=(cJSON*)c.malloc_fn(sizeof(cJSON)))) {
+            memset(root,0,sizeof(cJSON));
+            root->type=cJSON_Array;
+            for (i=1; i<n; i++) {	//Ѹεν
+                pieces[i-1].last->next=pieces[i].first;
+                pieces[i].first->prev=pieces[i-1].last;
+            }
+            root->child=pieces[0].first;
+            root->child->prev=pieces[n-1].last;	//ͷڵprevָβڵ
+        }
+        else for (i=0; i<n; i++) cJSON_DeleteCtx(&c,pieces[i].first);
+        c.free_fn(pieces);
+    }
+    if (!root && !(root=cJSON_ParseWithLengthCtx(&c,value,length,0)) && error) *error=c.error;	//˳
+    return root;
+}
@@ -0,0 +1,110 @@
+/*
+  Copyright (c) 2009 Dave Gamble
+ 
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+ 
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+ 
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#ifndef cJSON_Batch__h
+#define cJSON_Batch__h
+
+#include "cJSON.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Bulk input: whole files mapped into memory, and JSON Lines (NDJSON, one document per line). */
+
+/* A file mapped read-only into memory, or read into a buffer when it can't be mapped (pipes, empty files).
+   data is NOT '\0'-terminated; parse it with the *WithLength functions. */
+typedef struct cJSON_File {
+	const char *data;
+	size_t size;
+	int mapped;				/* private */
+	void (*free_fn)(void *ptr);	/* private */
+} cJSON_File;
+
+/* Map path. Returns 0 if it can't be opened or read. */
+extern cJSON_File *cJSON_FileOpen(const char *path);
+extern void cJSON_FileClose(cJSON_File *file);
+/* Parse the whole of path as one document, through ctx (may be 0). The tree does not refer to the file. */
+extern cJSON *cJSON_ParseFile(cJSON_Context *ctx,const char *path);
+
+/* One line of a JSON Lines input. Blank lines are skipped and produce no record. */
+typedef struct cJSON_Record {
+	cJSON *json;			/* The document, or 0 if the line is malformed (always 0 for cJSON_LinesNextSax). */
+	const char *text;		/* The line inside the input, without its line break. Not '\0'-terminated. */
+	size_t length;
+	size_t offset;			/* Byte offset of the line in the input. */
+	long line;				/* 1-based line number. */
+	const char *error;		/* 0 on success, otherwise the position of the error inside text. */
+} cJSON_Record;
+
+/* Iterates over the records in [data,data+size):
+	cJSON_File *f=cJSON_FileOpen("log.ndjson");
+	cJSON_Lines *in=cJSON_LinesCreate(0,f->data,f->size);
+	while ((n=cJSON_LinesNext(in,recs,256))>0)
+		for (i=0;i<n;i++) if (recs[i].json) use(recs[i].json); else report(recs[i].line,recs[i].error);
+	cJSON_LinesDelete(in);
+	cJSON_FileClose(f);
+   The documents of one batch are parsed into a single arena that is reset by the next call to cJSON_LinesNext,
+   so each batch costs no malloc/free once the arena has grown. Keep anything you need past that with cJSON_Duplicate.
+   ctx (may be 0) is copied. If it supplies an arena, that arena is used and never reset by the iterator.
+   Each line must hold exactly one value; trailing garbage is an error for that line only. */
+typedef struct cJSON_Lines cJSON_Lines;
+extern cJSON_Lines *cJSON_LinesCreate(cJSON_Context *ctx,const char *data,size_t size);
+/* Parse up to max records into records. Returns how many were filled, 0 at the end of the input. */
+extern int cJSON_LinesNext(cJSON_Lines *lines,cJSON_Record *records,int max);
+/* Parse the next record with events instead of a tree. Returns 1 if a record was consumed, 0 at the end. */
+extern int cJSON_LinesNextSax(cJSON_Lines *lines,const cJSON_SaxHandler *h,void *user,cJSON_Record *record);
+/* Only find the next max records (json stays 0), e.g. to hand them to cJSON_ParseBatch. Returns how many were filled. */
+extern int cJSON_LinesSplit(cJSON_Lines *lines,cJSON_Record *records,int max);
+extern void cJSON_LinesDelete(cJSON_Lines *lines);
+
+/* Parse many independent documents on several threads:
+	cJSON_Batch *b=cJSON_BatchCreate(0,0);	// one thread per core
+	while ((n=cJSON_LinesSplit(in,recs,4096))>0) {
+		cJSON_ParseBatch(b,recs,n);
+		for (i=0;i<n;i++) ...recs[i].json / recs[i].error as from cJSON_LinesNext...
+	}
+	cJSON_BatchDelete(b);
+   Every thread parses through its own copy of ctx (may be 0) into its own arena, so threads share nothing;
+   ctx->arena is not used. ctx's malloc_fn/free_fn must be thread-safe. As with lines, each document must hold
+   exactly one value. The trees of one call live until the next call or cJSON_BatchDelete.
+   Without thread support (CJSON_NO_THREADS) the documents are parsed in the calling thread. */
+typedef struct cJSON_Batch cJSON_Batch;
+/* threads<=0 uses one thread per online CPU. */
+extern cJSON_Batch *cJSON_BatchCreate(cJSON_Context *ctx,int threads);
+/* Parse the text/length of docs[0..n-1], filling in json and error. Returns the number parsed successfully. */
+extern int cJSON_ParseBatch(cJSON_Batch *batch,cJSON_Record *docs,int n);
+/* Parse one document of length bytes. A large top-level array is split at its top-level commas by a quick scan
+   that only tracks quotes, escapes and nesting. The pieces are parsed on the batch's threads and joined into one array.
+   Anything unexpected (not an array, a malformed element, with cJSON_OptPackNumbers an array whose first element is a
+   number, which may come out packed) falls back to a plain sequential parse, so the result and
+   the error position are exactly those of cJSON_ParseWithLengthCtx with the batch's context. The tree is malloc'd
+   through that context, never in the arenas, and belongs to the caller. On failure *error (if error!=0) is set. */
+extern cJSON *cJSON_ParseParallel(cJSON_Batch *batch,const char *value,size_t length,const char **error);
+extern void cJSON_BatchDelete(cJSON_Batch *batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1557 @@
+/*
+  Copyright (c) 2009 Dave Gamble
+ 
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+ 
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+ 
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+/* ѯ: JSON Pointer(RFC 6901)JSONPathһӼ. ·ȱɲ(cJSON_Query),֮ڶϷִ.
+   ִʱֻʹùĽӿ: ԱcJSON_GetObjectItemCaseSensitive(ļ),ԪcJSON_GetArrayItem
+   (), cJSON_ParseLazyõֻ·ᱻչ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "cJSON.h"
+#include "cJSON_Utils.h"
+
+enum {
+    QUERY_KEY,		//ΪkeyĳԱ; index>=0ʱ(JSON Pointerе)ҲʾĵindexԪ
+    QUERY_INDEX,	//ĵindexԪ,ĩβ
+    QUERY_ALL,		//еĳԱ/Ԫ
+    QUERY_DESCEND	//ΪkeyĳԱ, keyΪ0ʱʾеĺ
+};
+
+typedef struct {
+    int kind;
+    int index;
+    const char *key;
+} query_step;
+
+struct cJSON_Query {
+    void *(*malloc_fn)(size_t sz);	//ʱķ亯,ѯִʱջ
+    void (*free_fn)(void *ptr);
+    int n;				//
+    query_step *steps;
+    char *keys;			//еļ(ѽת)δ
+};
+
+/* ѯ: len+1len+1ֽڵļ. ·ÿռһַ,󲻻䳤 */
+static cJSON_Query *query_new(size_t len)
+{
+    cJSON_Context ctx;
+    cJSON_Query *q;
+    cJSON_InitContext(&ctx);	//ǰķ亯(cJSON_InitHooks)
+    q=(cJSON_Query*)ctx.malloc_fn(sizeof(cJSON_Query)+(len+1)*sizeof(query_step)+len+1);
+    if (!q) return 0;
+    q->malloc_fn=ctx.malloc_fn;
+    q->free_fn=ctx.free_fn;
+    q->n=0;
+    q->steps=(query_step*)(q+1);
+    q->keys=(char*)(q->steps+len+1);
+    return q;
+}
+
+void cJSON_QueryDelete(cJSON_Query *query)
+{
+    if (query) query->free_fn(query);
+}
+
+/* JSON Pointerе±: ûǰ0ʮ. ±ʱ-1 */
+static int pointer_index(const char *s)
+{
+    long v=0;
+    if (!*s || (*s=='0' && s[1])) return -1;
+    for (; *s; s++) {
+        if (*s<'0' || *s>'9') return -1;
+        v=v*10+(*s-'0');
+        if (v>0x7FFFFFFF) return -1;
+    }
+    return (int)v;
+}
+
+cJSON_Query *cJSON_QueryPointer(const char *pointer)
+{
+    cJSON_Query *q;
+    query_step *st;
+    char *k;
+
+    if (!pointer || (*pointer && *pointer!='/')) return 0;
+    if (!(q=query_new(strlen(pointer)))) return 0;
+    k=q->keys;
+    while (*pointer=='/') {		//ÿ'/'ʼһüǺ
+        st=&q->steps[q->n++];
+        st->kind=QUERY_KEY;
+        st->key=k;
+        for (pointer++; *pointer && *pointer!='/'; pointer++) {
+            if (*pointer!='~') *k++=*pointer;
+            else if (pointer[1]=='0') *k++='~',pointer++;	//~0ʾ'~', ~1ʾ'/'
+            else if (pointer[1]=='1') *k++='/',pointer++;
+            else {
+                cJSON_QueryDelete(q);
+                return 0;
+            }
+        }
+        *k++=0;
+        st->index=pointer_index(st->key);
+    }
+    return q;
+}
+
+/* JSONPath'.': ֱһ'.','['β. Ƶ*k, ֮λ, Ϊʱ0 */
+static const char *path_name(const char *p,char **k,query_step *st)
+{
+    const char *start=p;
+    st->key=*k;
+    while (*p && *p!='.' && *p!='[') *(*k)++=*p++;
+    *(*k)++=0;
+    return p==start?0:p;
+}
+
+//ո
+static const char *path_space(const char *p)
+{
+    while (*p==' ') p++;
+    return p;
+}
+
+/* JSONPath'['֮Ĳ: *, 'name', "name", Ȼ']'. ']'֮λ, ʧʱ0 */
+static const char *path_bracket(const char *p,char **k,query_step *st)
+{
+    char quote;
+    long v;
+    char *stop;
+
+    p=path_space(p);
+    if (*p=='*') {
+        st->kind=QUERY_ALL;
+        p++;
+    } else if (*p=='\'' || *p=='\"') {
+        st->kind=QUERY_KEY;
+        st->key=*k;
+        for (quote=*p++; *p!=quote; p++) {
+            if (*p=='\\' && p[1]) p++;	//бתһַ
+            if (!*p) return 0;
+            *(*k)++=*p;
+        }
+        *(*k)++=0;
+        p++;
+    } else if (*p=='-' || (*p>='0' && *p<='9')) {
+        v=strtol(p,&stop,10);
+        if (stop==p || (stop==p+1 && *p=='-') || v<-0x7FFFFFFFL || v>0x7FFFFFFFL) return 0;
+        st->kind=QUERY_INDEX;
+        st->index=(int)v;
+        p=stop;
+    } else return 0;
+    p=path_space(p);
+    return *p==']'?p+1:0;
+}
+
+cJSON_Query *cJSON_QueryCompile(const char *path)
+{
+    cJSON_Query *q;
+    query_step *st;
+    const char *p;
+    char *k;
+
+    if (!path || *path!='$') return 0;
+    if (!(q=query_new(strlen(path)))) return 0;
+    k=q->keys;
+    for (p=path+1; p && *p; q->n++) {
+        st=&q->steps[q->n];
+        st->index=-1;
+        st->key=0;
+        if (p[0]=='.' && p[1]=='.') {	//..name / ..*
+            st->kind=QUERY_DESCEND;
+            p+=2;
+            if (*p=='*') p++;
+            else p=path_name(p,&k,st);
+        } else if (*p=='.') {			//.name / .*
+            p++;
+            if (*p=='*') st->kind=QUERY_ALL,p++;
+            else st->kind=QUERY_KEY,p=path_name(p,&k,st);
+        } else if (*p=='[') p=path_bracket(p+1,&k,st);
+        else p=0;
+    }
+    if (!p) {
+        cJSON_QueryDelete(q);
+        return 0;
+    }
+    return q;
+}
+
+/* ִ״̬ */
+typedef struct {
+    const cJSON_Query *q;
+    int (*fn)(void *user,cJSON *match);
+    void *user;
+    int count;		//fnƥ
+    int stop;		//fn0
+} query_run;
+
+static int is_container(cJSON *item)
+{
+    return (item->type&255)==cJSON_Array || (item->type&255)==cJSON_Object;
+}
+
+static void query_match(query_run *r,int i,cJSON *node);
+
+/* QUERY_DESCEND: ĵ˳()node֮µнڵ. ݹ: ջбÿһнҪʵֵܽڵ */
+static void query_descend(query_run *r,int i,cJSON *node)
+{
+    const query_step *st=&r->q->steps[i];
+    cJSON *local[32],**stack=local,**t,*d=node;
+    int top=0,cap=32;
+
+    while (d && !r->stop) {
+        if (!st->key) {								//..*: nodeк
+            if (d!=node) query_match(r,i+1,d);
+        } else if ((d->type&255)==cJSON_Object) {	//..name: ·ÿnameԱ
+            query_match(r,i+1,cJSON_GetObjectItemCaseSensitive(d,st->key));
+        }
+        if (is_container(d) && cJSON_Expand(d) && d->child) {	//ȷӽڵ,dֵ֮ܽڵ
+            if (d!=node && d->next) {
+                if (top==cap) {
+                    if (!(t=(cJSON**)r->q->malloc_fn(2*cap*sizeof(cJSON*)))) break;
+                    memcpy(t,stack,top*sizeof(cJSON*));
+                    if (stack!=local) r->q->free_fn(stack);
+                    stack=t,cap*=2;
+                }
+                stack[top++]=d->next;
+            }
+            d=d->child;
+            continue;
+        }
+        d=d==node?0:d->next;
+        if (!d && top) d=stack[--top];
+    }
+    if (stack!=local) r->q->free_fn(stack);
+}
+
+/* nodeʼִеi֮Ĳ. ݹĲ */
+static void query_match(query_run *r,int i,cJSON *node)
+{
+    const query_step *st;
+    cJSON *c;
+    int type,index;
+
+    if (!node || r->stop) return;
+    if (i==r->q->n) {	//в趼ƥ
+        r->count++;
+        if (!r->fn(r->user,node)) r->stop=1;
+        return;
+    }
+    st=&r->q->steps[i];
+    type=node->type&255;
+    switch (st->kind) {
+        case QUERY_KEY:
+            if (type==cJSON_Object) query_match(r,i+1,cJSON_GetObjectItemCaseSensitive(node,st->key));
+            else if (type==cJSON_Array && st->index>=0) query_match(r,i+1,cJSON_GetArrayItem(node,st->index));
+            break;
+        case QUERY_INDEX:
+            if (type!=cJSON_Array) break;
+            index=st->index<0?st->index+cJSON_GetArraySize(node):st->index;
+            if (index>=0) query_match(r,i+1,cJSON_GetArrayItem(node,index));
+            break;
+        case QUERY_ALL:
+            if (!is_container(node)) break;
+            cJSON_ArrayForEach(c,node) {
+                query_match(r,i+1,c);
+                if (r->stop) break;
+            }
+            break;
+        case QUERY_DESCEND:
+            query_descend(r,i,node);
+            break;
+    }
+}
+
+int cJSON_QueryEach(const cJSON_Query *query,cJSON *root,int (*fn)(void *user,cJSON *match),void *user)
+{
+    query_run r;
+    if (!query || !root || !fn) return 0;
+    r.q=query;
+    r.fn=fn;
+    r.user=user;
+    r.count=0;
+    r.stop=0;
+    query_match(&r,0,root);
+    return r.count;
+}
+
+static int keep_first(void *user,cJSON *match)
+{
+    *(cJSON**)user=match;
+    return 0;
+}
+
+cJSON *cJSON_QueryFirst(const cJSON_Query *query,cJSON *root)
+{
+    cJSON *match=0;
+    cJSON_QueryEach(query,root,keep_first,&match);
+    return match;
+}
+
+cJSON *cJSON_QueryText(const cJSON_Query *query,const char *text,size_t length)
+{
+    cJSON *root,*match,*copy=0;
+    if (!query || !text || !(root=cJSON_ParseLazy(text,length))) return 0;
+    if ((match=cJSON_QueryFirst(query,root))) copy=cJSON_Duplicate(match,1);	//ƻչƥ,֮ıԶ
+    cJSON_Delete(root);
+    return copy;
+}
+
+cJSON *cJSON_GetPointer(cJSON *root,const char *pointer)
+{
+    cJSON_Query *q=cJSON_QueryPointer(pointer);
+    cJSON *match=cJSON_QueryFirst(q,root);
+    cJSON_QueryDelete(q);
+    return match;
+}
+
+
+/* ṹ: ֶαJSONĳԱCṹԱĶӦϵ.
+   ¼(cJSON_ParseSaxWithLength), ֱֵдṹ, cJSON;
+   Ƕײ, һ̶Сջ¼Ľṹ/. ʶĳԱֻ.
+   밴ṹ, ջϵcJSONڵcJSON_PrintPreallocatedʽ, cJSON_Printһ */
+#define BIND_DEPTH 32
+
+typedef struct {
+    const cJSON_Binding *fields;	//֡: ṹֶα; ֡: Ԫصһ
+    const cJSON_Binding *array;		//֡: ֶα; ֡Ϊ0
+    char *base;				//ṹ/ʼַ
+    int *count;				//֡: Ԫظ
+} bind_frame;
+
+typedef struct {
+    void *(*malloc_fn)(size_t sz);	//cJSON_BindStringķ亯
+    void (*free_fn)(void *ptr);
+    const cJSON_Binding *root;
+    void *out;
+    bind_frame stack[BIND_DEPTH];
+    int depth;
+    const cJSON_Binding *next;		//иնļӦֶ, 0ʾû
+    int skip;				//>0ʱʶ/, ΪѽĲ
+} bind_state;
+
+/* ֶڽṹ(Ԫ)ռֽ */
+static size_t bind_size(const cJSON_Binding *f)
+{
+    switch (f->type) {
+        case cJSON_BindInt:
+        case cJSON_BindBool:	return sizeof(int);
+        case cJSON_BindInt64:	return sizeof(long long);
+        case cJSON_BindDouble:	return sizeof(double);
+        case cJSON_BindString:	return sizeof(char*);
+        case cJSON_BindArray:	return f->size*bind_size(f->fields);
+        default:				return f->size;	//cJSON_BindChars, ΪԪصcJSON_BindObject
+    }
+}
+
+/* ֶεԪظ, ڵĽṹ */
+static int *bind_count(const cJSON_Binding *f,char *addr)
+{
+    return (int*)(addr-f->offset+f->count_offset);
+}
+
+/* ͷaddrֶ(ݹ)еַ */
+static void bind_release(void (*free_fn)(void *ptr),const cJSON_Binding *f,char *addr)
+{
+    const cJSON_Binding *g;
+    int i,n;
+    switch (f->type) {
+        case cJSON_BindString:
+            if (*(char**)addr) free_fn(*(char**)addr);
+            *(char**)addr=0;
+            break;
+        case cJSON_BindObject:
+            for (g=f->fields; g->key; g++) bind_release(free_fn,g,addr+g->offset);
+            break;
+        case cJSON_BindArray:
+            n=*bind_count(f,addr);
+            if (n>(int)f->size) n=(int)f->size;
+            for (i=0; i<n; i++) bind_release(free_fn,f->fields,addr+i*bind_size(f->fields));
+            break;
+    }
+}
+
+/* null: ͷŲֶ, Ԫظ0 */
+static void bind_clear(bind_state *b,const cJSON_Binding *f,char *addr)
+{
+    const cJSON_Binding *g;
+    if (f->type==cJSON_BindObject && !f->size) {	//ԪصĽṹûиsize: ֶ
+        for (g=f->fields; g->key; g++) bind_clear(b,g,addr+g->offset);
+        return;
+    }
+    bind_release(b->free_fn,f,addr);
+    memset(addr,0,bind_size(f));
+    if (f->type==cJSON_BindArray) *bind_count(f,addr)=0;
+}
+
+/* һֵд: 1*f͵ַ*addr; 0ʾֵ(ʶļ,);
+   -1ʾʧ(Ƕ, ) */
+static int bind_slot(bind_state *b,const cJSON_Binding **f,char **addr)
+{
+    bind_frame *t;
+    if (b->skip) return 0;
+    if (!b->depth) return -1;
+    t=&b->stack[b->depth-1];
+    if (!t->array) {
+        if (!(*f=b->next)) return 0;
+        b->next=0;
+        *addr=t->base+(*f)->offset;
+        return 1;
+    }
+    if (*t->count>=(int)t->array->size) return -1;
+    *f=t->fields;
+    *addr=t->base+(*t->count)++*bind_size(t->fields);
+    return 1;
+}
+
+static int bind_push(bind_state *b,const cJSON_Binding *fields,const cJSON_Binding *array,char *base)
+{
+    bind_frame *t;
+    if (b->depth>=BIND_DEPTH) return 0;
+    t=&b->stack[b->depth++];
+    t->fields=fields;
+    t->array=array;
+    t->base=base;
+    if (array) *(t->count=bind_count(array,base))=0;
+    return 1;
+}
+
+static int bind_null(void *user)
+{
+    bind_state *b=(bind_state*)user;
+    const cJSON_Binding *f;
+    char *addr;
+    int r=bind_slot(b,&f,&addr);
+    if (r>0) bind_clear(b,f,addr);
+    return r>=0;
+}
+
+static int bind_bool(void *user,int value)
+{
+    bind_state *b=(bind_state*)user;
+    const cJSON_Binding *f;
+    char *addr;
+    int r=bind_slot(b,&f,&addr);
+    if (r<=0) return !r;
+    if (f->type!=cJSON_BindBool) return 0;
+    *(int*)addr=value;
+    return 1;
+}
+
+static int bind_number(void *user,double value,long long value64)
+{
+    bind_state *b=(bind_state*)user;
+    const cJSON_Binding *f;
+    char *addr;
+    int r=bind_slot(b,&f,&addr);
+    if (r<=0) return !r;
+    switch (f->type) {
+        case cJSON_BindDouble:
+            *(double*)addr=value;
+            return 1;
+        case cJSON_BindInt:
+            if ((double)value64!=value || value64<INT_MIN || value64>INT_MAX) return 0;	//С򳬳intķΧ
+            *(int*)addr=(int)value64;
+            return 1;
+        case cJSON_BindInt64:	//long longΧڵıbind_integer. ﳬΧѾ͵LLONG_MAX/LLONG_MIN
+            if ((double)value64!=value || value>=9223372036854775808.0 || value<=-9223372036854775808.0) return 0;
+            *(long long*)addr=value64;
+            return 1;
+    }
+    return 0;
+}
+
+//long longΧڵı, value64Ǿȷֵ
+static int bind_integer(void *user,long long value64)
+{
+    bind_state *b=(bind_state*)user;
+    const cJSON_Binding *f;
+    char *addr;
+    int r=bind_slot(b,&f,&addr);
+    if (r<=0) return !r;
+    switch (f->type) {
+        case cJSON_BindDouble:
+            *(double*)addr=(double)value64;
+            return 1;
+        case cJSON_BindInt:
+            if (value64<INT_MIN || value64>INT_MAX) return 0;
+            *(int*)addr=(int)value64;
+            return 1;
+        case cJSON_BindInt64:
+            *(long long*)addr=value64;
+            return 1;
+    }
+    return 0;
+}
+
+static int bind_string(void *user,const char *str,size_t len)
+{
+    bind_state *b=(bind_state*)user;
+    const cJSON_Binding *f;
+    char *addr,*copy;
+    int r=bind_slot(b,&f,&addr);
+    if (r<=0) return !r;
+    if (f->type==cJSON_BindChars) {
+        if (len>=f->size) return 0;	//Ų
+        memcpy(addr,str,len);
+        addr[len]=0;
+        return 1;
+    }
+    if (f->type!=cJSON_BindString || !(copy=(char*)b->malloc_fn(len+1))) return 0;
+    memcpy(copy,str,len);
+    copy[len]=0;
+    if (*(char**)addr) b->free_fn(*(char**)addr);	//ظoutһεĽ
+    *(char**)addr=copy;
+    return 1;
+}
+
+static int bind_key(void *user,const char *str,size_t len)
+{
+    bind_state *b=(bind_state*)user;
+    const cJSON_Binding *f;
+    if (b->skip) return 1;
+    for (f=b->stack[b->depth-1].fields; f->key; f++)	//ͨܶ, ˳Ƚϼ
+        if (!strncmp(f->key,str,len) && !f->key[len]) break;
+    b->next=f->key?f:0;
+    return 1;
+}
+
+static int bind_start_object(void *user)
+{
+    bind_state *b=(bind_state*)user;
+    const cJSON_Binding *f;
+    char *addr;
+    int r;
+    if (b->skip) return ++b->skip;
+    if (!b->depth) return bind_push(b,b->root,0,(char*)b->out);	//
+    if (!(r=bind_slot(b,&f,&addr))) return b->skip=1;
+    if (r<0 || f->type!=cJSON_BindObject) return 0;
+    return bind_push(b,f->fields,0,addr);
+}
+
+static int bind_start_array(void *user)
+{
+    bind_state *b=(bind_state*)user;
+    const cJSON_Binding *f;
+    char *addr;
+    int r;
+    if (b->skip) return ++b->skip;
+    if (!(r=bind_slot(b,&f,&addr))) return b->skip=1;
+    if (r<0 || f->type!=cJSON_BindArray || !f->fields || f->fields->type==cJSON_BindArray) return 0;	//֧
+    bind_clear(b,f,addr);	//ɵԪȫ
+    return bind_push(b,f->fields,f,addr);
+}
+
+static int bind_end(void *user)
+{
+    bind_state *b=(bind_state*)user;
+    if (b->skip) b->skip--;
+    else b->depth--;
+    return 1;
+}
+
+int cJSON_BindParse(cJSON_Context *ctx,const char *value,size_t length,const cJSON_Binding *fields,void *out)
+{
+    static const cJSON_SaxHandler h={bind_null,bind_bool,bind_number,bind_string,bind_key,
+                                     bind_start_object,bind_end,bind_start_array,bind_end,bind_integer};
+    cJSON_Context def;
+    bind_state b;
+    if (!fields || !out) return 0;
+    if (!ctx) cJSON_InitContext(&def);
+    b.malloc_fn=ctx?ctx->malloc_fn:def.malloc_fn;
+    b.free_fn=ctx?ctx->free_fn:def.free_fn;
+    b.root=fields;
+    b.out=out;
+    b.depth=0;
+    b.next=0;
+    b.skip=0;
+    return cJSON_ParseSaxWithLength(ctx,value,length,&h,&b,0);
+}
+
+void cJSON_BindFree(cJSON_Context *ctx,const cJSON_Binding *fields,void *in)
+{
+    cJSON_Context def;
+    const cJSON_Binding *f;
+    if (!fields || !in) return;
+    if (!ctx) cJSON_InitContext(&def),ctx=&def;
+    for (f=fields; f->key; f++) bind_release(ctx->free_fn,f,(char*)in+f->offset);
+}
+
+/* , 2. okΪ0, ֮ */
+typedef struct {
+    char *buf;
+    size_t len,cap;
+    void *(*malloc_fn)(size_t sz);
+    void (*free_fn)(void *ptr);
+    int fmt;
+    int ok;
+} bind_out;
+
+/* ֤дnֽ(ͽβ'\0'), дλ */
+static char *out_reserve(bind_out *o,size_t n)
+{
+    char *buf;
+    size_t cap;
+    if (!o->ok) return 0;
+    if (o->len+n<o->cap) return o->buf+o->len;
+    for (cap=o->cap?o->cap*2:256; cap<=o->len+n; cap*=2);
+    if (!(buf=(char*)o->malloc_fn(cap))) {
+        o->ok=0;
+        return 0;
+    }
+    if (o->len) memcpy(buf,o->buf,o->len);
+    if (o->buf) o->free_fn(o->buf);
+    o->buf=buf;
+    o->cap=cap;
+    return buf+o->len;
+}
+
+static void out_raw(bind_out *o,const char *str,size_t n)
+{
+    char *p=out_reserve(o,n);
+    if (p) memcpy(p,str,n),o->len+=n;
+}
+
+static void out_indent(bind_out *o,int n)
+{
+    char *p;
+    if (n>0 && (p=out_reserve(o,n))) memset(p,'\t',n),o->len+=n;
+}
+
+/* cJSONԼдһڵ. ֲ32ַ, ַתĳ */
+static void out_scalar(bind_out *o,cJSON *item)
+{
+    size_t n=(item->type&255)==cJSON_String?cJSON_PrintedLength(item,0):32;
+    char *p;
+    if (!n || !(p=out_reserve(o,n))) {
+        o->ok=0;
+        return;
+    }
+    if (!cJSON_PrintPreallocated(item,p,(int)n+1,0)) o->ok=0;
+    else o->len+=strlen(p);
+}
+
+static void out_string(bind_out *o,const char *str)
+{
+    cJSON item;
+    memset(&item,0,sizeof(item));
+    item.type=cJSON_String;
+    item.valuestring=(char*)str;
+    out_scalar(o,&item);
+}
+
+static void out_object(bind_out *o,const cJSON_Binding *fields,const char *base,int depth);
+
+/* addrֶ, depthprint_valueеĺͬ */
+static void out_value(bind_out *o,const cJSON_Binding *f,const char *addr,int depth)
+{
+    cJSON item;
+    char *p;
+    int i,n;
+    memset(&item,0,sizeof(item));
+    item.type=cJSON_Number;
+    switch (f->type) {
+        case cJSON_BindInt:
+            cJSON_SetNumberHelper(&item,*(const int*)addr);
+            out_scalar(o,&item);
+            break;
+        case cJSON_BindInt64:	//ֱӰʮ, double, 2^53ֵҲǾȷ
+            if ((p=out_reserve(o,24))) o->len+=sprintf(p,"%lld",*(const long long*)addr);
+            break;
+        case cJSON_BindDouble:
+            cJSON_SetNumberHelper(&item,*(const double*)addr);
+            out_scalar(o,&item);
+            break;
+        case cJSON_BindBool:
+            if (*(const int*)addr) out_raw(o,"true",4);
+            else out_raw(o,"false",5);
+            break;
+        case cJSON_BindString:
+            if (*(char*const*)addr) out_string(o,*(char*const*)addr);
+            else out_raw(o,"null",4);
+            break;
+        case cJSON_BindChars:
+            out_string(o,addr);
+            break;
+        case cJSON_BindObject:
+            out_object(o,f->fields,addr,depth);
+            break;
+        case cJSON_BindArray:
+            n=*bind_count(f,(char*)addr);
+            if (n>(int)f->size) n=(int)f->size;
+            out_raw(o,"[",1);
+            for (i=0; i<n; i++) {
+                if (i) out_raw(o,", ",o->fmt?2:1);
+                out_value(o,f->fields,addr+i*bind_size(f->fields),depth+1);
+            }
+            out_raw(o,"]",1);
+            break;
+        default:
+            o->ok=0;
+    }
+}
+
+/* print_valueĶʽͬ: "{\n", ÿԱdepth+1, Ϊ":\t", Ա֮","ͻ */
+static void out_object(bind_out *o,const cJSON_Binding *fields,const char *base,int depth)
+{
+    const cJSON_Binding *f;
+    out_raw(o,"{\n",o->fmt?2:1);
+    if (!fields->key) {	//ն
+        out_indent(o,o->fmt?depth-1:0);
+        out_raw(o,"}",1);
+        return;
+    }
+    for (f=fields; f->key; f++) {
+        if (o->fmt) out_indent(o,depth+1);
+        out_string(o,f->key);
+        out_raw(o,":\t",o->fmt?2:1);
+        out_value(o,f,base+f->offset,depth+1);
+        if (f[1].key) out_raw(o,",",1);
+        if (o->fmt) out_raw(o,"\n",1);
+    }
+    if (o->fmt) out_indent(o,depth);
+    out_raw(o,"}",1);
+}
+
+char *cJSON_BindPrint(const cJSON_Binding *fields,const void *in,int fmt)
+{
+    cJSON_Context ctx;
+    bind_out o;
+    if (!fields || !in) return 0;
+    cJSON_InitContext(&ctx);
+    o.buf=0;
+    o.len=o.cap=0;
+    o.malloc_fn=ctx.malloc_fn;
+    o.free_fn=ctx.free_fn;
+    o.fmt=fmt;
+    o.ok=1;
+    out_object(&o,fields,(const char*)in,0);
+    if (!o.ok) {
+        if (o.buf) o.free_fn(o.buf);
+        return 0;
+    }
+    o.buf[o.len]=0;
+    return o.buf;
+}
+
+
+/* Ͳ: JSON Patch(RFC 6902)JSON Merge Patch(RFC 7386).
+   ɲʱÿֻһݹϣ(ԽڵָΪı), ϣͬٱȽһȷȺ,
+   ÿڵ౻ϣһΡȷһ, ĴСֻȡڸĶĲ. 鰴ԪصĹϣ(Myers),
+   ɾһԪֻһ. Ӧòֻͨ//滻ӿ޸ıĽڵ */
+typedef struct {
+    const cJSON **nodes;	//Ѱַı: ڵ -> ݹϣ, 0Ϊղ
+    unsigned long long *hashes;
+    size_t cap,count;
+    char *path;			//ǰλõJSON Pointer
+    size_t len,path_cap;
+    cJSON *patch;		//cJSON_DiffɵĲ
+    struct diff_task *tasks;	//ûִеıȽϺͲ(ջ)
+    int ntasks,task_cap;
+    void *(*malloc_fn)(size_t sz);
+    void (*free_fn)(void *ptr);
+    int fail;			//ڴ治
+} diff_state;
+
+/* cJSON_Diffݹ: Ƚһʱ, ӽڵıȽϺɵĲ˳Ϊ, ѹջ.
+   ¸ڵ·ĳ, ִʱȽضϵ, ׷ԼļǺ */
+typedef struct diff_task {
+    cJSON *from,*to;	//'=': Ƚfromto; 'a': to; 'd': ɾ
+    const char *key;	//·ϵļǺ: Աļ. Ϊ0ʱ±index, indexΪ-1ʱûмǺ()
+    int index;
+    size_t mark;		//ڵ·ĳ
+    char op;
+} diff_task;
+
+/* node_hash, node_equal, cJSON_MergeDiffcJSON_ApplyMergePatchʽջ, ÿһεĵݹ.
+   ǰTREE_LOCALڵջϵĻ,ʱĬϵķ亯չ */
+#define TREE_LOCAL 32
+typedef struct {
+    cJSON *a,*b;		//ڴ: node_hashֻa; node_equalȽab; ϲʱaĿ(from), bpatch(to)
+    cJSON *x,*y;		//abһҪӽڵ. cJSON_MergeDiffxҪдpatch
+    unsigned long long h;	//node_hash: ĿǰΪֹĹϣ
+    int n;				//node_equal: aѱȽϵĳԱ
+} tree_frame;
+
+typedef struct {
+    tree_frame *frames;
+    int depth,cap;
+    void *(*malloc_fn)(size_t sz);
+    void (*free_fn)(void *ptr);
+    tree_frame local[TREE_LOCAL];
+} tree_stack;
+
+static void tree_init(tree_stack *s)
+{
+    cJSON_Context ctx;
+    cJSON_InitContext(&ctx);
+    s->frames=s->local,s->depth=0,s->cap=TREE_LOCAL;
+    s->malloc_fn=ctx.malloc_fn,s->free_fn=ctx.free_fn;
+}
+
+static void tree_free(tree_stack *s)
+{
+    if (s->frames!=s->local) s->free_fn(s->frames);
+}
+
+//ѹab,µջ. ڴ治ʱ0
+static tree_frame *tree_push(tree_stack *s,cJSON *a,cJSON *b)
+{
+    tree_frame *f;
+    if (s->depth==s->cap) {
+        f=(tree_frame*)s->malloc_fn(2*s->cap*sizeof(tree_frame));
+        if (!f) return 0;
+        memcpy(f,s->frames,s->depth*sizeof(tree_frame));
+        tree_free(s);
+        s->frames=f,s->cap*=2;
+    }
+    f=&s->frames[s->depth++];
+    f->a=a,f->b=b,f->x=a?a->child:0,f->y=b?b->child:0,f->h=0,f->n=0;
+    return f;
+}
+
+static unsigned long long hash_mix(unsigned long long h)
+{
+    h^=h>>33;
+    h*=0xff51afd7ed558ccdULL;
+    h^=h>>33;
+    h*=0xc4ceb9fe1a85ec53ULL;
+    return h^(h>>33);
+}
+
+static unsigned long long hash_str(const char *s)	//FNV-1a
+{
+    unsigned long long h=0xcbf29ce484222325ULL;
+    if (s) for (; *s; s++) h=(h^(unsigned char)*s)*0x100000001b3ULL;
+    return h;
+}
+
+static size_t memo_slot(const diff_state *d,const cJSON *node)
+{
+    size_t i=(size_t)hash_mix((unsigned long long)(size_t)node)&(d->cap-1);
+    while (d->nodes[i] && d->nodes[i]!=node) i=(i+1)&(d->cap-1);
+    return i;
+}
+
+//¼nodeĹϣ, ʱӱ
+static void memo_put(diff_state *d,const cJSON *node,unsigned long long h)
+{
+    const cJSON **nodes=d->nodes;
+    unsigned long long *hashes=d->hashes;
+    size_t cap=d->cap,i,j;
+    if ((d->count+1)*2>cap) {
+        d->cap=cap?cap*2:256;
+        d->nodes=(const cJSON**)d->malloc_fn(d->cap*(sizeof(cJSON*)+sizeof(unsigned long long)));
+        if (!d->nodes) {
+            d->nodes=nodes,d->cap=cap,d->fail=1;
+            return;
+        }
+        d->hashes=(unsigned long long*)(d->nodes+d->cap);
+        memset(d->nodes,0,d->cap*sizeof(cJSON*));
+        for (i=0; i<cap; i++) if (nodes[i]) {
+            j=memo_slot(d,nodes[i]);
+            d->nodes[j]=nodes[i];
+            d->hashes[j]=hashes[i];
+        }
+        if (nodes) d->free_fn(nodes);
+    }
+    i=memo_slot(d,node);
+    d->nodes[i]=node;
+    d->hashes[i]=h;
+    d->count++;
+}
+
+//Ѿ¼Ĺϣ
+static int memo_get(const diff_state *d,const cJSON *node,unsigned long long *h)
+{
+    size_t i;
+    if (!d->cap || !d->nodes[i=memo_slot(d,node)]) return 0;
+    *h=d->hashes[i];
+    return 1;
+}
+
+//Ĺϣ. Ĺϣnode_hashӽڵ
+static unsigned long long scalar_hash(cJSON *node)
+{
+    unsigned long long bits;
+    double v;
+    switch (node->type&255) {
+        case cJSON_False:	return 1;
+        case cJSON_True:	return 2;
+        case cJSON_NULL:	return 3;
+        case cJSON_Number:
+            v=node->valuedouble==0?0:node->valuedouble;	//0-0
+            memcpy(&bits,&v,sizeof(bits));
+            return hash_mix(bits^4);
+        case cJSON_String:	return hash_mix(hash_str(node->valuestring)^5);
+    }
+    return 0;
+}
+
+//f->aӽڵcĹϣhcf->h
+static void hash_child(tree_frame *f,cJSON *c,unsigned long long hc)
+{
+    if ((f->a->type&255)==cJSON_Array) f->h=hash_mix(f->h+hc);
+    else f->h+=hash_mix(hash_str(c->string)^hash_mix(hc));
+}
+
+//ʼcĹϣ
+static int hash_enter(diff_state *d,tree_stack *st,cJSON *c)
+{
+    tree_frame *f;
+    if (!cJSON_Expand(c) || !(f=tree_push(st,c,0))) {
+        d->fail=1;
+        return 0;
+    }
+    f->h=(c->type&255)==cJSON_Array?6:7;
+    return 1;
+}
+
+/* ݹϣ: ȵֵ(node_equal)ϣͬ. ĳԱֵĹϣ, Ա˳޹.
+   ջÿһһڼ, ӽڵ㶼Ժ½, ټһ */
+static unsigned long long node_hash(diff_state *d,cJSON *node)
+{
+    tree_stack st;
+    tree_frame *f;
+    unsigned long long h=0;
+    cJSON *c;
+
+    if (!is_container(node)) return scalar_hash(node);
+    if (memo_get(d,node,&h)) return h;
+    tree_init(&st);
+    if (hash_enter(d,&st,node)) while (st.depth) {
+        f=&st.frames[st.depth-1];
+        if ((c=f->x)) {
+            f->x=c->next;
+            if (!is_container(c)) hash_child(f,c,scalar_hash(c));
+            else if (memo_get(d,c,&h)) hash_child(f,c,h);
+            else if (!hash_enter(d,&st,c)) break;
+            continue;
+        }
+        h=f->h,c=f->a;
+        memo_put(d,c,h);
+        if (--st.depth) hash_child(&st.frames[st.depth-1],c,h);
+    }
+    if (st.depth) h=0;
+    tree_free(&st);
+    return h;
+}
+
+//Ƚһֵ: ֱӱȽ, ͬѹջ, ֮Ƚӽڵ. 0ʾ
+static int equal_enter(tree_stack *st,cJSON *a,cJSON *b)
+{
+    if ((a->type&255)!=(b->type&255)) return 0;
+    switch (a->type&255) {
+        case cJSON_Number:
+            return a->valuedouble==b->valuedouble && a->valueint64==b->valueint64;
+        case cJSON_String:
+            return !strcmp(a->valuestring?a->valuestring:"",b->valuestring?b->valuestring:"");
+        case cJSON_Array:
+        case cJSON_Object:
+            return cJSON_Expand(a) && cJSON_Expand(b) && tree_push(st,a,b);
+    }
+    return 1;
+}
+
+/* ֵ: ͬ, ֵֵͬ, ַͬ, Ԫ, ĳԱ(ִСд)һһ.
+   ڴ治ʱ0 */
+static int node_equal(cJSON *a,cJSON *b)
+{
+    tree_stack st;
+    tree_frame *f;
+    cJSON *x,*y;
+    int ok;
+
+    tree_init(&st);
+    ok=equal_enter(&st,a,b);
+    while (ok && st.depth) {
+        f=&st.frames[st.depth-1];
+        x=f->x;
+        if ((f->a->type&255)==cJSON_Array) {
+            if (!x || !f->y) {		//һߵԪ
+                ok=!x && !f->y;
+                st.depth--;
+                continue;
+            }
+            y=f->y;
+            f->y=y->next;
+        } else {
+            if (!x) {				//aĳԱbҵ, bиĳԱ
+                for (y=f->b->child; y; y=y->next) f->n--;
+                ok=!f->n;
+                st.depth--;
+                continue;
+            }
+            f->n++;
+            if (!(y=cJSON_GetObjectItemCaseSensitive(f->b,x->string))) ok=0;
+        }
+        f->x=x->next;
+        if (ok) ok=equal_enter(&st,x,y);
+    }
+    tree_free(&st);
+    return ok;
+}
+
+//ϣͬһ, ϣͬٱȽȷ
+static int diff_same(diff_state *d,cJSON *a,cJSON *b)
+{
+    int t=a->type&255;
+    if (t==cJSON_Array || t==cJSON_Object) {
+        if (node_hash(d,a)!=node_hash(d,b)) return 0;
+    }
+    return node_equal(a,b);
+}
+
+static void diff_init(diff_state *d)
+{
+    cJSON_Context ctx;
+    cJSON_InitContext(&ctx);
+    memset(d,0,sizeof(diff_state));
+    d->malloc_fn=ctx.malloc_fn;
+    d->free_fn=ctx.free_fn;
+}
+
+static void diff_free(diff_state *d)
+{
+    if (d->nodes) d->free_fn(d->nodes);
+    if (d->path) d->free_fn(d->path);
+    if (d->tasks) d->free_fn(d->tasks);
+}
+
+//ѹһ, ڵǰ·(ڵ·)ִ
+static void task_push(diff_state *d,char op,cJSON *from,cJSON *to,const char *key,int index)
+{
+    diff_task *t;
+    if (d->fail) return;
+    if (d->ntasks==d->task_cap) {	//
+        if (!(t=(diff_task*)d->malloc_fn((d->task_cap?2*d->task_cap:64)*sizeof(diff_task)))) {
+            d->fail=1;
+            return;
+        }
+        if (d->tasks) {
+            memcpy(t,d->tasks,d->ntasks*sizeof(diff_task));
+            d->free_fn(d->tasks);
+        }
+        d->tasks=t;
+        d->task_cap=d->task_cap?2*d->task_cap:64;
+    }
+    t=&d->tasks[d->ntasks++];
+    t->op=op,t->from=from,t->to=to,t->key=key,t->index=index,t->mark=d->len;
+}
+
+//Ѵfirstѹ񵹹, ʹǰѹ˳ִ
+static void task_reverse(diff_state *d,int first)
+{
+    diff_task t;
+    int i=first,j=d->ntasks-1;
+    if (d->fail) return;
+    for (; i<j; i++,j--) t=d->tasks[i],d->tasks[i]=d->tasks[j],d->tasks[j]=t;
+}
+
+/* ·׷"/"token(ת'~''/'), ׷ǰĳ, path_truncָ */
+static size_t path_push(diff_state *d,const char *token)
+{
+    size_t mark=d->len,need=d->len+2*strlen(token)+2;
+    char *p;
+    if (need>d->path_cap) {
+        while (d->path_cap<need) d->path_cap=d->path_cap?d->path_cap*2:256;
+        if (!(p=(char*)d->malloc_fn(d->path_cap))) {
+            d->fail=1;
+            return mark;
+        }
+        if (d->path) {
+            memcpy(p,d->path,d->len+1);
+            d->free_fn(d->path);
+        }
+        d->path=p;
+    }
+    p=d->path+d->len;
+    *p++='/';
+    for (; *token; token++) {
+        if (*token=='~') *p++='~',*p++='0';
+        else if (*token=='/') *p++='~',*p++='1';
+        else *p++=*token;
+    }
+    *p=0;
+    d->len=p-d->path;
+    return mark;
+}
+
+static size_t path_index(diff_state *d,int i)
+{
+    char buf[16];
+    sprintf(buf,"%d",i);
+    return path_push(d,buf);
+}
+
+static void path_trunc(diff_state *d,size_t mark)
+{
+    if (d->path) d->path[d->len=mark]=0;
+}
+
+/* ׷һ{"op":op,"path":ǰ·,"value":valueĸ}, valueΪ0ʱû"value" */
+static void diff_op(diff_state *d,const char *op,cJSON *value)
+{
+    cJSON *o,*v=0;
+    if (d->fail) return;
+    if (!(o=cJSON_CreateObject())) {
+        d->fail=1;
+        return;
+    }
+    cJSON_AddItemToArray(d->patch,o);
+    cJSON_AddStringToObject(o,"op",op);
+    cJSON_AddStringToObject(o,"path",d->path?d->path:"");
+    if (value && (v=cJSON_Duplicate(value,1))) cJSON_AddItemToObject(o,"value",v);
+    if (!cJSON_GetObjectItem(o,"path") || (value && !v)) d->fail=1;
+}
+
+static void diff_value(diff_state *d,cJSON *from,cJSON *to);
+
+static void diff_object(diff_state *d,cJSON *from,cJSON *to)
+{
+    cJSON *c,*t;
+    int first=d->ntasks;
+    for (c=from->child; c && !d->fail; c=c->next) {
+        t=cJSON_GetObjectItemCaseSensitive(to,c->string);
+        task_push(d,t?'=':'d',c,t,c->string,-1);
+    }
+    for (t=to->child; t && !d->fail; t=t->next)
+        if (!cJSON_GetObjectItemCaseSensitive(from,t->string)) task_push(d,'a',0,t,t->string,-1);
+    task_reverse(d,first);
+}
+
+/* Myers: Ԫعϣha[0..n), hb[0..m)̵ı༭ű, O((n+m)D)ʱ, O(D^2)ռ.
+   script[]Ϊ'm'(߸һԪضӦ), 'd'(ɾhaһԪ), 'i'(hbһԪ), ؽű.
+   ༭볬DIFF_MAX_EDITSʱ-1, ɵ߰λñȽ */
+#define DIFF_MAX_EDITS 256
+static int diff_myers(diff_state *d,const unsigned long long *ha,int n,const unsigned long long *hb,int m,char *script)
+{
+    int max=n+m<DIFF_MAX_EDITS?n+m:DIFF_MAX_EDITS;
+    int *v,*trace,*pv,off=max+1,e,k,x,y,pk,px,py,len=0,i;
+    if (!(v=(int*)d->malloc_fn(((size_t)(2*max+3)+(size_t)(max+1)*(max+1))*sizeof(int)))) {
+        d->fail=1;
+        return -1;
+    }
+    trace=v+2*max+3;	//eʱv[-e..e]trace[e*e..]
+    v[off+1]=0;
+    for (e=0; e<=max; e++) {
+        for (k=-e; k<=e; k+=2) {
+            if (k==-e || (k!=e && v[off+k-1]<v[off+k+1])) x=v[off+k+1];	//
+            else x=v[off+k-1]+1;	//ɾ
+            y=x-k;
+            while (x<n && y<m && ha[x]==hb[y]) x++,y++;
+            v[off+k]=x;
+            if (x>=n && y>=m) break;
+        }
+        for (i=-e; i<=e; i++) trace[e*e+i+e]=v[off+i];
+        if (k<=e) break;
+    }
+    if (e>max) {
+        d->free_fn(v);
+        return -1;
+    }
+    /* յ㵹: ÿһһɾһζӦ */
+    for (x=n,y=m; e>0; e--) {
+        pv=trace+(e-1)*(e-1)+(e-1);
+        k=x-y;
+        pk=(k==-e || (k!=e && pv[k-1]<pv[k+1]))?k+1:k-1;
+        px=pv[pk];
+        py=px-pk;
+        while (x>(pk==k+1?px:px+1) && y>(pk==k+1?py+1:py)) script[len++]='m',x--,y--;
+        script[len++]=(pk==k+1)?'i':'d';
+        x=px,y=py;
+    }
+    while (x>0 && y>0) script[len++]='m',x--,y--;
+    d->free_fn(v);
+    for (i=0; i<len/2; i++) k=script[i],script[i]=script[len-1-i],script[len-1-i]=(char)k;
+    return len;
+}
+
+/* : ȥϣͬǰ׺ͺ׺, м䲿Myersֶ. űڵɾͲԵݹȽ(Ԫر޸),
+   ɾremove, Ĳadd. ӦԪҲݹȽ, ϣײʱnode_equalֲɲ.
+   ·±curʼԪӦǰеλ */
+static void diff_array(diff_state *d,cJSON *from,cJSON *to)
+{
+    cJSON **a,**b,*c;
+    unsigned long long *ha,*hb;
+    char *script;
+    int na=0,nb=0,p=0,s=0,la,lb,i,j,len,cur,x,y,nd,ni,first=d->ntasks;
+    for (c=from->child; c; c=c->next) na++;
+    for (c=to->child; c; c=c->next) nb++;
+    a=(cJSON**)d->malloc_fn((size_t)(na+nb+1)*(sizeof(cJSON*)+sizeof(unsigned long long)+1));
+    if (!a) {
+        d->fail=1;
+        return;
+    }
+    b=a+na;
+    ha=(unsigned long long*)(b+nb+1);
+    hb=ha+na;
+    script=(char*)(hb+nb+1);
+    for (i=0,c=from->child; c; c=c->next) ha[i]=node_hash(d,c),a[i++]=c;
+    for (i=0,c=to->child; c; c=c->next) hb[i]=node_hash(d,c),b[i++]=c;
+    while (p<na && p<nb && ha[p]==hb[p]) p++;
+    while (s<na-p && s<nb-p && ha[na-1-s]==hb[nb-1-s]) s++;
+    for (i=0; i<p && !d->fail; i++) task_push(d,'=',a[i],b[i],0,i);
+    la=na-p-s,lb=nb-p-s;
+    len=diff_myers(d,ha+p,la,hb+p,lb,script);
+    if (len<0) {	//Ķ̫: λñȽ
+        for (len=0,i=0; i<la && i<lb; i++) script[len++]='m';
+        for (; i<la; i++) script[len++]='d';
+        for (; i<lb; i++) script[len++]='i';
+    }
+    for (cur=p,x=p,y=p,i=0; i<len && !d->fail; ) {
+        if (script[i]=='m') {
+            task_push(d,'=',a[x++],b[y++],0,cur++);
+            i++;
+            continue;
+        }
+        for (nd=ni=0; i<len && script[i]!='m'; i++) script[i]=='d'?nd++:ni++;	//һɾͲ
+        for (j=0; j<nd && j<ni; j++) task_push(d,'=',a[x++],b[y++],0,cur++);
+        for (; j<nd; j++,x++) task_push(d,'d',0,0,0,cur);
+        for (; j<ni; j++) task_push(d,'a',0,b[y++],0,cur++);
+    }
+    for (i=nb-s; i<nb && !d->fail; i++) task_push(d,'=',a[i-nb+na],b[i],0,i);
+    task_reverse(d,first);
+    d->free_fn(a);
+}
+
+static void diff_value(diff_state *d,cJSON *from,cJSON *to)
+{
+    int t=from->type&255;
+    if (diff_same(d,from,to)) return;
+    if (t!=(to->type&255) || (t!=cJSON_Array && t!=cJSON_Object)) diff_op(d,"replace",to);
+    else if (t==cJSON_Object) diff_object(d,from,to);
+    else diff_array(d,from,to);
+}
+
+cJSON *cJSON_Diff(cJSON *from,cJSON *to)
+{
+    diff_state d;
+    diff_task t;
+    if (!from || !to) return 0;
+    diff_init(&d);
+    if (!(d.patch=cJSON_CreateArray())) return 0;
+    task_push(&d,'=',from,to,0,-1);
+    while (d.ntasks && !d.fail) {
+        t=d.tasks[--d.ntasks];		//ִʱѹ, ȸƳ
+        path_trunc(&d,t.mark);
+        if (t.key) path_push(&d,t.key);
+        else if (t.index>=0) path_index(&d,t.index);
+        if (t.op=='=') diff_value(&d,t.from,t.to);
+        else diff_op(&d,t.op=='a'?"add":"remove",t.to);
+    }
+    diff_free(&d);
+    if (d.fail) {
+        cJSON_Delete(d.patch);
+        return 0;
+    }
+    return d.patch;
+}
+
+static void merge_add(diff_state *d,cJSON *patch,const char *key,cJSON *item)
+{
+    if (item) cJSON_AddItemToObject(patch,key,item);
+    else d->fail=1;
+}
+
+static int both_objects(cJSON *a,cJSON *b)
+{
+    return (a->type&255)==cJSON_Object && (b->type&255)==cJSON_Object;
+}
+
+/* ֮merge patch. ԱpatchȰ˳Žһpatch, Ϊջеһд */
+static cJSON *merge_diff(diff_state *d,cJSON *from,cJSON *to)
+{
+    tree_stack st;
+    tree_frame *f;
+    cJSON *patch,*o,*c,*t,*n;
+    if (!both_objects(from,to)) return cJSON_Duplicate(to,1);
+    if (!(patch=cJSON_CreateObject())) return 0;
+    tree_init(&st);
+    if (!(f=tree_push(&st,from,to))) d->fail=1;
+    else f->x=patch;
+    while (st.depth && !d->fail) {
+        f=&st.frames[--st.depth];
+        from=f->a,to=f->b,o=f->x;	//֮ѹջḲһ
+        if (!cJSON_Expand(from) || !cJSON_Expand(to)) {
+            d->fail=1;
+            break;
+        }
+        for (c=from->child; c && !d->fail; c=c->next) {
+            if (!(t=cJSON_GetObjectItemCaseSensitive(to,c->string))) merge_add(d,o,c->string,cJSON_CreateNull());
+            else if (diff_same(d,c,t)) continue;
+            else if (!both_objects(c,t)) merge_add(d,o,c->string,cJSON_Duplicate(t,1));
+            else {
+                merge_add(d,o,c->string,n=cJSON_CreateObject());
+                if (n && !(f=tree_push(&st,c,t))) d->fail=1;
+                else if (n) f->x=n;
+            }
+        }
+        for (t=to->child; t && !d->fail; t=t->next)
+            if (!cJSON_GetObjectItemCaseSensitive(from,t->string)) merge_add(d,o,t->string,cJSON_Duplicate(t,1));
+    }
+    tree_free(&st);
+    return patch;
+}
+
+cJSON *cJSON_MergeDiff(cJSON *from,cJSON *to)
+{
+    diff_state d;
+    cJSON *patch;
+    if (!from || !to) return 0;
+    diff_init(&d);
+    patch=merge_diff(&d,from,to);
+    diff_free(&d);
+    if (d.fail) {
+        cJSON_Delete(patch);
+        return 0;
+    }
+    return patch;
+}
+
+/* ڵ(ֵ͡ӽڵ), ڵ㱾ļλò. 滻ڵԭ޸һԱ */
+#define NODE_BITS (cJSON_StringIsConst|cJSON_StringIsInterned|cJSON_StringIsPooled|cJSON_IsArena)
+static void swap_content(cJSON *a,cJSON *b)
+{
+    cJSON t=*a;
+    a->type=(a->type&NODE_BITS)|(b->type&~NODE_BITS);
+    a->valuestring=b->valuestring;
+    a->valueint=b->valueint;
+    a->valuedouble=b->valuedouble;
+    a->valueint64=b->valueint64;
+    a->child=b->child;
+    a->extra=b->extra;
+    b->type=(b->type&NODE_BITS)|(t.type&~NODE_BITS);
+    b->valuestring=t.valuestring;
+    b->valueint=t.valueint;
+    b->valuedouble=t.valuedouble;
+    b->valueint64=t.valueint64;
+    b->child=t.child;
+    b->extra=t.extra;
+}
+
+//nodeݻvalue, ɵvalueɾ
+static int set_content(cJSON *node,cJSON *value)
+{
+    if (!value) return 0;
+    swap_content(node,value);
+    cJSON_Delete(value);
+    return 1;
+}
+
+/* JSON Pointerһtokenkey, token֮λ('/''\0'). ת岻Ϸʱ0 */
+static const char *pointer_token(const char *p,char *key)
+{
+    for (; *p && *p!='/'; p++) {
+        if (*p!='~') *key++=*p;
+        else if (p[1]=='0' || p[1]=='1') *key++=(*++p=='0')?'~':'/';
+        else return 0;
+    }
+    *key=0;
+    return p;
+}
+
+static cJSON *pointer_child(cJSON *node,const char *key)
+{
+    int i;
+    if ((node->type&255)==cJSON_Object) return cJSON_GetObjectItemCaseSensitive(node,key);
+    if ((node->type&255)==cJSON_Array && (i=pointer_index(key))>=0) return cJSON_GetArrayItem(node,i);
+    return 0;
+}
+
+/* ҵpathһtokenڵ*parent, tokenkey(strlen(path)+1ֽ).
+   pathΪ""(ĵ)ʱ*parentΪ0. мĽڵ㲻ڻpathϷʱ0 */
+static int patch_resolve(cJSON *doc,const char *path,char *key,cJSON **parent)
+{
+    cJSON *node=doc;
+    *parent=0;
+    if (!*path) return 1;
+    if (*path!='/') return 0;
+    for (;;) {
+        if (!(path=pointer_token(path+1,key))) return 0;
+        if (!*path) {
+            *parent=node;
+            return 1;
+        }
+        if (!(node=pointer_child(node,key))) return 0;
+    }
+}
+
+static cJSON *patch_target(cJSON *doc,const char *path,char *key)
+{
+    cJSON *parent;
+    if (!patch_resolve(doc,path,key,&parent)) return 0;
+    return parent?pointer_child(parent,key):doc;
+}
+
+/* add: valueŵpath. еĳԱ滻, в뵽±괦("-"Ϊĩβ). ʧʱvalueԹ */
+static int patch_place(cJSON *doc,const char *path,cJSON *value,char *key)
+{
+    cJSON *parent,*c;
+    int i,n;
+    if (!value || !patch_resolve(doc,path,key,&parent)) return 0;
+    if (!parent) return set_content(doc,value);
+    if ((parent->type&255)==cJSON_Object) {
+        if ((c=cJSON_GetObjectItemCaseSensitive(parent,key))) cJSON_ReplaceItemViaPointer(parent,c,value);
+        else cJSON_AddItemToObject(parent,key,value);
+        return 1;
+    }
+    if ((parent->type&255)==cJSON_Array) {
+        n=cJSON_GetArraySize(parent);
+        i=strcmp(key,"-")?pointer_index(key):n;
+        if (i<0 || i>n) return 0;
+        if (i==n) cJSON_AddItemToArray(parent,value);
+        else cJSON_InsertItemInArray(parent,i,value);
+        return 1;
+    }
+    return 0;
+}
+
+//patch_place, ʧʱɾvalue
+static int patch_add(cJSON *doc,const char *path,cJSON *value,char *key)
+{
+    if (patch_place(doc,path,value,key)) return 1;
+    cJSON_Delete(value);
+    return 0;
+}
+
+//pathĽڵ, pathĵ
+static cJSON *patch_detach(cJSON *doc,const char *path,char *key)
+{
+    cJSON *parent,*c;
+    if (!patch_resolve(doc,path,key,&parent) || !parent || !(c=pointer_child(parent,key))) return 0;
+    return cJSON_DetachItemViaPointer(parent,c);
+}
+
+static const char *string_member(cJSON *op,const char *name)
+{
+    cJSON *c=cJSON_GetObjectItemCaseSensitive(op,name);
+    return c && (c->type&255)==cJSON_String?c->valuestring:0;
+}
+
+static int patch_op(cJSON *doc,cJSON *op,const char *name,const char *path,const char *from,char *key)
+{
+    cJSON *value=cJSON_GetObjectItemCaseSensitive(op,"value"),*parent,*c,*s;
+    size_t n;
+    int i;
+    if (!strcmp(name,"add")) return value && patch_add(doc,path,cJSON_Duplicate(value,1),key);
+    if (!strcmp(name,"remove")) {
+        if (!(c=patch_detach(doc,path,key))) return 0;
+        cJSON_Delete(c);
+        return 1;
+    }
+    if (!strcmp(name,"replace")) {
+        if (!value || !patch_resolve(doc,path,key,&parent)) return 0;
+        if (!parent) return set_content(doc,cJSON_Duplicate(value,1));
+        if (!(c=pointer_child(parent,key)) || !(value=cJSON_Duplicate(value,1))) return 0;
+        cJSON_ReplaceItemViaPointer(parent,c,value);
+        return 1;
+    }
+    if (!strcmp(name,"test")) return value && (c=patch_target(doc,path,key)) && node_equal(c,value);
+    if (!from) return 0;
+    if (!strcmp(name,"copy")) return (c=patch_target(doc,from,key)) && patch_add(doc,path,cJSON_Duplicate(c,1),key);
+    if (!strcmp(name,"move")) {
+        if (!strcmp(from,path)) return patch_target(doc,from,key)!=0;
+        n=strlen(from);
+        if (!strncmp(path,from,n) && path[n]=='/') return 0;	//ƶԼӽڵ
+        if (!patch_resolve(doc,from,key,&parent) || !parent || !(c=pointer_child(parent,key))) return 0;
+        for (i=0,s=parent->child; s!=c; s=s->next) i++;
+        c=cJSON_DetachItemViaPointer(parent,c);
+        if (patch_place(doc,path,c,key)) return 1;
+        cJSON_InsertItemInArray(parent,i,c);	//pathܷʱŻԭ(cԴԭļ), κθĶ
+        return 0;
+    }
+    return 0;
+}
+
+int cJSON_ApplyPatch(cJSON *doc,cJSON *patch)
+{
+    cJSON_Context ctx;
+    cJSON *op;
+    const char *name,*path,*from;
+    char buf[256],*key;
+    size_t n;
+    int ok=1;
+    if (!doc || !patch || (patch->type&255)!=cJSON_Array) return 0;
+    cJSON_InitContext(&ctx);
+    cJSON_ArrayForEach(op,patch) {
+        if (!(name=string_member(op,"op")) || !(path=string_member(op,"path"))) return 0;
+        from=string_member(op,"from");
+        n=strlen(path);
+        if (from && strlen(from)>n) n=strlen(from);
+        if (!(key=n<sizeof(buf)?buf:(char*)ctx.malloc_fn(n+1))) return 0;	//token·
+        ok=patch_op(doc,op,name,path,from,key);
+        if (key!=buf) ctx.free_fn(key);
+        if (!ok) return 0;
+    }
+    return 1;
+}
+
+//patchϲtarget: targetǶʱȻɿն, Ȼѹջ, ϲpatchĳԱ
+static int merge_enter(tree_stack *st,cJSON *target,cJSON *patch)
+{
+    if ((target->type&255)!=cJSON_Object && !set_content(target,cJSON_CreateObject())) return 0;
+    return cJSON_Expand(target) && cJSON_Expand(patch) && tree_push(st,target,patch);
+}
+
+/* RFC 7386: patchǶʱ滻target; ǶʱϲԱ, nullʾɾ.
+   ջÿһһںϲĶ, һԱϲ(²)ֵһԱ, ݹ˳ͬ */
+static int merge_apply(cJSON *target,cJSON *patch)
+{
+    tree_stack st;
+    tree_frame *f;
+    cJSON *m,*c;
+    int ok;
+    if ((patch->type&255)!=cJSON_Object) return set_content(target,cJSON_Duplicate(patch,1));
+    tree_init(&st);
+    ok=merge_enter(&st,target,patch);
+    while (ok && st.depth) {
+        f=&st.frames[st.depth-1];
+        if (!(m=f->y)) {
+            st.depth--;
+            continue;
+        }
+        f->y=m->next;
+        target=f->a;
+        c=cJSON_GetObjectItemCaseSensitive(target,m->string);
+        if ((m->type&255)==cJSON_NULL) {
+            if (c) cJSON_Delete(cJSON_DetachItemViaPointer(target,c));
+            continue;
+        }
+        if (!c) {	//³Ա: ȼһnull, ٰpatchϲȥ(ȥеnull)
+            if (!(c=cJSON_CreateNull())) ok=0;
+            else cJSON_AddItemToObject(target,m->string,c);
+        }
+        if (!ok) break;
+        if ((m->type&255)!=cJSON_Object) ok=set_content(c,cJSON_Duplicate(m,1));
+        else ok=merge_enter(&st,c,m);
+    }
+    tree_free(&st);
+    return ok;
+}
+
+int cJSON_ApplyMergePatch(cJSON *doc,cJSON *patch)
+{
+    if (!doc || !patch) return 0;
+    return merge_apply(doc,patch);
+}
@@ -0,0 +1,139 @@
+/*
+  Copyright (c) 2009 Dave Gamble
+ 
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+ 
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+ 
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+#ifndef cJSON_Utils__h
+#define cJSON_Utils__h
+
+#include "cJSON.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Queries over a tree: JSON Pointers (RFC 6901) and a small JSONPath subset, compiled once and run on many trees:
+	cJSON_Query *q=cJSON_QueryCompile("$.users[*].name");
+	for (...each request...) {
+		cJSON_QueryEach(q,root,print_name,0);
+		id=cJSON_QueryFirst(q_id,root);
+	}
+	cJSON_QueryDelete(q);
+   Object members are looked up with cJSON_GetObjectItemCaseSensitive and array elements with cJSON_GetArrayItem,
+   so the object key index and the array vector are used once they exist. On a tree from cJSON_ParseLazy only the
+   containers the query passes through are built; nothing else of the text is turned into nodes. */
+typedef struct cJSON_Query cJSON_Query;
+
+/* Compile a JSON Pointer: "" is the whole document, "/a/0/b~1c" is member "a", element (or member) "0", member "b/c".
+   Returns 0 if pointer is malformed (doesn't start with '/', or '~' not followed by '0' or '1'). */
+extern cJSON_Query *cJSON_QueryPointer(const char *pointer);
+/* Compile a JSONPath. Supported: $ followed by any of .name, ['name'] or ["name"] (backslash escapes the next
+   character), [n] (negative n counts from the end), .* and [*] (every member or element), ..name and ..* (at any
+   depth below). Member names are case-sensitive. Returns 0 if path is malformed. */
+extern cJSON_Query *cJSON_QueryCompile(const char *path);
+extern void cJSON_QueryDelete(cJSON_Query *query);
+
+/* The first match in document order, or 0. */
+extern cJSON *cJSON_QueryFirst(const cJSON_Query *query,cJSON *root);
+/* Call fn(user,match) for every match in document order, until fn returns 0. Returns the number of matches passed to fn. */
+extern int cJSON_QueryEach(const cJSON_Query *query,cJSON *root,int (*fn)(void *user,cJSON *match),void *user);
+/* Run query on length bytes of text without building the whole tree: the text is parsed with cJSON_ParseLazy and
+   only the path to the match is expanded ("..name" still has to look everywhere). Returns a standalone copy of the
+   first match (free it with cJSON_Delete), or 0 if there is none or the text is malformed on the way. */
+extern cJSON *cJSON_QueryText(const cJSON_Query *query,const char *text,size_t length);
+
+/* One-off lookup of a JSON Pointer, without keeping the compiled query. */
+extern cJSON *cJSON_GetPointer(cJSON *root,const char *pointer);
+
+/* Struct binding: a table of fields maps the members of a JSON object straight onto the members of a C struct,
+   so a payload whose shape is known up front is decoded and encoded without building a cJSON tree:
+	struct record { char *city; double lat,lon; int zip; };
+	static const cJSON_Binding record_fields[]={
+		{"city",cJSON_BindString,offsetof(struct record,city)},
+		{"lat",cJSON_BindDouble,offsetof(struct record,lat)},
+		{"lon",cJSON_BindDouble,offsetof(struct record,lon)},
+		{"zip",cJSON_BindInt,offsetof(struct record,zip)},
+		{0}
+	};
+	struct record r={0};
+	if (cJSON_BindParse(0,text,len,record_fields,&r)) ...
+	out=cJSON_BindPrint(record_fields,&r,1);
+	cJSON_BindFree(0,record_fields,&r);
+   Members whose key isn't in the table are skipped (with everything nested in them); fields whose key is absent keep
+   what they held. A value of the wrong type (a string for cJSON_BindInt, a fraction or a number out of range for an
+   integer field, a string that doesn't fit a cJSON_BindChars buffer, more elements than an array holds) fails the
+   parse, with the error position at that value. null clears the field (to 0, an empty string or no elements). */
+enum {
+	cJSON_BindInt=1,	/* int, from an integer */
+	cJSON_BindInt64,	/* long long, from an integer (exact beyond 2^53) */
+	cJSON_BindDouble,	/* double, from any number */
+	cJSON_BindBool,		/* int set to 0 or 1, from false/true */
+	cJSON_BindString,	/* char *, allocated with the parse's malloc_fn; a string it held is freed first */
+	cJSON_BindChars,	/* char[size], '\0'-terminated, so the text must be shorter than size */
+	cJSON_BindObject,	/* a nested struct, described by fields */
+	cJSON_BindArray		/* a C array of at most size elements, each described by fields[0]; the element count is
+				   stored in the int at count_offset (in the same struct as the array) */
+};
+typedef struct cJSON_Binding {
+	const char *key;	/* Member name, case-sensitive. A table ends with an entry whose key is 0. */
+	int type;		/* cJSON_Bind* */
+	size_t offset;		/* offsetof the member in its struct. Unused in an array's element entry. */
+	size_t size;		/* cJSON_BindChars: the buffer size. cJSON_BindArray: the capacity in elements.
+				   cJSON_BindObject as an array element: sizeof the struct. */
+	const struct cJSON_Binding *fields;	/* cJSON_BindObject: the struct's table. cJSON_BindArray: the element entry. */
+	size_t count_offset;	/* cJSON_BindArray: offsetof the int element count. */
+} cJSON_Binding;
+
+/* Decode the object in length bytes of value into out, which is zeroed or holds an earlier result of this table.
+   ctx (may be 0) supplies the allocator for cJSON_BindString, max_depth and options as for cJSON_ParseSax; errors go
+   to ctx->error, or to cJSON_GetErrorPtr() when ctx is 0. Returns 1 on success, 0 on failure (out may then be partly
+   written: cJSON_BindFree it all the same). Tables may nest at most 32 deep. */
+extern int cJSON_BindParse(cJSON_Context *ctx,const char *value,size_t length,const cJSON_Binding *fields,void *out);
+/* Encode in as the object described by fields: the same text cJSON_Print (fmt=1) or cJSON_PrintUnformatted (fmt=0)
+   gives for the equivalent tree, members in table order, a 0 cJSON_BindString as null. Free the char* when finished. */
+extern char *cJSON_BindPrint(const cJSON_Binding *fields,const void *in,int fmt);
+/* Free the cJSON_BindString members of in (recursively) with ctx's free_fn (ctx may be 0), and set them to 0. */
+extern void cJSON_BindFree(cJSON_Context *ctx,const cJSON_Binding *fields,void *in);
+
+/* Diff and patch. cJSON_Diff returns the JSON Patch (RFC 6902) that turns from into to: an array of "add", "remove"
+   and "replace" operations, so a small change to a big document gives a small patch. Every container of both trees
+   is hashed once, so equal subtrees are recognised by their hash (confirmed by a compare) and skipped without being
+   walked again, and arrays are diffed around their common prefix and suffix: inserting or deleting an element in the
+   middle is one operation, not a replace of everything after it. Returns 0 if out of memory. Delete with cJSON_Delete. */
+extern cJSON *cJSON_Diff(cJSON *from,cJSON *to);
+/* The JSON Merge Patch (RFC 7386) that turns from into to. Merge patches can't express a null member or a change
+   inside an array (the whole array is sent), but are often smaller for objects. */
+extern cJSON *cJSON_MergeDiff(cJSON *from,cJSON *to);
+
+/* Apply a JSON Patch to doc in place, through the detach/insert/replace calls: only the nodes the operations touch are
+   changed, and the root pointer stays valid (an operation on path "" swaps the root's content). All six operations are
+   supported (add, remove, replace, move, copy, test); object keys are case-sensitive. Returns 1 on success, 0 if the
+   patch is malformed or an operation fails; the operations before the failing one stay applied, the failing one changes
+   nothing (apply to a cJSON_Duplicate if you need all-or-nothing). */
+extern int cJSON_ApplyPatch(cJSON *doc,cJSON *patch);
+/* Apply a JSON Merge Patch to doc in place. Returns 1 on success, 0 if out of memory. */
+extern int cJSON_ApplyMergePatch(cJSON *doc,cJSON *patch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
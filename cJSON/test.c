@@ -1,6 +1,43 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "cJSON.h"
+#include <stddef.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include "cJSON_Utils.h"
+#include "cJSON_Batch.h"
+
+/* : gcc cJSON.c cJSON_Utils.c cJSON_Batch.c test.c -o test -lm -lpthread
+   ʾ, Ȼ: ʧܵļӡ, ʧʱ1 */
+static int checks,failures;
+#define CHECK(cond) check((cond)!=0,#cond,__LINE__)
+static void check(int ok,const char *what,int line)
+{
+    checks++;
+    if (!ok) {
+        failures++;
+        printf("test.c:%d: check failed: %s\n",line,what);
+    }
+}
+
+/* itemʽӡĽǷΪexpect(ͬʱӡʵʵĽ) */
+static int prints_as(cJSON *item,const char *expect)
+{
+    char *out=item?cJSON_PrintUnformatted(item):0;
+    int ok=out && !strcmp(out,expect);
+    if (out && !ok) printf("  got: %s\n",out);
+    free(out);
+    return ok;
+}
+/* textٲʽӡ, ǷΪexpect */
+static int parses_as(const char *text,const char *expect)
+{
+    cJSON *json=cJSON_Parse(text);
+    int ok=prints_as(json,expect);
+    cJSON_Delete(json);
+    return ok;
+}
 
 /* ıΪJSONȻȾıӡ! */
 void doit(char *text)
@@ -134,6 +171,1710 @@ void create_objects()
 
 }
 
+/* user-001: arena. һarena, reset֮ͬһchunk */
+static void test_arena(void)
+{
+    cJSON_Arena *arena=cJSON_ArenaCreate(64);	//Сchunk,ǿƷ
+    cJSON *a,*b;
+    int i;
+
+    CHECK(arena!=0);
+    a=cJSON_ParseInArena(arena,"{\"name\":\"Jack\",\"ids\":[1,2,3],\"nested\":{\"deep\":[true,false,null]}}");
+    b=cJSON_ParseInArena(arena,"[\"a much longer string than one chunk can hold: 0123456789012345678901234567890123456789\"]");
+    CHECK(a && (a->type&cJSON_IsArena));
+    CHECK(prints_as(a,"{\"name\":\"Jack\",\"ids\":[1,2,3],\"nested\":{\"deep\":[true,false,null]}}"));
+    CHECK(prints_as(b,"[\"a much longer string than one chunk can hold: 0123456789012345678901234567890123456789\"]"));
+    CHECK(cJSON_GetArraySize(cJSON_GetObjectItem(a,"ids"))==3);
+
+    /* ԼӵarenaϵĽڵcJSON_Deleteͷ, arenaеĽڵ㲻Ӱ */
+    cJSON_AddItemToObject(a,"own",cJSON_CreateString("malloc'd"));
+    CHECK(prints_as(cJSON_GetObjectItem(a,"own"),"\"malloc'd\""));
+    cJSON_Delete(a);
+
+    CHECK(cJSON_ParseInArena(arena,"{\"a\":}")==0);
+    CHECK(cJSON_GetErrorPtr() && *cJSON_GetErrorPtr()=='}');
+
+    for (i=0; i<3; i++) {	//reset֮ٽ: һͬ
+        cJSON_ArenaReset(arena);
+        a=cJSON_ParseInArena(arena,"{\"k\":[1.5,\"s\",{}]}");
+        CHECK(prints_as(a,"{\"k\":[1.5,\"s\",{}]}"));
+    }
+    CHECK(cJSON_ParseInArena(0,"1")==0);
+    cJSON_ArenaDelete(arena);
+}
+
+/* ķ亯: »ûͷŵĿ */
+static int live_blocks;
+static void *counting_malloc(size_t sz)
+{
+    live_blocks++;
+    return malloc(sz);
+}
+static void counting_free(void *ptr)
+{
+    if (ptr) live_blocks--;
+    free(ptr);
+}
+
+/* user-002: cJSON_Context. 亯λáǶƺѡֻcontext */
+static void test_context(void)
+{
+    cJSON_Context ctx;
+    cJSON *json;
+    const char *end;
+    char *out;
+
+    cJSON_InitContext(&ctx);
+    ctx.malloc_fn=counting_malloc,ctx.free_fn=counting_free;
+    json=cJSON_ParseCtx(&ctx,"{\"a\":[1,\"two\",{\"b\":null}]}",0);
+    CHECK(json && live_blocks>0 && ctx.error==0);
+    out=cJSON_PrintCtx(&ctx,json,0);
+    CHECK(out && !strcmp(out,"{\"a\":[1,\"two\",{\"b\":null}]}"));
+    ctx.free_fn(out);
+    cJSON_DeleteCtx(&ctx,json);
+    CHECK(live_blocks==0);
+
+    /* λдctx, ӰȫֵcJSON_GetErrorPtr */
+    cJSON_Delete(cJSON_Parse("[1,2]"));
+    CHECK(cJSON_ParseCtx(&ctx,"[1,2,,3]",0)==0);
+    CHECK(ctx.error && !strcmp(ctx.error,",3]"));
+    CHECK(cJSON_GetErrorPtr()==0);
+    CHECK(live_blocks==0);	//ʧʱѾĲֱͷ
+
+    ctx.max_depth=2;
+    json=cJSON_ParseCtx(&ctx,"[[1]]",0);
+    CHECK(json!=0);
+    cJSON_DeleteCtx(&ctx,json);
+    CHECK(cJSON_ParseCtx(&ctx,"[[[1]]]",0)==0);
+    CHECK(ctx.error && !strcmp(ctx.error,"[1]]]"));
+
+    ctx.max_depth=0;
+    ctx.options=cJSON_OptRequireNullTerminated;
+    CHECK(cJSON_ParseCtx(&ctx,"1 x",0)==0);
+    json=cJSON_ParseCtx(&ctx,"1 \n",&end);
+    CHECK(json && *end==0);
+    cJSON_DeleteCtx(&ctx,json);
+    CHECK(live_blocks==0);
+}
+
+/* user-003: ļ. ҽAdd/Delete/Detach/Replace֮һ */
+static void test_key_index(void)
+{
+    cJSON_Context ctx;
+    cJSON *obj=cJSON_CreateObject(),*item;
+    char key[16],text[2048],*p=text;
+    int i,ok;
+
+    for (i=0; i<200; i++) {
+        sprintf(key,"Key%d",i);
+        cJSON_AddNumberToObject(obj,key,i);
+    }
+    for (ok=1,i=0; i<200; i++) {
+        sprintf(key,"key%d",i);	//Сд
+        item=cJSON_GetObjectItem(obj,key);
+        if (!item || item->valueint!=i) ok=0;
+        sprintf(key,"Key%d",i);
+        item=cJSON_GetObjectItemCaseSensitive(obj,key);
+        if (!item || item->valueint!=i) ok=0;
+    }
+    CHECK(ok);
+    CHECK(cJSON_GetObjectItemCaseSensitive(obj,"key5")==0);
+    CHECK(cJSON_GetObjectItem(obj,"missing")==0);
+
+    cJSON_DeleteItemFromObject(obj,"Key10");
+    CHECK(cJSON_GetObjectItem(obj,"Key10")==0);
+    item=cJSON_DetachItemFromObject(obj,"key20");
+    CHECK(item && item->valueint==20 && cJSON_GetObjectItem(obj,"Key20")==0);
+    cJSON_Delete(item);
+    cJSON_ReplaceItemInObject(obj,"Key30",cJSON_CreateString("thirty"));
+    CHECK(prints_as(cJSON_GetObjectItem(obj,"Key30"),"\"thirty\""));
+    cJSON_AddNumberToObject(obj,"Key10",-10);
+    CHECK(cJSON_GetObjectItem(obj,"key10")->valueint==-10);
+    cJSON_AddNumberToObject(obj,"Key11",-11);	//ظļ: һ, ҵһ
+    CHECK(cJSON_GetObjectItem(obj,"Key11")->valueint==11);
+    cJSON_DeleteItemFromObject(obj,"Key11");
+    CHECK(cJSON_GetObjectItem(obj,"Key11")->valueint==-11);
+    CHECK(cJSON_GetArraySize(obj)==199);
+
+    /* ֹ˼֮, cJSON_ResetIndexʱ */
+    item=cJSON_GetObjectItem(obj,"Key50");
+    free(item->string);
+    item->string=(char*)malloc(8);
+    item->type&=~cJSON_StringIsPooled;
+    strcpy(item->string,"renamed");
+    cJSON_ResetIndex(obj);
+    CHECK(cJSON_GetObjectItem(obj,"Key50")==0);
+    CHECK(cJSON_GetObjectItem(obj,"RENAMED")==item);
+    cJSON_Delete(obj);
+
+    /* cJSON_OptIndexObjectsڽʱͽ */
+    cJSON_InitContext(&ctx);
+    ctx.options=cJSON_OptIndexObjects;
+    p+=sprintf(p,"{");
+    for (i=0; i<100; i++) p+=sprintf(p,"%s\"k%d\":%d",i?",":"",i,i);
+    sprintf(p,"}");
+    obj=cJSON_ParseCtx(&ctx,text,0);
+    for (ok=obj!=0,i=0; ok && i<100; i++) {
+        sprintf(key,"K%d",i);
+        ok=(item=cJSON_GetObjectItem(obj,key)) && item->valueint==i;
+    }
+    CHECK(ok);
+    cJSON_DeleteCtx(&ctx,obj);
+}
+
+/* user-004: O(1)׷. ͷڵprevʼָβڵ,  */
+static int list_ok(cJSON *array,int n)
+{
+    cJSON *c,*last=0;
+    int i=0;
+    for (c=array->child; c; c=c->next,i++) {
+        if (c->prev!=(last?last:array->child->prev)) return 0;
+        last=c;
+    }
+    return i==n && (!n || array->child->prev==last);
+}
+
+static void test_array_append(void)
+{
+    cJSON *array=cJSON_CreateArray(),*item;
+    int i;
+
+    for (i=0; i<1000; i++) cJSON_AddItemToArray(array,cJSON_CreateNumber(i));
+    CHECK(list_ok(array,1000));
+    CHECK(array->child->prev->valueint==999);
+    item=cJSON_DetachItemFromArray(array,999);	//ȥβڵ֮׷
+    CHECK(item && item->valueint==999 && array->child->prev->valueint==998);
+    cJSON_Delete(item);
+    cJSON_AddItemToArray(array,cJSON_CreateString("tail"));
+    CHECK(list_ok(array,1000) && prints_as(array->child->prev,"\"tail\""));
+    cJSON_InsertItemInArray(array,0,cJSON_CreateString("head"));	//ͷ, βָ벻
+    cJSON_AddItemToArray(array,cJSON_CreateNull());
+    CHECK(list_ok(array,1002) && prints_as(array->child,"\"head\"") && (array->child->prev->type&255)==cJSON_NULL);
+    cJSON_DeleteItemFromArray(array,0);
+    cJSON_DeleteItemFromArray(array,1000);
+    CHECK(list_ok(array,1000) && array->child->valueint==0);
+    cJSON_Delete(array);
+
+    array=cJSON_CreateArray();		//һԪʱprevָԼ
+    cJSON_AddItemToArray(array,item=cJSON_CreateTrue());
+    CHECK(item->prev==item && list_ok(array,1));
+    cJSON_DeleteItemFromArray(array,0);
+    CHECK(array->child==0);
+    cJSON_AddItemToArray(array,cJSON_CreateFalse());
+    cJSON_AddItemReferenceToArray(array,array->child);
+    CHECK(list_ok(array,2) && prints_as(array,"[false,false]"));
+    cJSON_Delete(array);
+}
+
+/* cJSON_GetArrayItemַʽȽarrayԪexpect */
+static int array_is(cJSON *array,const int *expect,int n)
+{
+    cJSON *c=array->child;
+    int i;
+    if (cJSON_GetArraySize(array)!=n || cJSON_GetArrayItem(array,n)) return 0;
+    for (i=0; i<n; i++,c=c->next)
+        if (!c || c->valueint!=expect[i] || cJSON_GetArrayItem(array,i)!=c) return 0;
+    return c==0;
+}
+
+/* user-005: Ԫظӽڵ, ÿ޸֮һ */
+static void test_array_index(void)
+{
+    int values[310],i,n=300;
+    cJSON *array=cJSON_CreateArray(),*item;
+
+    for (i=0; i<n; i++) cJSON_AddItemToArray(array,cJSON_CreateNumber(values[i]=i));
+    CHECK(array_is(array,values,n));
+    cJSON_AddItemToArray(array,cJSON_CreateNumber(values[n++]=1000));	//ĩβ׷, Ч
+    CHECK(array_is(array,values,n));
+
+    cJSON_InsertItemInArray(array,100,cJSON_CreateNumber(-1));
+    memmove(values+101,values+100,(n-100)*sizeof(int)),values[100]=-1,n++;
+    CHECK(array_is(array,values,n));
+
+    cJSON_DeleteItemFromArray(array,0);
+    memmove(values,values+1,--n*sizeof(int));
+    CHECK(array_is(array,values,n));
+
+    cJSON_ReplaceItemInArray(array,50,cJSON_CreateNumber(values[50]=-50));
+    CHECK(array_is(array,values,n));
+
+    item=cJSON_DetachItemViaPointer(array,cJSON_GetArrayItem(array,200));
+    CHECK(item && item->valueint==values[200]);
+    cJSON_Delete(item);
+    memmove(values+200,values+201,(--n-200)*sizeof(int));
+    CHECK(array_is(array,values,n));
+
+    cJSON_ReplaceItemViaPointer(array,cJSON_GetArrayItem(array,n-1),cJSON_CreateNumber(values[n-1]=7));
+    CHECK(array_is(array,values,n));
+
+    item=cJSON_Duplicate(array,1);
+    CHECK(array_is(item,values,n));
+    cJSON_Delete(item);
+    cJSON_Delete(array);
+}
+
+/* ֹ޸child/next(API)֮, ٿ, Ҫ± */
+static void test_array_hand_edits(void)
+{
+    cJSON *a=cJSON_CreateArray(),*o=cJSON_CreateObject(),*c;
+    char key[16];
+    int i;
+
+    for (i=0; i<20; i++) cJSON_AddItemToArray(a,cJSON_CreateNumber(i));
+    CHECK(cJSON_GetArraySize(a)==20);
+    c=a->child;				//ժͷڵ
+    a->child=c->next;
+    a->child->prev=c->prev;
+    c->next=c->prev=0;
+    cJSON_Delete(c);
+    CHECK(cJSON_GetArraySize(a)==19 && cJSON_GetArrayItem(a,18) && cJSON_GetArrayItem(a,18)->valueint==19);
+    CHECK(cJSON_GetArrayItem(a,0)==a->child);
+    c=a->child;				//֮ժһ
+    a->child=c->next;
+    a->child->prev=c->prev;
+    c->next=c->prev=0;
+    cJSON_Delete(c);
+    CHECK(cJSON_GetArrayItem(a,0)==a->child && a->child->valueint==2 && cJSON_GetArraySize(a)==18);
+    c=cJSON_CreateNumber(20);			//ʽβ½ڵ, ͷڵprev
+    a->child->prev->next=c;
+    c->prev=a->child->prev;
+    CHECK(cJSON_GetArraySize(a)==19 && cJSON_GetArrayItem(a,18)==c);
+    cJSON_AddItemToArray(a,cJSON_CreateNumber(21));	//֮־API޸
+    CHECK(cJSON_GetArraySize(a)==20 && cJSON_GetArrayItem(a,19)->valueint==21 && a->child->prev->valueint==21);
+
+    for (i=0; i<40; i++) sprintf(key,"k%d",i),cJSON_AddNumberToObject(o,key,i);
+    CHECK(cJSON_GetObjectItem(o,"k39") && cJSON_GetObjectItem(o,"k0"));	//
+    c=o->child;
+    o->child=c->next;
+    o->child->prev=c->prev;
+    c->next=c->prev=0;
+    cJSON_Delete(c);
+    CHECK(cJSON_GetObjectItem(o,"k0")==0 && cJSON_GetObjectItem(o,"k1")==o->child && cJSON_GetArraySize(o)==39);
+    cJSON_Delete(a);
+    cJSON_Delete(o);
+}
+
+/* õα(ͬ), ڸƽ̨ͬ */
+static unsigned test_seed=12345;
+static unsigned test_rand(void)
+{
+    test_seed=test_seed*1103515245u+12345u;
+    return (test_seed>>8)&0xFFFFFF;
+}
+
+/* textΪJSONdoubleǷstrtodĽȫͬ */
+static int number_matches_strtod(const char *text)
+{
+    cJSON *json=cJSON_Parse(text);
+    double d=strtod(text,0);
+    int ok=json && (json->type&255)==cJSON_Number && !memcmp(&json->valuedouble,&d,sizeof(double));
+    if (!ok) printf("  %s: got %.17g, strtod %.17g\n",text,json?json->valuedouble:0.0,d);
+    cJSON_Delete(json);
+    return ok;
+}
+
+/* user-006: ֽȷ(strtodһ), ıvalueint64оȷ */
+static void test_number_parse(void)
+{
+    static const char *cases[]={"0","-0","1","-1","0.1","0.3","1.5e+3","1E5","123.456e-7","2.2250738585072011e-308",
+        "2.2250738585072014e-308","4.9406564584124654e-324","5e-324","2e-324","1.7976931348623157e308",
+        "1.7976931348623158e308","9007199254740993","9007199254740992.5","0.000001","1e400","-1e400","1e-400",
+        "7.038531e-26","3.0540412e5","123456789012345678901234567890","0.1e-30","1.00000000000000011102230246251565404236316680908203125",
+        "2.00000000000000011102230246251565404236316680908203125","12345678901234567890123e-20"};
+    static const struct {const char *text;long long value;} ints[]={
+        {"9007199254740993",9007199254740993LL},{"-9007199254740993",-9007199254740993LL},
+        {"9223372036854775807",9223372036854775807LL},{"-9223372036854775808",-9223372036854775807LL-1},
+        {"99999999999999999999",9223372036854775807LL},{"-1e30",-9223372036854775807LL-1},{"12.75",12},{"2147483648",2147483648LL}};
+    char text[64];
+    cJSON *json;
+    unsigned i,ok;
+    int digits,k;
+
+    for (ok=1,i=0; i<sizeof(cases)/sizeof(*cases); i++) ok&=number_matches_strtod(cases[i]);
+    CHECK(ok);
+    for (ok=1,i=0; ok && i<100000; i++) {	//Чָֺ
+        char *p=text;
+        if (test_rand()&1) *p++='-';
+        for (digits=1+test_rand()%19,k=0; k<digits; k++) *p++=(char)((k?'0':'1')+test_rand()%(k?10:9));	//ûǰ0
+        if (test_rand()&1) *p++='.',*p++=(char)('0'+test_rand()%10),*p++=(char)('0'+test_rand()%10);
+        if (test_rand()&1) sprintf(p,"e%d",(int)(test_rand()%660)-340);
+        else *p=0;
+        ok=number_matches_strtod(text);
+    }
+    CHECK(ok);
+    for (ok=1,i=0; ok && i<sizeof(ints)/sizeof(*ints); i++) {
+        json=cJSON_Parse(ints[i].text);
+        ok=json && json->valueint64==ints[i].value;
+        if (!ok) printf("  %s: got %lld\n",ints[i].text,json?json->valueint64:0);
+        cJSON_Delete(json);
+    }
+    CHECK(ok);
+    CHECK(cJSON_Parse("+1")==0 && cJSON_Parse(".5")==0);
+}
+
+/* user-007: . ıͬһdouble, Ҳ17λЧ */
+static int significant_digits(const char *s)
+{
+    int n=0,lead=1,zeros=0;
+    for (; *s && *s!='e' && *s!='E'; s++) {
+        if (*s<'0' || *s>'9') continue;
+        if (*s=='0' && lead) continue;
+        lead=0;
+        if (*s=='0') zeros++;
+        else n+=zeros+1,zeros=0;
+    }
+    return n;
+}
+
+static void test_number_print(void)
+{
+    static const struct {double value;const char *text;} cases[]={
+        {0.1,"0.1"},{0.3,"0.3"},{-0.0,"0"},{100,"100"},{2.5,"2.5"},{1e21,"1e+21"},{1e-7,"1e-7"},{-1e-300,"-1e-300"},
+        {5e-324,"5e-324"},{1.7976931348623157e308,"1.7976931348623157e+308"},{123456789012345680000.0,"123456789012345680000"},
+        {0.000001,"0.000001"},{-2147483648.0,"-2147483648"},{1.0/0.0,"null"}};
+    static const long long ints[]={0,-1,2147483647,2147483648LL,-2147483649LL,9007199254740993LL,-9007199254740993LL,
+        1000000000000000000LL,9223372036854775807LL-1,-9223372036854775807LL};	//˵LLONG_MIN/LLONG_MAX
+    char expect[32],*out;
+    cJSON *item;
+    unsigned i,ok;
+    unsigned long long bits;
+    double d,back;
+
+    for (ok=1,i=0; i<sizeof(cases)/sizeof(*cases); i++) {
+        item=cJSON_CreateNumber(cases[i].value);
+        ok&=prints_as(item,cases[i].text);
+        cJSON_Delete(item);
+    }
+    CHECK(ok);
+    for (ok=1,i=0; i<sizeof(ints)/sizeof(*ints); i++) {
+        sprintf(expect,"%lld",ints[i]);
+        item=cJSON_CreateInt64(ints[i]);
+        ok&=prints_as(item,expect);
+        cJSON_Delete(item);
+    }
+    CHECK(ok);
+    for (ok=1,i=0; ok && i<100000; i++) {	//λģʽdouble
+        bits=((unsigned long long)test_rand()<<40)^((unsigned long long)test_rand()<<20)^test_rand();
+        memcpy(&d,&bits,sizeof(d));
+        if (d!=d || d-d!=0) continue;
+        item=cJSON_CreateNumber(d);
+        out=cJSON_PrintUnformatted(item);
+        back=strtod(out,0);
+        ok=!memcmp(&back,&d,sizeof(d)) || (d==0 && back==0);
+        ok=ok && (significant_digits(out)<=17 || (d==floor(d) && fabs(d)<9223372036854775808.0));	//ֵȷ
+        if (!ok) printf("  %.17g printed as %s\n",d,out);
+        free(out);
+        cJSON_Delete(item);
+    }
+    CHECK(ok);
+    CHECK(parses_as("[1.5e+3,1E5,-0.25,12345678901234567890]","[1500,100000,-0.25,12345678901234567000]"));
+}
+
+/* user-008: ɨַ. ַڿλáַڻĩβʱ, Ҫȷ */
+static void test_string_scan(void)
+{
+    static const struct {const char *json,*decoded,*printed;} special[]={
+        {"\\\"","\"","\\\""},{"\\\\","\\","\\\\"},{"\\n","\n","\\n"},{"\\/","/","/"},{"\\u00e9","\xc3\xa9","\xc3\xa9"},
+        {"\\u0001","\x01","\\u0001"},{"\xe4\xbd\xa0","\xe4\xbd\xa0","\xe4\xbd\xa0"},{"\\ud83d\\ude00","\xf0\x9f\x98\x80","\xf0\x9f\x98\x80"},
+        {"","",""}};
+    char src[200],dec[200],prt[200],*buf,*out;
+    cJSON *json;
+    int n,pos,k,ok=1,len;
+
+    for (n=0; ok && n<70; n++) for (pos=0; ok && pos<=n; pos++) for (k=0; ok && k<(int)(sizeof(special)/sizeof(*special)); k++) {
+        char *s=src,*d=dec,*p=prt;
+        int i;
+        if (!*special[k].json && pos) break;	//ûַֻһ
+        *s++='\"',*p++='\"';
+        for (i=0; i<n; i++) {
+            if (i==pos && *special[k].json) {
+                s+=sprintf(s,"%s",special[k].json),d+=sprintf(d,"%s",special[k].decoded),p+=sprintf(p,"%s",special[k].printed);
+                continue;
+            }
+            *s++=*d++=*p++=(char)('a'+i%26);
+        }
+        *s++='\"',*p++='\"',*d=*p=0;
+        len=(int)(s-src);
+        buf=(char*)malloc(len);		//ǡlenֽ, û'\0'
+        memcpy(buf,src,len);
+        json=cJSON_ParseWithLength(buf,len);
+        if (!json || !json->valuestring || strcmp(json->valuestring,dec)) ok=0;
+        else {
+            out=cJSON_PrintUnformatted(json);
+            if (!out || strcmp(out,prt)) ok=0;
+            free(out);
+        }
+        if (!ok) printf("  n=%d pos=%d special=%d\n",n,pos,k);
+        cJSON_Delete(json);
+        free(buf);
+    }
+    CHECK(ok);
+    CHECK(parses_as("[\"a\\tb\",\"\xc3\xa9\\u20ac\",\"\\b\\f\\r\"]","[\"a\\tb\",\"\xc3\xa9\xe2\x82\xac\",\"\\b\\f\\r\"]"));
+}
+
+/* user-009: հcJSON_Minify. հ׵ĳȿԽ߽ʱ, ַע͵Ĵԭͬ */
+static void test_minify(void)
+{
+    static const struct {const char *in,*out;} cases[]={
+        {" { \"a b\" :\t[ 1 ,\r\n 2 ] } ","{\"a b\":[1,2]}"},
+        {"[\"  spaces  \", \"tab\\t\", \"quote \\\" inside\"]","[\"  spaces  \",\"tab\\t\",\"quote \\\" inside\"]"},
+        {"/* comment */ [1, // to end of line\n 2]","[1,2]"},
+        {"[\"// not a comment\", \"/* nor this */\"]","[\"// not a comment\",\"/* nor this */\"]"},
+        {"\"escaped backslash \\\\\" , 1","\"escaped backslash \\\\\",1"},
+        {"   ",""}};
+    char text[600],*p,*buf;
+    cJSON *json;
+    int i,k,ok;
+    size_t len;
+
+    for (ok=1,i=0; i<(int)(sizeof(cases)/sizeof(*cases)); i++) {
+        strcpy(text,cases[i].in);
+        cJSON_Minify(text);
+        if (strcmp(text,cases[i].out)) ok=0,printf("  minified to: %s\n",text);
+    }
+    CHECK(ok);
+    for (ok=1,k=0; ok && k<100; k++) {	//kհַڸλ
+        p=text;
+        p+=sprintf(p,"%*s{%*s\"key\"%*s:%*s[%*s1,\n",k,"",k%7,"",k%5,"",k,"",k%3,"");
+        for (i=0; i<k; i++) *p++=" \t\r\n"[i%4];
+        sprintf(p,"\"v\"%*s]%*s}%*s",k%11,"",k,"",k%13,"");
+        len=strlen(text);
+        buf=(char*)malloc(len);
+        memcpy(buf,text,len);
+        json=cJSON_ParseWithLength(buf,len);
+        ok=prints_as(json,"{\"key\":[1,\"v\"]}");
+        cJSON_Delete(json);
+        free(buf);
+        cJSON_Minify(text);
+        ok=ok && !strcmp(text,"{\"key\":[1,\"v\"]}");
+    }
+    CHECK(ok);
+}
+
+/* user-010: һ. ʽԭȫͬ, PrintBufferedĳʼСֻӰչĴ */
+static void test_print_buffer(void)
+{
+    static const char expect[]="{\n\t\"a\":\t[],\n\t\"b\":\t{\n},\n\t\"c\":\t[1, [2, {\n\t\t\t\t\"d\":\tnull\n\t\t\t}]],\n"
+                               "\t\"e\":\t{\n\t\t\"f\":\t\"g\"\n\t}\n}";
+    cJSON *json=cJSON_Parse("{\"a\":[],\"b\":{},\"c\":[1,[2,{\"d\":null}]],\"e\":{\"f\":\"g\"}}"),*big;
+    char *out,*ref,*buffered,*s,key[16];
+    int i,fmt,ok;
+
+    out=cJSON_Print(json);
+    CHECK(out && !strcmp(out,expect));
+    free(out);
+    CHECK(prints_as(json,"{\"a\":[],\"b\":{},\"c\":[1,[2,{\"d\":null}]],\"e\":{\"f\":\"g\"}}"));
+    cJSON_Delete(json);
+
+    big=cJSON_CreateObject();		//ַͶǶ, ʱչ
+    s=(char*)malloc(5001);
+    for (i=0; i<5000; i++) s[i]=(char)("ab\"\\\n"[i%5]);
+    s[5000]=0;
+    for (i=0; i<50; i++) {
+        sprintf(key,"k%d",i);
+        cJSON_AddItemToObject(big,key,i%2?cJSON_CreateString(s+i*97):cJSON_Parse("[1.5,{\"x\":[true,false]},\"\xe4\xbd\xa0\"]"));
+    }
+    for (ok=1,fmt=0; fmt<2; fmt++) {
+        ref=fmt?cJSON_Print(big):cJSON_PrintUnformatted(big);
+        for (i=1; i<=1<<20; i*=64) {
+            buffered=cJSON_PrintBuffered(big,i,fmt);
+            if (!ref || !buffered || strcmp(ref,buffered)) ok=0;
+            free(buffered);
+        }
+        json=cJSON_Parse(ref);		//, ͬ
+        out=fmt?cJSON_Print(json):cJSON_PrintUnformatted(json);
+        if (!out || strcmp(out,ref)) ok=0;
+        free(out);
+        cJSON_Delete(json);
+        free(ref);
+    }
+    CHECK(ok);
+    free(s);
+    cJSON_Delete(big);
+}
+
+/* ռд. fail_after>0ʱfail_afterεʧ */
+typedef struct {
+    char *data;
+    int len,calls,max_chunk,fail_after;
+} sink;
+static int sink_write(void *user,const char *data,int len)
+{
+    sink *s=(sink*)user;
+    if (++s->calls==s->fail_after) return 0;
+    s->data=(char*)realloc(s->data,s->len+len+1);
+    memcpy(s->data+s->len,data,len);
+    s->len+=len;
+    s->data[s->len]=0;
+    if (len>s->max_chunk) s->max_chunk=len;
+    return 1;
+}
+
+/* user-011: ʽ. ֿдcJSON_Printͬ, ÿ鲻chunk_size */
+static void test_print_writer(void)
+{
+    static const int chunks[]={1,7,64,4096,0};
+    cJSON *json=cJSON_Parse("{\"name\":\"Jack (\\\"Bee\\\") Nimble\",\"list\":[1,2.5,-3e-9,true,null,{\"deep\":[[],{}]}],\"s\":\"\xe4\xbd\xa0\\n\"}");
+    sink s;
+    char *ref,text[512];
+    FILE *f;
+    int i,fmt,ok;
+    size_t n;
+
+    for (ok=1,fmt=0; fmt<2; fmt++) {
+        ref=fmt?cJSON_Print(json):cJSON_PrintUnformatted(json);
+        for (i=0; i<(int)(sizeof(chunks)/sizeof(*chunks)); i++) {
+            memset(&s,0,sizeof(s));
+            if (!cJSON_PrintToWriter(json,fmt,sink_write,&s,chunks[i]) || !s.data || strcmp(s.data,ref)) ok=0;
+            if (chunks[i]>=64 && s.max_chunk>chunks[i]) ok=0;	//ȿСַһ鳬chunk_size
+            free(s.data);
+        }
+        free(ref);
+    }
+    CHECK(ok);
+
+    memset(&s,0,sizeof(s));		//дʧʱֹͣ0
+    s.fail_after=3;
+    CHECK(cJSON_PrintToWriter(json,1,sink_write,&s,1)==0 && s.calls==3);
+    free(s.data);
+
+    f=tmpfile();
+    CHECK(f && cJSON_PrintToFile(json,0,f));
+    if (f) {
+        rewind(f);
+        n=fread(text,1,sizeof(text)-1,f);
+        text[n]=0;
+        fclose(f);
+        CHECK(prints_as(json,text));
+    }
+    cJSON_Delete(json);
+}
+
+/* textֳlen1ʣµ(piece>0ʱΪÿpieceֽ)ιͽ, ؽ */
+static cJSON *push_parse(const char *text,size_t len1,size_t piece,size_t *error_offset)
+{
+    cJSON_Parser *ps=cJSON_ParserCreate(0);
+    size_t len=strlen(text),i,n;
+    cJSON *json;
+    int ok=1;
+    if (piece) for (i=0; ok && i<len; i+=n) n=len-i<piece?len-i:piece,ok=cJSON_ParserFeed(ps,text+i,n);
+    else ok=cJSON_ParserFeed(ps,text,len1) && cJSON_ParserFeed(ps,text+len1,len-len1);
+    json=ok?cJSON_ParserFinish(ps):0;
+    if (error_offset) *error_offset=cJSON_ParserErrorOffset(ps);
+    cJSON_ParserDelete(ps);
+    return json;
+}
+
+/* user-012: ͽ. ֶ, cJSON_Parseͬ */
+static void test_push_parser(void)
+{
+    static const char *docs[]={"{\"name\":\"Jack \\\"Bee\\\" \\u00e9\\ud83d\\ude00\",\"n\":[-12.5e+3,0,1234567890123],\"t\":true,\"f\":false,\"z\":null}",
+        "12345","\"str\"","  [ [ ], { } , \"\\\\\" ]  ","-0.000001"};
+    cJSON *json,*ref;
+    char *a,*b;
+    size_t i,k,len,offset;
+    int ok=1;
+
+    for (k=0; k<sizeof(docs)/sizeof(*docs); k++) {
+        ref=cJSON_Parse(docs[k]);
+        a=cJSON_PrintUnformatted(ref);
+        len=strlen(docs[k]);
+        for (i=0; i<=len+1; i++) {	//i<=len: λiֳ; len+1: ÿһֽ
+            json=i<=len?push_parse(docs[k],i,0,0):push_parse(docs[k],0,1,0);
+            b=json?cJSON_PrintUnformatted(json):0;
+            if (!b || strcmp(a,b)) ok=0,printf("  %s split at %d: %s\n",docs[k],(int)i,b?b:"(failed)");
+            free(b);
+            cJSON_Delete(json);
+        }
+        free(a);
+        cJSON_Delete(ref);
+    }
+    CHECK(ok);
+    CHECK(push_parse("[1,2",2,0,0)==0);		//
+    CHECK(push_parse("{\"a\":1} x",3,0,&offset)==0 && offset==8);	//ֻհ׸ֵ
+    CHECK(push_parse("[1,,2]",3,0,&offset)==0 && offset==3);
+    CHECK(push_parse("\"abc",1,0,0)==0);
+}
+
+/* SAX¼ǳһı, stop_at>0ʱstop_at¼ýֹͣ */
+typedef struct {
+    char log[512];
+    int events,stop_at;
+} sax_log;
+static int sax_add(void *user,const char *fmt,...)
+{
+    sax_log *l=(sax_log*)user;
+    size_t n=strlen(l->log);
+    va_list ap;
+    va_start(ap,fmt);
+    vsnprintf(l->log+n,sizeof(l->log)-n,fmt,ap);
+    va_end(ap);
+    return ++l->events!=l->stop_at;
+}
+static int sax_null(void *user) {return sax_add(user,"N ");}
+static int sax_bool(void *user,int value) {return sax_add(user,value?"T ":"F ");}
+static int sax_number(void *user,double value,long long value64) {return sax_add(user,"%g/%lld ",value,value64);}
+static int sax_string(void *user,const char *str,size_t len) {return sax_add(user,"s:%.*s ",(int)len,str);}
+static int sax_key(void *user,const char *str,size_t len) {return sax_add(user,"k:%.*s ",(int)len,str);}
+static int sax_start_object(void *user) {return sax_add(user,"{ ");}
+static int sax_end_object(void *user) {return sax_add(user,"} ");}
+static int sax_start_array(void *user) {return sax_add(user,"[ ");}
+static int sax_end_array(void *user) {return sax_add(user,"] ");}
+static const cJSON_SaxHandler sax_logger={sax_null,sax_bool,sax_number,sax_string,sax_key,
+    sax_start_object,sax_end_object,sax_start_array,sax_end_array};
+
+/* user-013: SAX. ¼˳, صֹ, Ƕ */
+static void test_sax(void)
+{
+    static const char text[]="{\"a\":[1,-2.5,9007199254740993],\"b\\n\":\"x\\u00e9y\",\"c\":{\"d\":null,\"e\":true,\"f\":false},\"g\":[]}";
+    cJSON_Context ctx;
+    cJSON_SaxHandler only_numbers;
+    sax_log l;
+    const char *end;
+
+    memset(&l,0,sizeof(l));
+    CHECK(cJSON_ParseSax(0,text,&sax_logger,&l,&end)==1 && *end==0);
+    CHECK(!strcmp(l.log,"{ k:a [ 1/1 -2.5/-2 9.0072e+15/9007199254740993 ] k:b\n s:x\xc3\xa9y k:c { k:d N k:e T k:f F } k:g [ ] } "));
+
+    memset(&l,0,sizeof(l));		//5¼0: ֹͣʧ
+    l.stop_at=5;
+    CHECK(cJSON_ParseSax(0,text,&sax_logger,&l,0)==0 && l.events==5);
+
+    memset(&l,0,sizeof(l));		//ûõĻصԶӦ¼
+    memset(&only_numbers,0,sizeof(only_numbers));
+    only_numbers.number=sax_number;
+    CHECK(cJSON_ParseSax(0,text,&only_numbers,&l,0)==1 && !strcmp(l.log,"1/1 -2.5/-2 9.0072e+15/9007199254740993 "));
+
+    memset(&l,0,sizeof(l));		//ǡlengthֽ, ַû'\0'βʱҲȷĳ
+    CHECK(cJSON_ParseSaxWithLength(0,"[\"abc\",\"de\"]xyz",12,&sax_logger,&l,0)==1 && !strcmp(l.log,"[ s:abc s:de ] "));
+    CHECK(cJSON_ParseSaxWithLength(0,"\"abc\"",4,&sax_logger,&l,0)==0);
+
+    cJSON_InitContext(&ctx);
+    CHECK(cJSON_ParseSax(&ctx,"[1,{\"a\" 2}]",&sax_logger,&l,0)==0 && ctx.error && !strcmp(ctx.error,"2}]"));
+    ctx.max_depth=3;
+    CHECK(cJSON_ParseSax(&ctx,"[[[1]]]",&sax_logger,&l,0)==1);
+    CHECK(cJSON_ParseSax(&ctx,"[[[[1]]]]",&sax_logger,&l,0)==0);
+    ctx.options=cJSON_OptRequireNullTerminated;
+    CHECK(cJSON_ParseSax(&ctx,"1 2",&sax_logger,&l,0)==0);
+}
+
+/* user-014: ԭؽ. ַ뻺, ڵָӵ */
+static void test_insitu(void)
+{
+    char text[]="{\"key\":\"plain\",\"esc\\u0041ped\":\"a\\\\b\\\"c\\u00e9\",\"list\":[\"\",\"x\"],\"n\":12}";
+    cJSON_Context ctx;
+    cJSON *json=cJSON_ParseInSitu(text),*item;
+    const char *end;
+
+    CHECK(json!=0);
+    item=cJSON_GetObjectItem(json,"key");
+    CHECK(item && item->valuestring>=text && item->valuestring<text+sizeof(text) && (item->type&cJSON_ValueIsConst));
+    CHECK(item && (item->type&cJSON_StringIsConst) && item->string>=text && item->string<text+sizeof(text));
+    item=cJSON_GetObjectItem(json,"escAped");
+    CHECK(item && !strcmp(item->valuestring,"a\\b\"c\xc3\xa9") && item->valuestring>=text && item->valuestring<text+sizeof(text));
+    CHECK(prints_as(json,"{\"key\":\"plain\",\"escAped\":\"a\\\\b\\\"c\xc3\xa9\",\"list\":[\"\",\"x\"],\"n\":12}"));
+    cJSON_DeleteItemFromObject(json,"key");				//ɾͷָ򻺳ַ
+    cJSON_AddItemToObject(json,"own",cJSON_CreateString("copy"));	//ӵĽڵճͷ
+    CHECK(prints_as(json,"{\"escAped\":\"a\\\\b\\\"c\xc3\xa9\",\"list\":[\"\",\"x\"],\"n\":12,\"own\":\"copy\"}"));
+    item=cJSON_Duplicate(json,1);		//ӵԼַ
+    cJSON_Delete(json);
+    CHECK(prints_as(item,"{\"escAped\":\"a\\\\b\\\"c\xc3\xa9\",\"list\":[\"\",\"x\"],\"n\":12,\"own\":\"copy\"}"));
+    cJSON_Delete(item);
+
+    cJSON_InitContext(&ctx);
+    strcpy(text,"[\"a\",\"b\"] tail");
+    json=cJSON_ParseInSituCtx(&ctx,text,&end);
+    CHECK(json && !strcmp(end," tail") && prints_as(json,"[\"a\",\"b\"]"));
+    cJSON_DeleteCtx(&ctx,json);
+    strcpy(text,"[\"a\",]");
+    CHECK(cJSON_ParseInSituCtx(&ctx,text,0)==0 && ctx.error && *ctx.error==']');
+}
+
+/* lengthֽڵĶ, û'\0', Խȡᱻڴ鹤߷ */
+static cJSON *parse_exact(const char *text,size_t length)
+{
+    char *buf=(char*)malloc(length?length:1);
+    cJSON *json;
+    memcpy(buf,text,length);
+    json=cJSON_ParseWithLength(buf,length);
+    free(buf);
+    return json;
+}
+
+/* user-015: Ƚ. ȡvalue+lengthֽ֮, ضϵǴ */
+static void test_parse_length(void)
+{
+    static const char padded[]="[1] \n";
+    static const char *truncated[]={"\"ab","{\"ab","{\"a\":\"b","[\"a\\","tru","[1,2","{\"a\":1,","\"\\u00"};
+    cJSON_SaxHandler none;
+    cJSON *json;
+    const char *end;
+    size_t i;
+    int ok;
+
+    json=parse_exact("[1,2]xyz",5);
+    CHECK(prints_as(json,"[1,2]"));
+    cJSON_Delete(json);
+    json=parse_exact("123",2);		//length
+    CHECK(json && json->valueint==12);
+    cJSON_Delete(json);
+    json=parse_exact("\"ab\"",4);
+    CHECK(prints_as(json,"\"ab\""));
+    cJSON_Delete(json);
+
+    memset(&none,0,sizeof(none));
+    for (ok=1,i=0; i<sizeof(truncated)/sizeof(*truncated); i++) {	//SAXͽܾضϵı
+        json=parse_exact(truncated[i],strlen(truncated[i]));
+        if (json || cJSON_ParseSaxWithLength(0,truncated[i],strlen(truncated[i]),&none,0,0)
+            || (json=push_parse(truncated[i],1,0,0))) ok=0,printf("  accepted: %s\n",truncated[i]);
+        cJSON_Delete(json);
+    }
+    CHECK(ok);
+    json=cJSON_Parse("\"ab");
+    CHECK(json==0);
+    cJSON_Delete(json);
+
+    json=cJSON_ParseWithLengthOpts(padded,5,&end,1);
+    CHECK(json && end==padded+5);
+    cJSON_Delete(json);
+    json=cJSON_ParseWithLengthOpts("[1]\0",4,&end,1);	//ѡ'\0'
+    CHECK(json!=0);
+    cJSON_Delete(json);
+    CHECK(cJSON_ParseWithLengthOpts("[1] x",5,0,1)==0);
+    CHECK(cJSON_ParseWithLength("",0)==0 && cJSON_ParseWithLength(0,5)==0);
+}
+
+/* user-016: ӳļJSON Lines. в¼, ֻӰԼ */
+static void test_lines(void)
+{
+    static const char data[]="{\"id\":1}\n\n  \n[2,3]\r\n{\"bad\":}\n\"four\" x\n5";
+    static const char *path="test_lines.ndjson";
+    cJSON_Record recs[8],rec;
+    cJSON_Lines *in;
+    cJSON_File *file;
+    cJSON *json;
+    sax_log l;
+    FILE *f;
+    int n,total;
+
+    in=cJSON_LinesCreate(0,data,sizeof(data)-1);
+    n=cJSON_LinesNext(in,recs,8);
+    CHECK(n==5);
+    CHECK(prints_as(recs[0].json,"{\"id\":1}") && recs[0].line==1 && recs[0].offset==0 && recs[0].error==0);
+    CHECK(prints_as(recs[1].json,"[2,3]") && recs[1].line==4 && recs[1].length==5 && recs[1].offset==13);
+    CHECK(recs[2].json==0 && recs[2].line==5 && recs[2].error==recs[2].text+7);
+    CHECK(recs[3].json==0 && recs[3].line==6 && recs[3].error && *recs[3].error=='x');	//ֵ治б
+    CHECK(recs[4].json && recs[4].json->valueint==5 && recs[4].line==7);
+    CHECK(cJSON_LinesNext(in,recs,8)==0);
+    cJSON_LinesDelete(in);
+
+    in=cJSON_LinesCreate(0,data,sizeof(data)-1);	//ÿ2, һarenaͷ
+    for (total=0; (n=cJSON_LinesNext(in,recs,2))>0; total+=n) CHECK(n<=2);
+    CHECK(total==5);
+    cJSON_LinesDelete(in);
+
+    in=cJSON_LinesCreate(0,data,sizeof(data)-1);
+    CHECK(cJSON_LinesSplit(in,recs,8)==5 && recs[1].json==0 && recs[1].length==5 && recs[4].line==7);
+    cJSON_LinesDelete(in);
+
+    in=cJSON_LinesCreate(0,data,sizeof(data)-1);
+    memset(&l,0,sizeof(l));
+    CHECK(cJSON_LinesNextSax(in,&sax_logger,&l,&rec)==1 && rec.line==1 && !strcmp(l.log,"{ k:id 1/1 } "));
+    CHECK(cJSON_LinesNextSax(in,&sax_logger,&l,&rec)==1 && rec.line==4 && rec.error==0);
+    CHECK(cJSON_LinesNextSax(in,&sax_logger,&l,&rec)==1 && rec.error!=0);
+    cJSON_LinesDelete(in);
+
+    f=fopen(path,"wb");
+    CHECK(f!=0);
+    if (!f) return;
+    fwrite(data,1,sizeof(data)-1,f);
+    fclose(f);
+    file=cJSON_FileOpen(path);
+    CHECK(file && file->size==sizeof(data)-1 && !memcmp(file->data,data,file->size));
+    if (file) {
+        in=cJSON_LinesCreate(0,file->data,file->size);
+        CHECK(cJSON_LinesNext(in,recs,8)==5 && recs[4].json && recs[4].json->valueint==5);
+        cJSON_LinesDelete(in);
+        cJSON_FileClose(file);
+    }
+    json=cJSON_ParseFile(0,path);		//ͬcJSON_Parse: һֵ֮ݲ
+    CHECK(prints_as(json,"{\"id\":1}"));
+    cJSON_Delete(json);
+    f=fopen(path,"wb");
+    fputs(" {\"whole\":[1,2]} ",f);
+    fclose(f);
+    json=cJSON_ParseFile(0,path);
+    CHECK(prints_as(json,"{\"whole\":[1,2]}"));
+    cJSON_Delete(json);
+    remove(path);
+    CHECK(cJSON_FileOpen("no/such/file.json")==0);
+}
+
+/* nСĵ, ÿ7һ﷨. textsɵͷ */
+static void make_docs(cJSON_Record *docs,char **texts,int n)
+{
+    int i;
+    for (i=0; i<n; i++) {
+        texts[i]=(char*)malloc(96);
+        if (i%7==3) sprintf(texts[i],"{\"id\":%d,\"bad\":[1,}",i);
+        else sprintf(texts[i],"{\"id\":%d,\"name\":\"doc %d\",\"v\":[%d.5,%s]}",i,i,i,i%2?"true":"null");
+        memset(&docs[i],0,sizeof(cJSON_Record));
+        docs[i].text=texts[i];
+        docs[i].length=strlen(texts[i]);
+    }
+}
+
+/* docsĽǷ˳ͬ(λҲͬ) */
+static int batch_matches(cJSON_Record *docs,int n)
+{
+    cJSON *json;
+    const char *end;
+    char *a,*b;
+    int i,ok=1;
+    for (i=0; ok && i<n; i++) {
+        json=cJSON_ParseWithLengthOpts(docs[i].text,docs[i].length,&end,1);
+        if (!json) ok=docs[i].json==0 && docs[i].error==cJSON_GetErrorPtr();
+        else {
+            a=cJSON_PrintUnformatted(json),b=docs[i].json?cJSON_PrintUnformatted(docs[i].json):0;
+            ok=b && !strcmp(a,b) && docs[i].error==0;
+            free(a),free(b);
+        }
+        cJSON_Delete(json);
+    }
+    return ok;
+}
+
+/* user-017: ߳̽һĵ, ˳ͬ */
+static void test_batch(void)
+{
+    cJSON_Record docs[500];
+    char *texts[500];
+    cJSON_Batch *batch;
+    int i,threads,expect=500-(500+3)/7;
+
+    make_docs(docs,texts,500);
+    for (threads=1; threads<=4; threads+=3) {
+        batch=cJSON_BatchCreate(0,threads);
+        CHECK(batch!=0);
+        CHECK(cJSON_ParseBatch(batch,docs,500)==expect && batch_matches(docs,500));
+        CHECK(cJSON_ParseBatch(batch,docs+100,3)==3-1 && batch_matches(docs+100,3));	//ǰһεͷ
+        CHECK(cJSON_ParseBatch(batch,docs,0)==0);
+        cJSON_BatchDelete(batch);
+    }
+    for (i=0; i<500; i++) free(texts[i]);
+}
+
+/* к˳text, Ƚͳλ */
+static int parallel_matches(cJSON_Batch *batch,cJSON_Context *ctx,const char *text,size_t len)
+{
+    const char *error;
+    cJSON *par=cJSON_ParseParallel(batch,text,len,&error),*seq=cJSON_ParseWithLengthCtx(ctx,text,len,0);
+    char *a=par?cJSON_PrintUnformatted(par):0,*b=seq?cJSON_PrintUnformatted(seq):0;
+    int ok=(!par && !seq && error==ctx->error) || (a && b && !strcmp(a,b) && cJSON_GetPackedType(par)==cJSON_GetPackedType(seq));
+    free(a),free(b);
+    cJSON_DeleteCtx(ctx,par);
+    cJSON_DeleteCtx(ctx,seq);
+    return ok;
+}
+
+/* user-018: нһ. (ͳλ)cJSON_ParseWithLengthCtxȫͬ */
+static void test_parallel(void)
+{
+    cJSON_Context ctx;
+    cJSON_Batch *batch;
+    cJSON *json;
+    char *text,*p;
+    size_t len;
+    int i,n=60000;
+
+    text=(char*)malloc((size_t)n*40+16);
+    p=text+sprintf(text,"[");
+    for (i=0; i<n; i++) p+=sprintf(p,"%s{\"id\":%d,\"s\":\"a,b]\\\"\",\"v\":[%d]}",i?",":"",i,i);
+    p+=sprintf(p,"]");
+    len=(size_t)(p-text);
+    cJSON_InitContext(&ctx);
+    batch=cJSON_BatchCreate(&ctx,4);
+    CHECK(len>=(1<<20) && parallel_matches(batch,&ctx,text,len));
+    text[len/2]='}';			//мһԪػ: λ˳ͬ
+    CHECK(parallel_matches(batch,&ctx,text,len));
+    CHECK(parallel_matches(batch,&ctx,text,len-1));	//ûн']'
+    cJSON_BatchDelete(batch);
+
+    ctx.options=cJSON_OptPackNumbers;	//ֵֻĴ˳һΪ
+    batch=cJSON_BatchCreate(&ctx,4);
+    n=300000;
+    text=(char*)realloc(text,(size_t)n*8+16);
+    p=text+sprintf(text,"[");
+    for (i=0; i<n; i++) p+=sprintf(p,"%s%d",i?",":"",i*7);
+    p+=sprintf(p,"]");
+    len=(size_t)(p-text);
+    json=cJSON_ParseParallel(batch,text,len,0);
+    CHECK(cJSON_GetPackedType(json)==cJSON_PackedInt64 && cJSON_GetArraySize(json)==n);
+    cJSON_DeleteCtx(&ctx,json);
+    CHECK(parallel_matches(batch,&ctx,text,len));
+    cJSON_BatchDelete(batch);
+    free(text);
+}
+
+/* user-019: ĵ. ʺĽͨһ, ȷ */
+static void test_compact(void)
+{
+    static const char text[]="{\"short\":\"abc\",\"Long\":\"a string longer than seven bytes\",\"list\":[1,-2.5,true,false,null,[],{}],"
+                             "\"big\":9007199254740993,\"neg\":-9007199254740993,\"zero\":-0,\"o\":{\"k\":\"v\"}}";
+    cJSON_Context ctx;
+    cJSON_Compact *doc=cJSON_CompactParse(0,text,sizeof(text)-1);
+    cJSON_Node list,n;
+    cJSON *tree;
+    size_t len;
+    double sum=0,zero;
+    int count=0;
+
+    CHECK(doc && cJSON_CompactType(doc,0)==cJSON_Object && cJSON_CompactSize(doc,0)==7 && cJSON_CompactMemory(doc)>0);
+    n=cJSON_CompactGetObjectItem(doc,0,"SHORT");		//Сд
+    CHECK(n && !strcmp(cJSON_CompactString(doc,n,&len),"abc") && len==3 && !strcmp(cJSON_CompactKey(doc,n),"short"));
+    n=cJSON_CompactGetObjectItem(doc,0,"long");
+    CHECK(n && !strcmp(cJSON_CompactString(doc,n,&len),"a string longer than seven bytes") && len==32);
+    list=cJSON_CompactGetObjectItem(doc,0,"list");
+    CHECK(list && cJSON_CompactType(doc,list)==cJSON_Array && cJSON_CompactSize(doc,list)==7);
+    for (n=cJSON_CompactChild(doc,list); n; n=cJSON_CompactNext(doc,n)) sum+=cJSON_CompactNumber(doc,n),count++;
+    CHECK(count==7 && sum==-1.5);
+    CHECK(cJSON_CompactType(doc,cJSON_CompactGetArrayItem(doc,list,2))==cJSON_True);
+    CHECK(cJSON_CompactType(doc,cJSON_CompactGetArrayItem(doc,list,4))==cJSON_NULL);
+    CHECK(cJSON_CompactSize(doc,cJSON_CompactGetArrayItem(doc,list,5))==0 && cJSON_CompactGetArrayItem(doc,list,7)==0);
+    CHECK(cJSON_CompactInt64(doc,cJSON_CompactGetObjectItem(doc,0,"big"))==9007199254740993LL);
+    CHECK(cJSON_CompactInt64(doc,cJSON_CompactGetObjectItem(doc,0,"neg"))==-9007199254740993LL);
+    zero=cJSON_CompactNumber(doc,cJSON_CompactGetObjectItem(doc,0,"zero"));
+    CHECK(zero==0 && signbit(zero));	//-0Ϊdouble
+    CHECK(cJSON_CompactString(doc,list,0)==0 && cJSON_CompactNumber(doc,0)==0 && cJSON_CompactType(doc,1000)==-1);
+    CHECK(cJSON_CompactGetObjectItem(doc,0,"missing")==0 && cJSON_CompactGetObjectItem(doc,list,"a")==0);
+
+    tree=cJSON_CompactToTree(doc,0);
+    CHECK(prints_as(tree,"{\"short\":\"abc\",\"Long\":\"a string longer than seven bytes\",\"list\":[1,-2.5,true,false,null,[],{}],"
+                         "\"big\":9007199254740993,\"neg\":-9007199254740993,\"zero\":0,\"o\":{\"k\":\"v\"}}"));
+    cJSON_Delete(tree);
+    tree=cJSON_CompactToTree(doc,cJSON_CompactGetObjectItem(doc,0,"o"));
+    CHECK(prints_as(tree,"{\"k\":\"v\"}"));
+    cJSON_Delete(tree);
+    cJSON_CompactDelete(doc);
+
+    cJSON_InitContext(&ctx);
+    CHECK(cJSON_CompactParse(&ctx,"[1,2",4)==0 && ctx.error!=0);
+    ctx.max_depth=2;
+    CHECK(cJSON_CompactParse(&ctx,"[[[]]]",6)==0);
+}
+
+/* user-020: ֵ. ͨͬ, APIʹǰԶչ */
+static void test_packed(void)
+{
+    static const double dbls[]={1.5,-2,1e300,0.1};
+    static const long long ints[]={1,-2,9007199254740993LL,0};
+    cJSON_Context ctx;
+    cJSON *a=cJSON_CreatePackedDoubleArray(dbls,4),*b=cJSON_CreatePackedInt64Array(ints,4),*c,*el;
+    double *d;
+    long long *v;
+    int n,count;
+
+    CHECK(cJSON_GetPackedType(a)==cJSON_PackedDouble && cJSON_GetPackedType(b)==cJSON_PackedInt64);
+    CHECK(prints_as(a,"[1.5,-2,1e+300,0.1]") && prints_as(b,"[1,-2,9007199254740993,0]"));
+    CHECK(cJSON_GetArraySize(a)==4 && cJSON_GetArraySize(b)==4);
+    d=cJSON_GetNumberArrayData(a,&n);
+    CHECK(d && n==4 && cJSON_GetInt64ArrayData(a,0)==0);
+    d[1]=7;		//͵޸
+    CHECK(prints_as(a,"[1.5,7,1e+300,0.1]"));
+    c=cJSON_Duplicate(b,1);
+    CHECK(cJSON_GetPackedType(c)==cJSON_PackedInt64 && prints_as(c,"[1,-2,9007199254740993,0]"));
+    cJSON_Delete(c);
+
+    count=0;
+    cJSON_ArrayForEach(el,b) count++;	//cJSON_ArrayForEachչ
+    CHECK(count==4 && cJSON_GetPackedType(b)==0 && cJSON_GetArrayItem(b,2)->valueint64==9007199254740993LL);
+    CHECK(cJSON_PackArray(b)==1 && cJSON_GetPackedType(b)==cJSON_PackedInt64);
+    cJSON_AddItemToArray(b,cJSON_CreateString("x"));	//޸ʱչ
+    CHECK(cJSON_GetPackedType(b)==0 && prints_as(b,"[1,-2,9007199254740993,0,\"x\"]"));
+    CHECK(cJSON_PackArray(b)==0);		//ַ
+    cJSON_DeleteItemFromArray(b,4);
+    cJSON_AddItemToArray(b,cJSON_CreateNumber(0.5));
+    CHECK(cJSON_PackArray(b)==0);		//double治2^53+1
+    cJSON_DeleteItemFromArray(b,2);
+    CHECK(cJSON_PackArray(b)==1 && cJSON_GetPackedType(b)==cJSON_PackedDouble && prints_as(b,"[1,-2,0,0.5]"));
+    CHECK(cJSON_UnpackArray(b)==1 && cJSON_GetPackedType(b)==0 && prints_as(b,"[1,-2,0,0.5]"));
+    c=cJSON_CreateArray();
+    CHECK(cJSON_PackArray(c)==0);		//
+    cJSON_Delete(c);
+    cJSON_Delete(a);
+    cJSON_Delete(b);
+
+    cJSON_InitContext(&ctx);
+    ctx.options=cJSON_OptPackNumbers;
+    c=cJSON_ParseCtx(&ctx,"{\"i\":[1,2,-3],\"d\":[1.0,2],\"m\":[1,\"a\"],\"e\":[],\"n\":[[4,5]]}",0);
+    CHECK(cJSON_GetPackedType(cJSON_GetObjectItem(c,"i"))==cJSON_PackedInt64);
+    CHECK(cJSON_GetPackedType(cJSON_GetObjectItem(c,"d"))==cJSON_PackedDouble);
+    CHECK(cJSON_GetPackedType(cJSON_GetObjectItem(c,"m"))==0 && cJSON_GetPackedType(cJSON_GetObjectItem(c,"e"))==0);
+    v=cJSON_GetInt64ArrayData(cJSON_GetArrayItem(cJSON_GetObjectItem(c,"n"),0),&n);
+    CHECK(v && n==2 && v[0]==4 && v[1]==5);
+    CHECK(prints_as(c,"{\"i\":[1,2,-3],\"d\":[1,2],\"m\":[1,\"a\"],\"e\":[],\"n\":[[4,5]]}"));
+    cJSON_DeleteCtx(&ctx,c);
+}
+
+/* valueCBORǷΪhex */
+static int encodes_as(cJSON *value,const char *hex)
+{
+    char got[256];
+    size_t len,i;
+    char *bin=cJSON_PrintBinary(value,&len);
+    int ok;
+    for (i=0; bin && i<len && i<sizeof(got)/2-1; i++) sprintf(got+2*i,"%02x",(unsigned char)bin[i]);
+    got[bin?2*i:0]=0;
+    ok=bin && !strcmp(got,hex);
+    if (!ok) printf("  encoded as %s, expected %s\n",got,hex);
+    free(bin);
+    cJSON_Delete(value);
+    return ok;
+}
+
+/* user-021: CBOR. RFC 8949¼Aеı, , ĸִ */
+static void test_cbor(void)
+{
+    static const char doc[]="{\"name\":\"Jack \xe4\xbd\xa0\",\"n\":[0,-1,23,24,-1000000,4294967296,9007199254740993,1.5,0.1,-1e300],"
+                            "\"t\":true,\"f\":false,\"z\":null,\"e\":{},\"a\":[]}";
+    static const long long ints[]={1,-2,3};
+    static const char indefinite[]="\x9f\x01\xc1\x02\xf7\xff";		//[_ 1, 1(2), undefined]
+    cJSON_Context ctx;
+    cJSON *json=cJSON_Parse(doc),*back;
+    char *bin;
+    sink s;
+    size_t len;
+
+    CHECK(encodes_as(cJSON_CreateNumber(0),"00") && encodes_as(cJSON_CreateNumber(23),"17"));
+    CHECK(encodes_as(cJSON_CreateNumber(24),"1818") && encodes_as(cJSON_CreateNumber(1000),"1903e8"));
+    CHECK(encodes_as(cJSON_CreateNumber(-100),"3863") && encodes_as(cJSON_CreateNumber(1e12),"1b000000e8d4a51000"));
+    CHECK(encodes_as(cJSON_CreateNumber(1.5),"fa3fc00000") && encodes_as(cJSON_CreateNumber(0.1),"fb3fb999999999999a"));
+    CHECK(encodes_as(cJSON_CreateTrue(),"f5") && encodes_as(cJSON_CreateFalse(),"f4") && encodes_as(cJSON_CreateNull(),"f6"));
+    CHECK(encodes_as(cJSON_Parse("[1,[2,3],{\"a\":\"b\"}]"),"8301820203a161616162"));
+
+    bin=cJSON_PrintBinary(json,&len);
+    back=bin?cJSON_ParseBinary(bin,len):0;
+    CHECK(back && prints_as(back,"{\"name\":\"Jack \xe4\xbd\xa0\",\"n\":[0,-1,23,24,-1000000,4294967296,9007199254740993,1.5,0.1,-1e+300],"
+                                 "\"t\":true,\"f\":false,\"z\":null,\"e\":{},\"a\":[]}"));
+    CHECK(back && cJSON_GetArrayItem(cJSON_GetObjectItem(back,"n"),6)->valueint64==9007199254740993LL);
+    cJSON_Delete(back);
+    memset(&s,0,sizeof(s));		//ֿдֽͬ
+    CHECK(cJSON_PrintBinaryToWriter(json,sink_write,&s,3) && s.len==(int)len && !memcmp(s.data,bin,len));
+    free(s.data);
+    CHECK(cJSON_ParseBinary(bin,len-1)==0);	//ض
+    cJSON_InitContext(&ctx);
+    ctx.options=cJSON_OptRequireNullTerminated;
+    back=cJSON_ParseBinaryCtx(&ctx,bin,len,0);
+    CHECK(back!=0);
+    cJSON_DeleteCtx(&ctx,back);
+    free(bin);
+    cJSON_Delete(json);
+
+    json=cJSON_CreatePackedInt64Array(ints,3);	//дͻ, ǽյ
+    bin=cJSON_PrintBinary(json,&len);
+    back=cJSON_ParseBinary(bin,len);
+    CHECK(cJSON_GetPackedType(back)==cJSON_PackedInt64 && prints_as(back,"[1,-2,3]"));
+    cJSON_Delete(back);
+    cJSON_Delete(json);
+    free(bin);
+
+    back=cJSON_ParseBinary(indefinite,sizeof(indefinite)-1);
+    CHECK(prints_as(back,"[1,2,null]"));
+    cJSON_Delete(back);
+    CHECK(cJSON_ParseBinary("\x41\x61",2)==0);			//ֽڴ
+    CHECK(cJSON_ParseBinary("\xa1\x01\x02",3)==0);		//ַ
+    CHECK(cJSON_ParseBinaryCtx(&ctx,"\x01\x02",2,0)==0);	//ֵ滹ֽ
+}
+
+/* user-022: ӳٽ. ʱ㽨ӽڵ, ͨһ, ﷨չʱű */
+static void test_lazy(void)
+{
+    static const char text[]="{\"skip\":{\"deep\":[1,2,{\"x\":\"]}\\\"\"}]},\"list\":[10,\"b\",[true]],\"Obj\":{\"k\":null}}";
+    static const char broken[]="[1,{\"a\":tru},3]";
+    cJSON_Context ctx;
+    cJSON_Arena *arena;
+    cJSON *json=cJSON_ParseLazy(text,sizeof(text)-1),*item,*copy;
+    int blocks;
+
+    CHECK(json && (json->type&255)==cJSON_Object);
+    item=cJSON_GetObjectItem(json,"list");
+    CHECK(item && cJSON_GetArraySize(item)==3 && cJSON_GetArrayItem(item,0)->valueint==10);
+    CHECK(prints_as(cJSON_GetArrayItem(item,2),"[true]"));
+    CHECK(cJSON_GetObjectItem(cJSON_GetObjectItem(json,"obj"),"K")!=0);
+    copy=cJSON_Duplicate(json,1);		//ƺҲչûзʹĲ
+    CHECK(prints_as(json,"{\"skip\":{\"deep\":[1,2,{\"x\":\"]}\\\"\"}]},\"list\":[10,\"b\",[true]],\"Obj\":{\"k\":null}}"));
+    CHECK(prints_as(copy,"{\"skip\":{\"deep\":[1,2,{\"x\":\"]}\\\"\"}]},\"list\":[10,\"b\",[true]],\"Obj\":{\"k\":null}}"));
+    cJSON_Delete(copy);
+    cJSON_AddItemToObject(json,"added",cJSON_CreateNumber(1));
+    cJSON_DeleteItemFromObject(json,"skip");
+    CHECK(prints_as(json,"{\"list\":[10,\"b\",[true]],\"Obj\":{\"k\":null},\"added\":1}"));
+    cJSON_Delete(json);
+
+    json=cJSON_ParseLazy(broken,sizeof(broken)-1);	//ƥ, չʱ
+    CHECK(json && cJSON_GetArraySize(json)==3);
+    item=cJSON_GetArrayItem(json,1);
+    CHECK(item && cJSON_GetObjectItem(item,"a")==0 && cJSON_Expand(item)==0 && cJSON_GetErrorPtr()==broken+8);
+    CHECK(cJSON_PrintUnformatted(json)==0);
+    cJSON_Delete(json);
+    CHECK(cJSON_ParseLazy("[1,{]",5)==0 && cJSON_ParseLazy("[\"abc]",6)==0);
+
+    cJSON_InitContext(&ctx);		//ûзʵڵ
+    ctx.malloc_fn=counting_malloc,ctx.free_fn=counting_free;
+    json=cJSON_ParseLazyCtx(&ctx,text,sizeof(text)-1,0);
+    CHECK(cJSON_GetObjectItem(json,"list")!=0);
+    blocks=live_blocks;
+    cJSON_DeleteCtx(&ctx,json);
+    json=cJSON_ParseCtx(&ctx,text,0);
+    CHECK(blocks<live_blocks);
+    cJSON_DeleteCtx(&ctx,json);
+    CHECK(live_blocks==0);
+
+    cJSON_InitContext(&ctx);
+    arena=cJSON_ArenaCreate(0);		//arenaʱͨĽ
+    ctx.arena=arena;
+    json=cJSON_ParseLazyCtx(&ctx,text,sizeof(text)-1,0);
+    CHECK(json && (json->type&cJSON_IsArena) && cJSON_Expand(json)==1 && cJSON_GetArraySize(json)==3);
+    cJSON_ArenaDelete(arena);
+}
+
+/* user-023: פ. ͬļһ, ͷʱͷż */
+static void test_intern(void)
+{
+    cJSON_Context ctx;
+    cJSON *json,*a,*b,*obj,*copy;
+    const char *name;
+
+    cJSON_InitContext(&ctx);
+    ctx.keys=cJSON_KeyTableCreate(0);
+    CHECK(ctx.keys!=0);
+    json=cJSON_ParseCtx(&ctx,"[{\"id\":1,\"name\":\"a\"},{\"id\":2,\"name\":\"b\"},{\"na\\u006de\":\"c\"}]",0);
+    a=cJSON_GetArrayItem(json,0),b=cJSON_GetArrayItem(json,1);
+    CHECK(a && b && a->child->string==b->child->string && a->child->next->string==b->child->next->string);
+    CHECK((a->child->type&(cJSON_StringIsConst|cJSON_StringIsInterned))==(cJSON_StringIsConst|cJSON_StringIsInterned));
+    name=cJSON_InternKey(ctx.keys,"name");
+    CHECK(name==a->child->next->string && cJSON_GetArrayItem(json,2)->child->string==name);	//תפ
+    CHECK(cJSON_InternKey(ctx.keys,"Name")!=name && cJSON_GetObjectItem(b,name)->valuestring[0]=='b');
+    CHECK(cJSON_GetObjectItem(b,"NAME")==b->child->next);
+
+    obj=cJSON_CreateObject();
+    cJSON_AddItemToObjectInterned(obj,ctx.keys,"id",cJSON_CreateNumber(3));
+    CHECK(obj->child->string==a->child->string && prints_as(obj,"{\"id\":3}"));
+    copy=cJSON_Duplicate(json,1);		//ӵԼļ, Աȼó
+    cJSON_DeleteCtx(&ctx,json);
+    cJSON_Delete(obj);
+    cJSON_KeyTableDelete(ctx.keys);
+    CHECK(prints_as(copy,"[{\"id\":1,\"name\":\"a\"},{\"id\":2,\"name\":\"b\"},{\"name\":\"c\"}]"));
+    cJSON_Delete(copy);
+}
+
+/* depthǶ׵([[...[1]...]])({"a":{"a":...1}}) */
+static char *nested(int depth,int objects)
+{
+    char *text=(char*)malloc((size_t)depth*6+2),*p=text;
+    int i;
+    for (i=0; i<depth; i++) p+=sprintf(p,objects?"{\"a\":":"[");
+    *p++='1';
+    for (i=0; i<depth; i++) *p++=objects?'}':']';
+    *p=0;
+    return text;
+}
+
+/* user-024: ݹı. Ƕ׿Խƺɾ, ĬϵĲȻЧ */
+static void test_deep(void)
+{
+    cJSON_Context ctx;
+    cJSON *json,*copy;
+    char *text,*out;
+    int objects,ok;
+
+    cJSON_InitContext(&ctx);
+    ctx.max_depth=0;
+    for (objects=0; objects<2; objects++) {
+        text=nested(100000,objects);
+        json=cJSON_ParseCtx(&ctx,text,0);
+        CHECK(json!=0);
+        out=cJSON_PrintUnformatted(json);
+        CHECK(out && !strcmp(out,text));
+        free(out);
+        if (!objects) {		//ʽĶÿһ, 10ҪGB
+            out=cJSON_Print(json);
+            CHECK(out && !strcmp(out,text));	//ֻһԪصûҪʽķָ
+            free(out);
+        }
+        copy=cJSON_Duplicate(json,1);
+        cJSON_DeleteCtx(&ctx,json);
+        out=cJSON_PrintUnformatted(copy);
+        CHECK(out && !strcmp(out,text));
+        free(out);
+        cJSON_Delete(copy);
+        free(text);
+    }
+    text=nested(1000,1);		//Ĭ1000
+    json=cJSON_Parse(text);
+    out=cJSON_Print(json);
+    CHECK(out && strlen(out)>1000*1000/2);
+    free(out);
+    cJSON_Delete(json);
+    free(text);
+    text=nested(1000,0);
+    json=cJSON_Parse(text);
+    CHECK(json!=0);
+    cJSON_Delete(json);
+    free(text);
+    text=nested(1001,0);
+    json=cJSON_Parse(text);
+    ok=json==0 && cJSON_GetErrorPtr()==text+1000;
+    CHECK(ok);
+    cJSON_Delete(json);
+    free(text);
+}
+
+/* user-030: ֡ͺϲͬݹ. 10ǶĬϵջҲþջ,  */
+static void test_deep_diff(void)
+{
+    cJSON_Context ctx;
+    cJSON *a,*b,*p,*op;
+    char *text,*out,*want;
+    int objects;
+
+    cJSON_InitContext(&ctx);
+    ctx.max_depth=0;
+    for (objects=0; objects<2; objects++) {
+        text=nested(100000,objects);
+        a=cJSON_ParseCtx(&ctx,text,0);
+        text[objects?500000:100000]='2';		//12
+        b=cJSON_ParseCtx(&ctx,text,0);
+        want=text;
+
+        p=cJSON_Diff(a,a);				//ȵ: ϣͱȽ϶ߵײ
+        CHECK(p && cJSON_GetArraySize(p)==0);
+        cJSON_Delete(p);
+        p=cJSON_Diff(a,b);
+        CHECK(p && cJSON_GetArraySize(p)==1 && strlen(cJSON_GetObjectItem(cJSON_GetArrayItem(p,0),"path")->valuestring)==200000);	//"/0""/a"ظ10
+        CHECK(cJSON_ApplyPatch(a,p));
+        out=cJSON_PrintUnformatted(a);
+        CHECK(out && !strcmp(out,want));
+        free(out);
+        cJSON_Delete(p);
+
+        p=cJSON_CreateArray();			//"test"Ƚ
+        cJSON_AddItemToArray(p,op=cJSON_CreateObject());
+        cJSON_AddStringToObject(op,"op","test");
+        cJSON_AddStringToObject(op,"path","");
+        cJSON_AddItemToObject(op,"value",cJSON_Duplicate(b,1));
+        CHECK(cJSON_ApplyPatch(a,p));
+        cJSON_Delete(cJSON_DetachItemFromObject(op,"value"));
+        cJSON_AddItemToObject(op,"value",cJSON_CreateNumber(1));
+        CHECK(!cJSON_ApplyPatch(a,p));
+        cJSON_Delete(p);
+
+        if (objects) {
+            text[500000]='3';
+            cJSON_Delete(b);
+            b=cJSON_ParseCtx(&ctx,text,0);
+            p=cJSON_MergeDiff(a,b);		//{"a":{"a":...3}}
+            CHECK(p && cJSON_ApplyMergePatch(a,p));
+            out=cJSON_PrintUnformatted(a);
+            CHECK(out && !strcmp(out,text));
+            free(out);
+            cJSON_Delete(p);
+        }
+        cJSON_Delete(a);
+        cJSON_Delete(b);
+        free(text);
+    }
+}
+
+/* user-025: ڵ. ͷŵĽڵͶַһη, cJSON_PoolFlushǻ亯 */
+static void test_pool(void)
+{
+    cJSON_Hooks hooks={counting_malloc,counting_free};
+    cJSON *a,*b,*obj;
+    char *s;
+    int i,k,ok;
+
+    a=cJSON_CreateString("short");
+    cJSON_Delete(a);
+    b=cJSON_CreateString("other");		//ͬһ̵߳һηȡظͷŵĿ
+#ifndef CJSON_NO_POOL
+    CHECK(b==a);
+#endif
+#if defined(CJSON_POOL_STRINGS) && !defined(CJSON_NO_POOL)
+    CHECK(b->type&cJSON_ValueIsPooled);
+#else
+    CHECK(!(b->type&cJSON_ValueIsPooled));
+#endif
+    s=b->valuestring;			//Լ滻valuestringʱ־
+    b->valuestring=(char*)malloc(100);
+    strcpy(b->valuestring,"a replacement longer than any pooled size class .............................");
+    b->type&=~cJSON_ValueIsPooled;
+    free(s);
+    CHECK(prints_as(b,"\"a replacement longer than any pooled size class .............................\""));
+    cJSON_Delete(b);
+
+    for (ok=1,i=0; ok && i<100; i++) {	//ͷ, ݲõӰ
+        obj=cJSON_CreateObject();
+        for (k=0; k<50; k++) cJSON_AddItemToObject(obj,k%2?"odd":"even",cJSON_CreateString(k%3?"x":"a 40 byte string to use the 64 class.."));
+        a=cJSON_Duplicate(obj,1);
+        cJSON_Delete(obj);
+        ok=cJSON_GetArraySize(a)==50 && !strcmp(cJSON_GetArrayItem(a,49)->string,"odd")
+           && !strcmp(cJSON_GetArrayItem(a,48)->valuestring,"a 40 byte string to use the 64 class..");
+        cJSON_Delete(a);
+    }
+    CHECK(ok);
+    cJSON_PoolFlush();
+
+    cJSON_InitHooks(&hooks);		//еĿcJSON_InitHooksõķ亯
+    a=cJSON_Parse("{\"k\":[\"v\",1]}");
+    CHECK(a && live_blocks>0);
+    cJSON_Delete(a);
+#ifndef CJSON_NO_POOL
+    CHECK(live_blocks>0);		//ڳ
+#endif
+    cJSON_PoolFlush();
+    CHECK(live_blocks==0);
+    cJSON_InitHooks(0);
+}
+
+/* ɴԼ滻valuestringͼ(cJSON_ValueIsPooled/cJSON_StringIsPooled), ĬϵĹвƻ */
+static void test_pool_hand_strings(void)
+{
+    static const char long_text[]="a 59 character string that reuses whatever block is freed..";
+    cJSON *a,*obj;
+    char *out;
+    int i;
+
+    for (i=0; i<2; i++) {
+        a=cJSON_CreateString("ab");
+        obj=cJSON_CreateObject();
+        cJSON_AddNumberToObject(obj,"k",1);
+        free(a->valuestring);
+        a->valuestring=(char*)malloc(41);
+        strcpy(a->valuestring,"forty bytes of text, then the nul.......");
+        free(obj->child->string);
+        obj->child->string=(char*)malloc(41);
+        strcpy(obj->child->string,"a forty byte key, then the nul..........");
+#ifdef CJSON_POOL_STRINGS
+        a->type&=~cJSON_ValueIsPooled;	//ַصĹ־
+        obj->child->type&=~cJSON_StringIsPooled;
+#endif
+        CHECK(prints_as(a,"\"forty bytes of text, then the nul.......\""));
+        cJSON_Delete(a);
+        cJSON_Delete(obj);
+        a=cJSON_CreateString(long_text);	//ȡͷŵĿʱԽ
+        obj=cJSON_CreateObject();
+        cJSON_AddItemToObject(obj,long_text,cJSON_CreateNull());
+        out=cJSON_PrintUnformatted(obj);
+        CHECK(prints_as(a,"\"a 59 character string that reuses whatever block is freed..\"") && out && !strncmp(out+2,long_text,strlen(long_text)));
+        free(out);
+        cJSON_Delete(a);
+        cJSON_Delete(obj);
+    }
+}
+
+/* user-026: ȺԤĻ. cJSON_PrintĽȫһ, 岻ʱʧҲԽ */
+static void test_printed_length(void)
+{
+    static const char *docs[]={"{\"name\":\"Jack (\\\"Bee\\\") Nimble\",\"format\":{\"w\":1920,\"r\":23.976,\"i\":false}}",
+        "[1,-2.5e-300,\"\\u0001\xe4\xbd\xa0\",[],{},[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[1]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]",
+        "\"just a string\"","null"};
+    static const double dbls[]={0.5,1e21,-3};
+    cJSON *json;
+    char *out,buf[512];
+    size_t len;
+    int i,fmt,ok=1;
+
+    for (i=0; i<(int)(sizeof(docs)/sizeof(*docs))+1; i++) for (fmt=0; fmt<2; fmt++) {
+        json=i<(int)(sizeof(docs)/sizeof(*docs))?cJSON_Parse(docs[i]):cJSON_CreatePackedDoubleArray(dbls,3);
+        out=fmt?cJSON_Print(json):cJSON_PrintUnformatted(json);
+        len=cJSON_PrintedLength(json,fmt);
+        if (!out || len!=strlen(out)) ok=0,printf("  doc %d fmt %d: length %d\n",i,fmt,(int)len);
+        memset(buf,'#',sizeof(buf));
+        if (!cJSON_PrintPreallocated(json,buf,(int)len+1,fmt) || strcmp(buf,out) || buf[len+1]!='#') ok=0;
+        memset(buf,'#',sizeof(buf));
+        if (cJSON_PrintPreallocated(json,buf,(int)len,fmt) || buf[len]!='#') ok=0;	//һֽ: ʧ, дlen
+        free(out);
+        cJSON_Delete(json);
+    }
+    CHECK(ok);
+    json=cJSON_CreateNumber(1);
+    json->type=99;			//Ϸ
+    CHECK(cJSON_PrintedLength(json,0)==0 && cJSON_PrintPreallocated(json,buf,sizeof(buf),0)==0);
+    json->type=cJSON_Number;
+    cJSON_Delete(json);
+}
+
+/* ÿƥ䲻ʽ׷ӵuser(һchar[512]), ÿոָ */
+static int collect_match(void *user,cJSON *match)
+{
+    char *out=cJSON_PrintUnformatted(match);
+    strcat(strcat((char*)user,out),(const char*)" ");
+    free(out);
+    return 1;
+}
+static int first_two(void *user,cJSON *match)
+{
+    collect_match(user,match);
+    return strchr((char*)user,' ')==strrchr((char*)user,' ');	//ռԺֹͣ
+}
+
+/* pathƥ */
+static int query_gives(const char *path,cJSON *root,const char *expect)
+{
+    char got[512]="";
+    cJSON_Query *q=path[0]=='$'?cJSON_QueryCompile(path):cJSON_QueryPointer(path);
+    int ok=q && cJSON_QueryEach(q,root,collect_match,got)>=0 && !strcmp(got,expect);
+    if (!ok) printf("  %s: got \"%s\"\n",path,got);
+    cJSON_QueryDelete(q);
+    return ok;
+}
+
+/* user-027: JSON Pointer(RFC 69015ڵ)JSONPathѯ */
+static void test_query(void)
+{
+    static const char rfc[]="{\"foo\":[\"bar\",\"baz\"],\"\":0,\"a/b\":1,\"c%d\":2,\"e^f\":3,\"g|h\":4,\"i\\\\j\":5,\"k\\\"l\":6,\" \":7,\"m~n\":8}";
+    static const char store[]="{\"users\":[{\"name\":\"ann\",\"tags\":[\"x\"]},{\"name\":\"bob\",\"Name\":\"B\"},{\"id\":3}],"
+                              "\"meta\":{\"name\":\"list\",\"count\":3}}";
+    cJSON *doc=cJSON_Parse(rfc),*root=cJSON_Parse(store),*m;
+    cJSON_Query *q;
+    char got[512]="";
+
+    CHECK(query_gives("",doc,"{\"foo\":[\"bar\",\"baz\"],\"\":0,\"a/b\":1,\"c%d\":2,\"e^f\":3,\"g|h\":4,\"i\\\\j\":5,\"k\\\"l\":6,\" \":7,\"m~n\":8} "));
+    CHECK(query_gives("/foo",doc,"[\"bar\",\"baz\"] ") && query_gives("/foo/0",doc,"\"bar\" ") && query_gives("/",doc,"0 "));
+    CHECK(query_gives("/a~1b",doc,"1 ") && query_gives("/c%d",doc,"2 ") && query_gives("/e^f",doc,"3 ") && query_gives("/g|h",doc,"4 "));
+    CHECK(query_gives("/i\\j",doc,"5 ") && query_gives("/k\"l",doc,"6 ") && query_gives("/ ",doc,"7 ") && query_gives("/m~0n",doc,"8 "));
+    CHECK(query_gives("/foo/2",doc,"") && query_gives("/foo/-",doc,"") && query_gives("/FOO",doc,""));
+    CHECK(cJSON_QueryPointer("foo")==0 && cJSON_QueryPointer("/~2")==0 && cJSON_QueryPointer("/a~")==0);
+    CHECK(cJSON_GetPointer(doc,"/foo/1") && !strcmp(cJSON_GetPointer(doc,"/foo/1")->valuestring,"baz"));
+
+    CHECK(query_gives("$.users[*].name",root,"\"ann\" \"bob\" "));
+    CHECK(query_gives("$['users'][-1][\"id\"]",root,"3 ") && query_gives("$.users[5]",root,""));
+    CHECK(query_gives("$..name",root,"\"ann\" \"bob\" \"list\" "));
+    CHECK(query_gives("$.meta.*",root,"\"list\" 3 ") && query_gives("$.users[0]..*",root,"\"ann\" [\"x\"] \"x\" "));
+    CHECK(query_gives("$",root,"{\"users\":[{\"name\":\"ann\",\"tags\":[\"x\"]},{\"name\":\"bob\",\"Name\":\"B\"},{\"id\":3}],\"meta\":{\"name\":\"list\",\"count\":3}} "));
+    CHECK(cJSON_QueryCompile("users")==0 && cJSON_QueryCompile("$[") ==0 && cJSON_QueryCompile("$.a[x]")==0);
+
+    q=cJSON_QueryCompile("$..name");
+    CHECK(cJSON_QueryEach(q,root,first_two,got)==2 && !strcmp(got,"\"ann\" \"bob\" "));
+    m=cJSON_QueryFirst(q,root);
+    CHECK(m && !strcmp(m->valuestring,"ann"));
+    m=cJSON_QueryText(q,store,sizeof(store)-1);	//ӳٽı, ضĸ
+    CHECK(prints_as(m,"\"ann\""));
+    cJSON_Delete(m);
+    CHECK(cJSON_QueryText(q,"{\"a\":[1,}",9)==0 && cJSON_QueryFirst(q,doc)==0);
+    cJSON_QueryDelete(q);
+    cJSON_Delete(doc);
+    cJSON_Delete(root);
+}
+
+struct bind_point { int x; double w; };
+struct bind_rec {
+    int i; long long big; double d; int flag; char *name; char code[4];
+    struct bind_point at;
+    struct bind_point pts[3]; int npts;
+    int nums[2]; int nnums;
+};
+static const cJSON_Binding bind_point_fields[]={
+    {"x",cJSON_BindInt,offsetof(struct bind_point,x)},
+    {"w",cJSON_BindDouble,offsetof(struct bind_point,w)},
+    {0}
+};
+static const cJSON_Binding bind_pt_elem[]={{"pt",cJSON_BindObject,0,sizeof(struct bind_point),bind_point_fields}};
+static const cJSON_Binding bind_int_elem[]={{"n",cJSON_BindInt,0}};
+static const cJSON_Binding bind_rec_fields[]={
+    {"i",cJSON_BindInt,offsetof(struct bind_rec,i)},
+    {"big",cJSON_BindInt64,offsetof(struct bind_rec,big)},
+    {"d",cJSON_BindDouble,offsetof(struct bind_rec,d)},
+    {"flag",cJSON_BindBool,offsetof(struct bind_rec,flag)},
+    {"name",cJSON_BindString,offsetof(struct bind_rec,name)},
+    {"code",cJSON_BindChars,offsetof(struct bind_rec,code),4},
+    {"at",cJSON_BindObject,offsetof(struct bind_rec,at),0,bind_point_fields},
+    {"pts",cJSON_BindArray,offsetof(struct bind_rec,pts),3,bind_pt_elem,offsetof(struct bind_rec,npts)},
+    {"nums",cJSON_BindArray,offsetof(struct bind_rec,nums),2,bind_int_elem,offsetof(struct bind_rec,nnums)},
+    {0}
+};
+
+/* integerص: long longΧڵı, ֽnumber */
+static char sax_numbers[256];
+static int sax_int_event(void *user,long long value)
+{
+    sprintf(sax_numbers+strlen(sax_numbers),"i%lld ",value);
+    return 1;
+}
+static int sax_num_event(void *user,double value,long long value64)
+{
+    sprintf(sax_numbers+strlen(sax_numbers),"n%.17g/%lld ",value,value64);
+    return 1;
+}
+
+static int bind_text(const char *text,struct bind_rec *r)
+{
+    return cJSON_BindParse(0,text,strlen(text),bind_rec_fields,r);
+}
+
+/* user-028: JSONֱӽṹ/ӽṹӡ */
+static void test_bind(void)
+{
+    static const char text[]="{\"i\":-7,\"big\":9007199254740993,\"d\":0.25,\"flag\":true,\"name\":\"a\\nb\",\"code\":\"xyz\","
+                             "\"skip\":{\"i\":[1,{\"i\":2}]},\"at\":{\"x\":3,\"w\":1.5,\"z\":0},\"pts\":[{\"x\":1},{\"w\":2}],\"nums\":[5,6]}";
+    struct bind_rec r,s;
+    char *out,*expect;
+    cJSON *tree;
+    cJSON_SaxHandler h;
+
+    memset(&h,0,sizeof(h));
+    h.number=sax_num_event;
+    CHECK(cJSON_ParseSax(0,"[1,-9223372036854775808,9223372036854775808,1e2,100000000000000000000]",&h,0,0));
+    CHECK(!strcmp(sax_numbers,"n1/1 n-9.2233720368547758e+18/-9223372036854775808 n9.2233720368547758e+18/9223372036854775807 n100/100 n1e+20/9223372036854775807 "));
+    sax_numbers[0]=0;
+    h.integer=sax_int_event;
+    CHECK(cJSON_ParseSax(0,"[1,-9223372036854775808,9223372036854775808,1e2,100000000000000000000]",&h,0,0));
+    CHECK(!strcmp(sax_numbers,"i1 i-9223372036854775808 n9.2233720368547758e+18/9223372036854775807 n100/100 n1e+20/9223372036854775807 "));
+
+    memset(&r,0,sizeof(r));
+    CHECK(bind_text(text,&r));
+    CHECK(r.i==-7 && r.big==9007199254740993LL && r.d==0.25 && r.flag==1 && !strcmp(r.name,"a\nb") && !strcmp(r.code,"xyz"));
+    CHECK(r.at.x==3 && r.at.w==1.5 && r.npts==2 && r.pts[0].x==1 && r.pts[1].w==2 && r.nnums==2 && r.nums[1]==6);
+
+    out=cJSON_BindPrint(bind_rec_fields,&r,1);		//͵ȼ۵ӡһ
+    tree=cJSON_Parse("{\"i\":-7,\"big\":9007199254740993,\"d\":0.25,\"flag\":true,\"name\":\"a\\nb\",\"code\":\"xyz\","
+                     "\"at\":{\"x\":3,\"w\":1.5},\"pts\":[{\"x\":1,\"w\":0},{\"x\":0,\"w\":2}],\"nums\":[5,6]}");
+    cJSON_ReplaceItemInObject(tree,"big",cJSON_CreateInt64(9007199254740993LL));
+    expect=cJSON_Print(tree);
+    CHECK(out && !strcmp(out,expect));
+    free(out); free(expect);
+    out=cJSON_BindPrint(bind_rec_fields,&r,0);
+    expect=cJSON_PrintUnformatted(tree);
+    CHECK(out && !strcmp(out,expect));
+    free(out); free(expect);
+    cJSON_Delete(tree);
+
+    s=r;					//ȱٵļԭֵ, null
+    CHECK(bind_text("{\"name\":\"c\",\"code\":null,\"at\":null,\"pts\":null,\"d\":null}",&r));
+    CHECK(r.i==-7 && !strcmp(r.name,"c") && r.code[0]==0 && r.at.x==0 && r.at.w==0 && r.npts==0 && r.d==0 && r.nnums==2);
+    CHECK(bind_text("{\"name\":null}",&r) && r.name==0);
+
+    memset(&s,0,sizeof(s));			//ͺԽֵ
+    CHECK(!bind_text("{\"i\":\"1\"}",&s) && !bind_text("{\"i\":1.5}",&s) && !bind_text("{\"i\":3000000000}",&s));
+    CHECK(!bind_text("{\"flag\":1}",&s) && !bind_text("{\"code\":\"abcd\"}",&s) && !bind_text("{\"nums\":[1,2,3]}",&s));
+    CHECK(!bind_text("{\"at\":[]}",&s) && !bind_text("{\"d\":\"x\"}",&s) && !bind_text("[]",&s) && !bind_text("{\"i\":1",&s));
+    CHECK(bind_text("{\"code\":\"abc\",\"big\":-9223372036854775807}",&s) && s.big==-9223372036854775807LL);
+    CHECK(!bind_text("{\"big\":9223372036854775808}",&s) && !bind_text("{\"big\":-9223372036854775809}",&s));	//͵ֵ
+    CHECK(!bind_text("{\"big\":10000000000000000000}",&s) && !bind_text("{\"big\":1e19}",&s) && !bind_text("{\"i\":2147483648}",&s));
+    CHECK(bind_text("{\"big\":9223372036854775807}",&s) && s.big==9223372036854775807LL);
+    CHECK(bind_text("{\"big\":-9223372036854775808}",&s) && s.big==-9223372036854775807LL-1);
+    CHECK(bind_text("{\"big\":1e3,\"d\":9007199254740993}",&s) && s.big==1000 && s.d==9007199254740992.0);
+    cJSON_BindFree(0,bind_rec_fields,&s);
+    cJSON_BindFree(0,bind_rec_fields,&r);
+    CHECK(r.name==0 && s.name==0);
+}
+
+/* user-029: ȵ. ĬϵĹȫΪ0; -DCJSON_ENABLE_COUNTERSʱ */
+static void test_counters(void)
+{
+    cJSON_Counters c;
+    cJSON *root;
+    char *out;
+
+    cJSON_ResetCounters();
+    root=cJSON_Parse("{\"a\":\"text\",\"b\":[1,2,3],\"c\":{\"d\":null}}");
+    CHECK(cJSON_GetObjectItem(root,"c") && cJSON_GetArrayItem(cJSON_GetObjectItem(root,"b"),2));
+    out=cJSON_Print(root);
+    cJSON_GetCounters(&c);
+#ifdef CJSON_ENABLE_COUNTERS
+    CHECK(c.nodes==8 && c.bytes_copied>=strlen("abtextcd") && c.lookups==3 && c.lookup_steps>0);
+#else
+    CHECK(!c.nodes && !c.bytes_copied && !c.ensure_grows && !c.lookups && !c.lookup_steps);
+#endif
+    free(out);
+    cJSON_Delete(root);
+    cJSON_ResetCounters();
+    cJSON_GetCounters(&c);
+    CHECK(!c.nodes && !c.bytes_copied && !c.ensure_grows && !c.lookups && !c.lookup_steps);
+}
+
+/* patchӦõtext: ֵӦΪok, ֮ӡΪexpect */
+static int patch_gives(const char *text,const char *patch,int ok,const char *expect)
+{
+    cJSON *doc=cJSON_Parse(text),*p=cJSON_Parse(patch);
+    int r=cJSON_ApplyPatch(doc,p)==ok && prints_as(doc,expect);
+    cJSON_Delete(doc);
+    cJSON_Delete(p);
+    return r;
+}
+
+/* cJSON_Diff(from,to)Ӧõfromϵóto; ͬmerge patch */
+static int diff_roundtrip(const char *from,const char *to,int max_ops)
+{
+    cJSON *a=cJSON_Parse(from),*b=cJSON_Parse(to),*p=cJSON_Diff(a,b),*m=cJSON_MergeDiff(a,b),*c=cJSON_Duplicate(a,1);
+    char *want=cJSON_PrintUnformatted(b);
+    int ok=p && cJSON_GetArraySize(p)<=max_ops && cJSON_ApplyPatch(a,p) && prints_as(a,want);
+    if (m && !strstr(to,"null") && !strchr(from,'[')) ok=ok && cJSON_ApplyMergePatch(c,m) && prints_as(c,want);
+    free(want);
+    cJSON_Delete(a); cJSON_Delete(b); cJSON_Delete(p); cJSON_Delete(m); cJSON_Delete(c);
+    return ok;
+}
+
+/* user-030: JSON Patch(RFC 6902)Merge Patch(RFC 7386) */
+static void test_patch(void)
+{
+    char big[4096],*k;
+    int i;
+    cJSON *doc,*p;
+
+    CHECK(diff_roundtrip("{\"a\":1,\"b\":{\"c\":[1,2]},\"d\":\"x\"}","{\"a\":1,\"b\":{\"c\":[1,2],\"e\":true},\"f\":0}",3));
+    CHECK(diff_roundtrip("[1,2,3,4,5,6,7,8]","[1,2,3,9,4,5,6,7,8]",1) && diff_roundtrip("[1,2,3,4,5,6,7,8]","[1,2,3,5,6,7,8]",1));
+    CHECK(diff_roundtrip("{\"a\":[{\"x\":1},{\"y\":2}]}","{\"a\":[{\"x\":1},{\"y\":3}]}",1));
+    CHECK(diff_roundtrip("{\"a\":1}","[true]",1) && diff_roundtrip("3","\"s\"",1) && diff_roundtrip("{\"a\":{\"b\":1}}","{\"a\":{\"b\":1}}",0));
+    CHECK(diff_roundtrip("{\"a\":{\"b\":1,\"c\":2}}","{\"a\":{\"c\":3},\"d\":{\"e\":\"f\"}}",3));
+
+    doc=cJSON_Parse("{\"a\":\"b\",\"c\":{\"d\":\"e\",\"f\":\"g\"}}");	//RFC 7386¼Aһ
+    p=cJSON_Parse("{\"a\":\"z\",\"c\":{\"f\":null}}");
+    CHECK(cJSON_ApplyMergePatch(doc,p) && prints_as(doc,"{\"a\":\"z\",\"c\":{\"d\":\"e\"}}"));
+    cJSON_Delete(p);
+    p=cJSON_Parse("[1]");
+    CHECK(cJSON_ApplyMergePatch(doc,p) && prints_as(doc,"[1]"));
+    cJSON_Delete(p);
+    cJSON_Delete(doc);
+
+    CHECK(patch_gives("{\"a\":[1,2]}","[{\"op\":\"add\",\"path\":\"/a/-\",\"value\":3},{\"op\":\"add\",\"path\":\"/a/0\",\"value\":0}]",1,"{\"a\":[0,1,2,3]}"));
+    CHECK(patch_gives("{\"a\":1,\"b\":2}","[{\"op\":\"remove\",\"path\":\"/a\"},{\"op\":\"replace\",\"path\":\"/b\",\"value\":[]}]",1,"{\"b\":[]}"));
+    CHECK(patch_gives("{\"a\":{\"b\":1}}","[{\"op\":\"copy\",\"from\":\"/a\",\"path\":\"/c\"},{\"op\":\"test\",\"path\":\"/c/b\",\"value\":1}]",1,"{\"a\":{\"b\":1},\"c\":{\"b\":1}}"));
+    CHECK(patch_gives("[1,2,3]","[{\"op\":\"move\",\"from\":\"/0\",\"path\":\"/-\"}]",1,"[2,3,1]"));
+    CHECK(patch_gives("{\"a\":{\"b\":1}}","[{\"op\":\"move\",\"from\":\"/a/b\",\"path\":\"/c\"}]",1,"{\"a\":{},\"c\":1}"));
+    CHECK(patch_gives("{\"a\":1}","[{\"op\":\"replace\",\"path\":\"\",\"value\":{\"r\":0}}]",1,"{\"r\":0}"));
+    CHECK(patch_gives("{\"a\":1}","[{\"op\":\"test\",\"path\":\"/a\",\"value\":2}]",0,"{\"a\":1}"));
+
+    /* ʧܵĲκθĶ, ֮ǰĲ */
+    CHECK(patch_gives("{\"a\":1,\"b\":2}","[{\"op\":\"move\",\"from\":\"/a\",\"path\":\"/x/y\"}]",0,"{\"a\":1,\"b\":2}"));
+    CHECK(patch_gives("{\"a\":1,\"b\":2}","[{\"op\":\"move\",\"from\":\"/b\",\"path\":\"/a/0\"}]",0,"{\"a\":1,\"b\":2}"));
+    CHECK(patch_gives("[1,2,3]","[{\"op\":\"move\",\"from\":\"/1\",\"path\":\"/7\"}]",0,"[1,2,3]"));
+    CHECK(patch_gives("{\"a\":{\"b\":1}}","[{\"op\":\"move\",\"from\":\"/a\",\"path\":\"/a/b/c\"}]",0,"{\"a\":{\"b\":1}}"));
+    CHECK(patch_gives("{\"a\":1}","[{\"op\":\"add\",\"path\":\"/b\",\"value\":2},{\"op\":\"remove\",\"path\":\"/z\"}]",0,"{\"a\":1,\"b\":2}"));
+
+    k=big;					//֮µĶ, Żغܰҵ
+    k+=sprintf(k,"{");
+    for (i=0; i<64; i++) k+=sprintf(k,"%s\"k%d\":%d",i?",":"",i,i);
+    sprintf(k,"}");
+    doc=cJSON_Parse(big);
+    CHECK(cJSON_GetObjectItem(doc,"k63")!=0);
+    p=cJSON_Parse("[{\"op\":\"move\",\"from\":\"/k10\",\"path\":\"/k1/x\"}]");
+    CHECK(!cJSON_ApplyPatch(doc,p) && cJSON_GetObjectItem(doc,"k10") && cJSON_GetObjectItem(doc,"k10")->valueint==10);
+    CHECK(cJSON_GetArrayItem(doc,10)==cJSON_GetObjectItem(doc,"k10") && cJSON_GetArraySize(doc)==64);
+    cJSON_Delete(p);
+    p=cJSON_Parse("[{\"op\":\"move\",\"from\":\"/k63\",\"path\":\"/k1/x\"}]");
+    CHECK(!cJSON_ApplyPatch(doc,p) && cJSON_GetArrayItem(doc,63)==cJSON_GetObjectItem(doc,"k63"));
+    cJSON_Delete(p);
+    cJSON_Delete(doc);
+
+    /* Ϸpatch */
+    CHECK(patch_gives("{}","{\"op\":\"add\"}",0,"{}") && patch_gives("{}","[{\"path\":\"/a\",\"value\":1}]",0,"{}"));
+    CHECK(patch_gives("{}","[{\"op\":\"add\",\"path\":\"/a\"}]",0,"{}") && patch_gives("{}","[{\"op\":\"jump\",\"path\":\"/a\"}]",0,"{}"));
+    CHECK(patch_gives("{}","[{\"op\":\"move\",\"path\":\"/a\"}]",0,"{}") && patch_gives("{}","[{\"op\":\"add\",\"path\":\"a\",\"value\":1}]",0,"{}"));
+    CHECK(patch_gives("{\"a\":1}","[{\"op\":\"remove\",\"path\":\"/~2\"}]",0,"{\"a\":1}") && patch_gives("{}","[{\"op\":\"remove\",\"path\":\"\"}]",0,"{}"));
+}
+
 int main (int argc, const char * argv[])
 {
     /* a bunch of json: */
@@ -161,5 +1902,40 @@ int main (int argc, const char * argv[])
     /* Now some samplecode for building objects concisely: */
     create_objects();
 
-    return 0;
+    /* Checks of each feature: */
+    test_arena();
+    test_context();
+    test_key_index();
+    test_array_append();
+    test_array_index();
+    test_array_hand_edits();
+    test_number_parse();
+    test_number_print();
+    test_string_scan();
+    test_minify();
+    test_print_buffer();
+    test_print_writer();
+    test_push_parser();
+    test_sax();
+    test_insitu();
+    test_parse_length();
+    test_lines();
+    test_batch();
+    test_parallel();
+    test_compact();
+    test_packed();
+    test_cbor();
+    test_lazy();
+    test_intern();
+    test_deep();
+    test_deep_diff();
+    test_pool();
+    test_pool_hand_strings();
+    test_printed_length();
+    test_query();
+    test_bind();
+    test_counters();
+    test_patch();
+    printf("%d checks, %d failed\n",checks,failures);
+    return failures!=0;
 }